@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui network sql xmlpatterns
+QT       += core gui network xmlpatterns concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -18,6 +18,9 @@ VERSION_NAME = Griffin
 DEFINES += APP_VERSION=\\\"$$VERSION\\\"
 DEFINES += APP_VERSION_NAME=\\\"$$VERSION_NAME\\\"
 
+# Compress exported files and decompress imported workbooks with the zlib bundled with Qt (exported by QtCore on Windows).
+unix: LIBS += -lz
+
 RC_ICONS = ../Media/Icons/Tome.ico
 ICON = ../Media/Icons/Tome.icns
 
@@ -41,7 +44,17 @@ SOURCES += ../Source/Tome/main.cpp \
     ../Source/Tome/Features/Projects/Controller/projectserializer.cpp \
     ../Source/Tome/Features/Projects/Model/project.cpp \
     ../Source/Tome/Features/Records/Controller/recordsetserializer.cpp \
+    ../Source/Tome/Features/Records/Controller/jsonrecordsetserializer.cpp \
+    ../Source/Tome/Features/Records/Controller/xmlrecordsetserializer.cpp \
+    ../Source/Tome/IO/csvreader.cpp \
+    ../Source/Tome/IO/gzipdevice.cpp \
+    ../Source/Tome/IO/hashingdevice.cpp \
+    ../Source/Tome/IO/mappedfile.cpp \
+    ../Source/Tome/IO/xlsxreader.cpp \
     ../Source/Tome/IO/xmlreader.cpp \
+    ../Source/Tome/IO/xmlwriter.cpp \
+    ../Source/Tome/IO/zipentrydevice.cpp \
+    ../Source/Tome/Util/stringreplacer.cpp \
     ../Source/Tome/Features/Fields/View/fielddefinitionwindow.cpp \
     ../Source/Tome/Features/Fields/View/fielddefinitionswindow.cpp \
     ../Source/Tome/Features/Records/View/recordwindow.cpp \
@@ -58,7 +71,10 @@ SOURCES += ../Source/Tome/main.cpp \
     ../Source/Tome/Features/Fields/View/listitemwindow.cpp \
     ../Source/Tome/Features/Components/Controller/componentscontroller.cpp \
     ../Source/Tome/Core/controller.cpp \
+    ../Source/Tome/Features/Export/Controller/binaryrecordwriter.cpp \
+    ../Source/Tome/Features/Export/Controller/cppheaderwriter.cpp \
     ../Source/Tome/Features/Export/Controller/exportcontroller.cpp \
+    ../Source/Tome/Features/Export/Controller/exporttemplatecompiler.cpp \
     ../Source/Tome/Features/Records/Controller/recordscontroller.cpp \
     ../Source/Tome/Features/Fields/Controller/fielddefinitionscontroller.cpp \
     ../Source/Tome/Features/Types/Controller/typescontroller.cpp \
@@ -91,6 +107,7 @@ SOURCES += ../Source/Tome/main.cpp \
     ../Source/Tome/Features/Components/Controller/componentsetserializer.cpp \
     ../Source/Tome/Features/Types/Controller/customtypesetserializer.cpp \
     ../Source/Tome/Features/Export/Controller/exporttemplateserializer.cpp \
+    ../Source/Tome/Features/Export/Controller/recordexportcacheserializer.cpp \
     ../Source/Tome/Features/Search/Controller/findrecordcontroller.cpp \
     ../Source/Tome/Features/Search/View/findrecordwindow.cpp \
     ../Source/Tome/Features/Projects/View/projectoverviewwindow.cpp \
@@ -135,12 +152,14 @@ SOURCES += ../Source/Tome/main.cpp \
     ../Source/Tome/Features/Records/Controller/Commands/revertrecordcommand.cpp \
     ../Source/Tome/Features/Records/Controller/Commands/reparentrecordcommand.cpp \
     ../Source/Tome/Features/Records/Controller/Commands/removerecordcommand.cpp \
+    ../Source/Tome/Features/Records/Controller/Commands/importrecordscommand.cpp \
     ../Source/Tome/Features/Import/Controller/importcontroller.cpp \
     ../Source/Tome/Features/Import/Controller/recorddatasource.cpp \
     ../Source/Tome/Features/Import/Controller/csvrecorddatasource.cpp \
     ../Source/Tome/Features/Import/Controller/xlsxrecorddatasource.cpp \
     ../Source/Tome/Features/Import/Controller/googlesheetsrecorddatasource.cpp \
     ../Source/Tome/Features/Import/Controller/importtemplateserializer.cpp \
+    ../Source/Tome/Features/Import/Controller/recordimportfingerprintserializer.cpp \
     ../Source/Tome/Features/Facets/Controller/localizedstringfacet.cpp \
     ../Source/Tome/Features/Integrity/Controller/componenthasnofieldstask.cpp \
     ../Source/Tome/Features/Integrity/Controller/fieldisneverusedtask.cpp \
@@ -166,8 +185,18 @@ HEADERS  += ../Source/Tome/Core/mainwindow.h \
     ../Source/Tome/Features/Records/Model/record.h \
     ../Source/Tome/Features/Records/Model/recordset.h \
     ../Source/Tome/Features/Records/Controller/recordsetserializer.h \
+    ../Source/Tome/Features/Records/Controller/jsonrecordsetserializer.h \
+    ../Source/Tome/Features/Records/Controller/xmlrecordsetserializer.h \
+    ../Source/Tome/Features/Records/Model/recordsetformat.h \
     ../Source/Tome/Util/pathutils.h \
+    ../Source/Tome/IO/csvreader.h \
+    ../Source/Tome/IO/gzipdevice.h \
+    ../Source/Tome/IO/hashingdevice.h \
+    ../Source/Tome/IO/mappedfile.h \
+    ../Source/Tome/IO/xlsxreader.h \
     ../Source/Tome/IO/xmlreader.h \
+    ../Source/Tome/IO/xmlwriter.h \
+    ../Source/Tome/IO/zipentrydevice.h \
     ../Source/Tome/Features/Fields/View/fielddefinitionwindow.h \
     ../Source/Tome/Features/Fields/View/fielddefinitionswindow.h \
     ../Source/Tome/Features/Records/View/recordwindow.h \
@@ -187,7 +216,23 @@ HEADERS  += ../Source/Tome/Core/mainwindow.h \
     ../Source/Tome/Features/Components/Model/component.h \
     ../Source/Tome/Core/controller.h \
     ../Source/Tome/Features/Components/Model/componentlist.h \
+    ../Source/Tome/Features/Export/Controller/binaryrecordwriter.h \
+    ../Source/Tome/Features/Export/Controller/cppheaderwriter.h \
     ../Source/Tome/Features/Export/Controller/exportcontroller.h \
+    ../Source/Tome/Features/Export/Controller/exporttemplatecompiler.h \
+    ../Source/Tome/Features/Export/Model/binaryvaluetype.h \
+    ../Source/Tome/Features/Export/Model/compiledrecordexporttemplate.h \
+    ../Source/Tome/Features/Export/Model/exportfieldplan.h \
+    ../Source/Tome/Features/Export/Model/exporttemplateplaceholder.h \
+    ../Source/Tome/Features/Export/Model/exporttemplatetoken.h \
+    ../Source/Tome/Features/Export/Model/exporttemplatetokenlist.h \
+    ../Source/Tome/Features/Export/Model/recordexportcache.h \
+    ../Source/Tome/Features/Export/Model/recordexportcacheentry.h \
+    ../Source/Tome/Features/Export/Model/recordexportdata.h \
+    ../Source/Tome/Features/Export/Model/recordexportitem.h \
+    ../Source/Tome/Features/Export/Model/recordexportoptions.h \
+    ../Source/Tome/Features/Export/Model/recordexportcompression.h \
+    ../Source/Tome/Features/Export/Model/recordexportsplitmode.h \
     ../Source/Tome/Features/Records/Controller/recordscontroller.h \
     ../Source/Tome/Features/Records/Model/recordlist.h \
     ../Source/Tome/Features/Records/Model/recordsetlist.h \
@@ -200,6 +245,7 @@ HEADERS  += ../Source/Tome/Core/mainwindow.h \
     ../Source/Tome/Util/listutils.h \
     ../Source/Tome/Features/Export/Model/recordexporttemplatemap.h \
     ../Source/Tome/Util/memoryutils.h \
+    ../Source/Tome/Util/stringreplacer.h \
     ../Source/Tome/Util/stringutils.h \
     ../Source/Tome/Features/Records/View/recordtreewidgetitem.h \
     ../Source/Tome/Features/Records/View/recordtreewidget.h \
@@ -242,6 +288,7 @@ HEADERS  += ../Source/Tome/Core/mainwindow.h \
     ../Source/Tome/Features/Types/Controller/customtypesetserializer.h \
     ../Source/Tome/Features/Types/Model/customtypesetlist.h \
     ../Source/Tome/Features/Export/Controller/exporttemplateserializer.h \
+    ../Source/Tome/Features/Export/Controller/recordexportcacheserializer.h \
     ../Source/Tome/Features/Export/Model/recordexporttemplatelist.h \
     ../Source/Tome/Features/Search/Controller/findrecordcontroller.h \
     ../Source/Tome/Features/Search/View/findrecordwindow.h \
@@ -287,6 +334,12 @@ HEADERS  += ../Source/Tome/Core/mainwindow.h \
     ../Source/Tome/Features/Records/Controller/Commands/revertrecordcommand.h \
     ../Source/Tome/Features/Records/Controller/Commands/reparentrecordcommand.h \
     ../Source/Tome/Features/Records/Controller/Commands/removerecordcommand.h \
+    ../Source/Tome/Features/Records/Controller/Commands/importrecordscommand.h \
+    ../Source/Tome/Features/Import/Model/recordimportfingerprint.h \
+    ../Source/Tome/Features/Import/Model/recordimportfingerprintcache.h \
+    ../Source/Tome/Features/Import/Model/recordimportfingerprintcacheentry.h \
+    ../Source/Tome/Features/Import/Model/recordimportrow.h \
+    ../Source/Tome/Features/Import/Model/recordimportrowlist.h \
     ../Source/Tome/Features/Import/Model/recordtableimporttemplate.h \
     ../Source/Tome/Features/Import/Model/tabletype.h \
     ../Source/Tome/Features/Import/Model/recordtableimporttemplatelist.h \
@@ -296,6 +349,7 @@ HEADERS  += ../Source/Tome/Core/mainwindow.h \
     ../Source/Tome/Features/Import/Controller/xlsxrecorddatasource.h \
     ../Source/Tome/Features/Import/Controller/googlesheetsrecorddatasource.h \
     ../Source/Tome/Features/Import/Controller/importtemplateserializer.h \
+    ../Source/Tome/Features/Import/Controller/recordimportfingerprintserializer.h \
     ../Source/Tome/Features/Facets/Controller/localizedstringfacet.h \
     ../Source/Tome/Features/Integrity/Controller/componenthasnofieldstask.h \
     ../Source/Tome/Features/Integrity/Controller/fieldisneverusedtask.h \
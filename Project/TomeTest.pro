@@ -11,9 +11,24 @@ QT += testlib
 
 SOURCES -= ../Source/Tome/main.cpp
 
-HEADERS += ../Source/Tome/Tests/testlistutils.h \
-    ../Source/Tome/Tests/teststringutils.h
+HEADERS += ../Source/Tome/Tests/testbinaryrecordexport.h \
+    ../Source/Tome/Tests/testcppheaderwriter.h \
+    ../Source/Tome/Tests/testcsvreader.h \
+    ../Source/Tome/Tests/testjsonrecordsetserializer.h \
+    ../Source/Tome/Tests/testlistutils.h \
+    ../Source/Tome/Tests/teststringreplacer.h \
+    ../Source/Tome/Tests/teststringutils.h \
+    ../Source/Tome/Tests/testxlsxreader.h \
+    ../Source/Tome/Tests/testxmlwriter.h \
+    ../Source/TomeBinaryReader/tomebinaryreader.h
 
 SOURCES += ../Source/Tome/testmain.cpp \
+    ../Source/Tome/Tests/testbinaryrecordexport.cpp \
+    ../Source/Tome/Tests/testcppheaderwriter.cpp \
+    ../Source/Tome/Tests/testcsvreader.cpp \
+    ../Source/Tome/Tests/testjsonrecordsetserializer.cpp \
     ../Source/Tome/Tests/testlistutils.cpp \
-    ../Source/Tome/Tests/teststringutils.cpp
+    ../Source/Tome/Tests/teststringreplacer.cpp \
+    ../Source/Tome/Tests/teststringutils.cpp \
+    ../Source/Tome/Tests/testxlsxreader.cpp \
+    ../Source/Tome/Tests/testxmlwriter.cpp
@@ -14,6 +14,27 @@ void CommandLineOptions::parse(int argc, char* argv[])
             continue;
         }
 
+        // Parse parallel export.
+        if (!qstrcmp(argv[i], "-parallel-export"))
+        {
+            this->parallelExport = true;
+            continue;
+        }
+
+        // Parse incremental export.
+        if (!qstrcmp(argv[i], "-incremental-export"))
+        {
+            this->incrementalExport = true;
+            continue;
+        }
+
+        // Parse streaming hash.
+        if (!qstrcmp(argv[i], "-streaming-hash"))
+        {
+            this->streamingHash = true;
+            continue;
+        }
+
         // Parse project path.
         if (!qstrcmp(argv[i], "-project") && (i + 1 < argc))
         {
@@ -22,15 +43,64 @@ void CommandLineOptions::parse(int argc, char* argv[])
             continue;
         }
 
+        // Parse record set conversion.
+        if (!qstrcmp(argv[i], "-convert-records") && (i + 1 < argc))
+        {
+            this->convertRecordsFormat = QString(argv[i + 1]);
+            i = i + 1;
+            continue;
+        }
+
         // Parse export.
         if (!qstrcmp(argv[i], "-export") && (i + 2 < argc))
         {
-            this->exportTemplateName = QString(argv[i + 1]);
-            this->exportPath = QString(argv[i + 2]);
+            this->exportTemplateNames << QString(argv[i + 1]);
+            this->exportPaths << QString(argv[i + 2]);
+            i = i + 2;
+            continue;
+        }
+
+        // Parse import.
+        if (!qstrcmp(argv[i], "-import") && (i + 2 < argc))
+        {
+            this->importTemplateNames << QString(argv[i + 1]);
+            this->importSources << QString(argv[i + 2]);
             i = i + 2;
             continue;
         }
 
+        // Parse export with all templates.
+        if (!qstrcmp(argv[i], "-export-all") && (i + 1 < argc))
+        {
+            this->exportAllTemplatesPath = QString(argv[i + 1]);
+            i = i + 1;
+            continue;
+        }
+
+        // Parse binary export.
+        if (!qstrcmp(argv[i], "-export-binary") && (i + 1 < argc))
+        {
+            this->exportBinaryPath = QString(argv[i + 1]);
+            i = i + 1;
+            continue;
+        }
+
+        // Parse export compression.
+        if (!qstrcmp(argv[i], "-export-compression") && (i + 1 < argc))
+        {
+            this->exportCompression = QString(argv[i + 1]);
+            i = i + 1;
+            continue;
+        }
+
+        // Parse C++ header export.
+        if (!qstrcmp(argv[i], "-export-cpp") && (i + 1 < argc))
+        {
+            this->exportCppHeaderPath = QString(argv[i + 1]);
+            i = i + 1;
+            continue;
+        }
+
         // Parse project path.
         if (argv[i][0] != '-')
         {
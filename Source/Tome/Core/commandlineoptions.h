@@ -2,6 +2,7 @@
 #define COMMANDLINEOPTIONS_H
 
 #include <QString>
+#include <QStringList>
 
 namespace Tome
 {
@@ -29,24 +30,74 @@ namespace Tome
             char** argv = nullptr;
 
             /**
-             * @brief Path to export all data to.
+             * @brief Format to convert all record sets to, before saving the project again.
              */
-            QString exportPath;
+            QString convertRecordsFormat;
 
             /**
-             * @brief Name of the export template to use for the export.
+             * @brief Path of the directory to export all data to, using every export template of the project.
              */
-            QString exportTemplateName;
+            QString exportAllTemplatesPath;
+
+            /**
+             * @brief Path of the file to export all records to as typed binary data.
+             */
+            QString exportBinaryPath;
+
+            /**
+             * @brief Compression to apply to all exported files, e.g. Gzip.
+             */
+            QString exportCompression;
+
+            /**
+             * @brief Path of the C++ header to export all records to as constexpr tables.
+             */
+            QString exportCppHeaderPath;
+
+            /**
+             * @brief Paths to export all data to, one for each export template name.
+             */
+            QStringList exportPaths;
+
+            /**
+             * @brief Names of the export templates to use for the export.
+             */
+            QStringList exportTemplateNames;
+
+            /**
+             * @brief Sources to import records from (e.g. file names), one for each import template name.
+             */
+            QStringList importSources;
+
+            /**
+             * @brief Names of the import templates to import records with. All sources are imported at once, and the project is saved afterwards.
+             */
+            QStringList importTemplateNames;
+
+            /**
+             * @brief Whether to re-render only records that have changed since the previous export.
+             */
+            bool incrementalExport = false;
 
             /**
              * @brief Whether to prevent Tome from opening a window.
              */
             bool noGui = false;
 
+            /**
+             * @brief Whether to render records on multiple threads when exporting.
+             */
+            bool parallelExport = false;
+
             /**
              * @brief Project to open.
              */
             QString projectPath;
+
+            /**
+             * @brief Whether to compute export hashes while writing the output, instead of hashing all records up front.
+             */
+            bool streamingHash = false;
     };
 }
 
@@ -3,6 +3,8 @@
 #include <stdexcept>
 
 #include <QApplication>
+#include <QDir>
+#include <QEventLoop>
 #include <QFileInfo>
 #include <QSysInfo>
 
@@ -66,7 +68,7 @@ Controller::Controller(CommandLineOptions* options) :
     tasksController(new TasksController(*this->componentsController, *this->facetsController, *this->fieldDefinitionsController, *this->projectController, *this->recordsController, *this->typesController)),
     findUsagesController(new FindUsagesController(*this->fieldDefinitionsController, *this->recordsController, *this->typesController)),
     findRecordController(new FindRecordController(*this->recordsController)),
-    importController(new ImportController(*this->fieldDefinitionsController, *this->recordsController, *this->typesController)),
+    importController(new ImportController(*this->fieldDefinitionsController, *this->recordsController, *this->typesController, *this->undoController)),
     mainWindow(0)
 {
     // Setup tasks.
@@ -235,27 +237,189 @@ int Controller::start()
         }
     }
 
-    if (!this->options->exportTemplateName.isEmpty() &&
-            !this->options->exportPath.isEmpty() &&
+    if (!this->options->convertRecordsFormat.isEmpty() &&
             this->projectController->isProjectLoaded())
     {
-        if (!this->exportController->hasRecordExportTemplate(this->options->exportTemplateName))
+        RecordSetFormat::RecordSetFormat format = RecordSetFormat::fromString(this->options->convertRecordsFormat);
+
+        if (format == RecordSetFormat::Invalid)
         {
-            qCritical(QString("Export template not found: %1").arg(this->options->exportTemplateName).toUtf8().constData());
+            qCritical(QString("Invalid record set format: %1").arg(this->options->convertRecordsFormat).toUtf8().constData());
             return 1;
         }
 
-        // Get export template.
-        const Tome::RecordExportTemplate& exportTemplate =
-                this->exportController->getRecordExportTemplate(this->options->exportTemplateName);
+        // Convert records by saving them in the new format.
+        try
+        {
+            const QStringList recordSetNames = this->recordsController->getRecordSetNames();
+
+            for (const QString& recordSetName : recordSetNames)
+            {
+                this->recordsController->setRecordSetFormat(recordSetName, format);
+            }
+
+            this->projectController->saveProject();
+        }
+        catch (std::runtime_error& e)
+        {
+            qCritical(e.what());
+            return 1;
+        }
+    }
+
+    if (!this->options->importTemplateNames.isEmpty() &&
+            this->projectController->isProjectLoaded())
+    {
+        // Get import templates.
+        Tome::RecordTableImportTemplateList importTemplates;
+        QVariantList importSources;
+
+        for (int i = 0; i < this->options->importTemplateNames.size(); ++i)
+        {
+            const QString& importTemplateName = this->options->importTemplateNames[i];
+
+            try
+            {
+                importTemplates << this->importController->getRecordTableImportTemplate(importTemplateName);
+                importSources << this->options->importSources[i];
+            }
+            catch (const std::out_of_range&)
+            {
+                qCritical(QString("Import template not found: %1").arg(importTemplateName).toUtf8().constData());
+                return 1;
+            }
+        }
+
+        // Import from all sources at once, and wait for the import to finish.
+        QEventLoop eventLoop;
+        bool importFailed = false;
+
+        QMetaObject::Connection importErrorConnection = connect(
+                    this->importController,
+                    &ImportController::importError,
+                    [&importFailed](const QString& error)
+        {
+            qCritical(qUtf8Printable(error));
+            importFailed = true;
+        });
+
+        QMetaObject::Connection importFinishedConnection = connect(
+                    this->importController,
+                    &ImportController::importFinished,
+                    &eventLoop,
+                    &QEventLoop::quit);
+
+        this->importController->importRecords(importTemplates, importSources);
+
+        if (this->importController->isImporting())
+        {
+            eventLoop.exec();
+        }
+
+        disconnect(importErrorConnection);
+        disconnect(importFinishedConnection);
 
-        // Build export file path.
-        const QString filePath = this->options->exportPath + exportTemplate.fileExtension;
+        if (importFailed)
+        {
+            return 1;
+        }
 
-        // Export records.
+        // Save imported records.
         try
         {
-            this->exportController->exportRecords(exportTemplate, filePath);
+            this->projectController->saveProject();
+        }
+        catch (std::runtime_error& e)
+        {
+            qCritical(e.what());
+            return 1;
+        }
+    }
+
+    if ((!this->options->exportTemplateNames.isEmpty() || !this->options->exportAllTemplatesPath.isEmpty()) &&
+            this->projectController->isProjectLoaded())
+    {
+        // Get export templates and build export file paths.
+        Tome::RecordExportTemplateList exportTemplates;
+        QStringList filePaths;
+
+        for (int i = 0; i < this->options->exportTemplateNames.size(); ++i)
+        {
+            const QString& exportTemplateName = this->options->exportTemplateNames[i];
+
+            if (!this->exportController->hasRecordExportTemplate(exportTemplateName))
+            {
+                qCritical(QString("Export template not found: %1").arg(exportTemplateName).toUtf8().constData());
+                return 1;
+            }
+
+            const Tome::RecordExportTemplate& exportTemplate =
+                    this->exportController->getRecordExportTemplate(exportTemplateName);
+
+            exportTemplates << exportTemplate;
+            filePaths << this->options->exportPaths[i] + exportTemplate.fileExtension;
+        }
+
+        if (!this->options->exportAllTemplatesPath.isEmpty())
+        {
+            const QDir exportDirectory(this->options->exportAllTemplatesPath);
+            const Tome::RecordExportTemplateList allExportTemplates = this->exportController->getRecordExportTemplates();
+
+            for (const Tome::RecordExportTemplate& availableTemplate : allExportTemplates)
+            {
+                const Tome::RecordExportTemplate& exportTemplate =
+                        this->exportController->getRecordExportTemplate(availableTemplate.name);
+
+                exportTemplates << exportTemplate;
+                filePaths << exportDirectory.filePath(exportTemplate.name + exportTemplate.fileExtension);
+            }
+        }
+
+        RecordExportCompression::RecordExportCompression compression =
+                RecordExportCompression::fromString(this->options->exportCompression);
+
+        if (compression == RecordExportCompression::Invalid)
+        {
+            qCritical(QString("Invalid export compression: %1").arg(this->options->exportCompression).toUtf8().constData());
+            return 1;
+        }
+
+        // Export records with all templates at once.
+        try
+        {
+            RecordExportOptions options;
+            options.parallel = this->options->parallelExport;
+            options.incremental = this->options->incrementalExport;
+            options.streamingHash = this->options->streamingHash;
+            options.compression = compression;
+
+            this->exportController->exportRecords(exportTemplates, filePaths, options);
+        }
+        catch (std::runtime_error& e)
+        {
+            qCritical(e.what());
+            return 1;
+        }
+    }
+
+    if (!this->options->exportBinaryPath.isEmpty() && this->projectController->isProjectLoaded())
+    {
+        try
+        {
+            this->exportController->exportRecordsBinary(this->options->exportBinaryPath);
+        }
+        catch (std::runtime_error& e)
+        {
+            qCritical(e.what());
+            return 1;
+        }
+    }
+
+    if (!this->options->exportCppHeaderPath.isEmpty() && this->projectController->isProjectLoaded())
+    {
+        try
+        {
+            this->exportController->exportRecordsCppHeader(this->options->exportCppHeaderPath);
         }
         catch (std::runtime_error& e)
         {
@@ -269,12 +433,16 @@ int Controller::start()
 
 void Controller::onProjectChanged(QSharedPointer<Project> project)
 {
+    // Stop importing into the previous project.
+    this->importController->cancelImport();
+
     this->componentsController->setComponents(project->componentSets);
     this->exportController->setRecordExportTemplates(project->recordExportTemplates);
     this->fieldDefinitionsController->setFieldDefinitionSets(project->fieldDefinitionSets);
     this->recordsController->setRecordSets(project->recordSets);
     this->typesController->setCustomTypes(project->typeSets);
     this->importController->setRecordTableImportTemplates(project->recordTableImportTemplates);
+    this->importController->setProjectFilePath(this->projectController->getFullProjectPath());
 
     // Add to recent projects.
     const QString& fullPath = this->projectController->getFullProjectPath();
@@ -1196,6 +1196,10 @@ void MainWindow::on_actionUser_Settings_triggered()
     settingsController.setRunIntegrityChecksOnSave(this->userSettingsWindow->getRunIntegrityChecksOnSave());
     settingsController.setShowDescriptionColumnInsteadOfFieldTooltips(this->userSettingsWindow->getShowDescriptionColumnInsteadOfFieldTooltips());
     settingsController.setExpandRecordTreeOnRefresh(this->userSettingsWindow->getExpandRecordTreeOnRefresh());
+    settingsController.setParallelExport(this->userSettingsWindow->getParallelExport());
+    settingsController.setIncrementalExport(this->userSettingsWindow->getIncrementalExport());
+    settingsController.setStreamingExportHash(this->userSettingsWindow->getStreamingExportHash());
+    settingsController.setCompressedExport(this->userSettingsWindow->getCompressedExport());
     settingsController.setShowComponentNamesInRecordTable(this->userSettingsWindow->getShowComponentNamesInRecordTable());
 
     // Refresh view with updated settings.
@@ -1282,7 +1286,15 @@ void MainWindow::exportRecords(QAction* exportAction)
     // Export records.
     try
     {
-        this->controller->getExportController().exportRecords(exportTemplate, filePath);
+        RecordExportOptions options;
+        options.parallel = this->controller->getSettingsController().getParallelExport();
+        options.incremental = this->controller->getSettingsController().getIncrementalExport();
+        options.streamingHash = this->controller->getSettingsController().getStreamingExportHash();
+        options.compression = this->controller->getSettingsController().getCompressedExport()
+                ? RecordExportCompression::Gzip
+                : RecordExportCompression::None;
+
+        this->controller->getExportController().exportRecords(exportTemplate, filePath, options);
     }
     catch (std::runtime_error& e)
     {
@@ -1621,7 +1633,9 @@ void MainWindow::onImportError(const QString& error)
 void MainWindow::onImportFinished()
 {
     this->refreshRecordTreeAfterReparent = true;
-    this->refreshRecordTree();
+
+    // Record tree has already been refreshed when applying all imported records at once.
+    this->refreshRecordTable();
 }
 
 void MainWindow::onImportStarted()
@@ -0,0 +1,455 @@
+#include "binaryrecordwriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <QColor>
+#include <QObject>
+#include <QtEndian>
+
+#include "../Model/recordexportdata.h"
+#include "../../Fields/Controller/fielddefinitionscontroller.h"
+#include "../../Fields/Model/fielddefinition.h"
+#include "../../Records/Model/record.h"
+#include "../../Types/Controller/typescontroller.h"
+#include "../../Types/Model/builtintype.h"
+#include "../../Types/Model/vector.h"
+
+using namespace Tome;
+
+
+const quint32 BinaryRecordWriter::Version = 1;
+
+const quint32 BinaryRecordWriter::Magic = 0x424D4F54;
+const quint32 BinaryRecordWriter::NoParent = 0xFFFFFFFF;
+const int BinaryRecordWriter::HeaderSize = 64;
+const int BinaryRecordWriter::ColumnSize = 24;
+const int BinaryRecordWriter::RecordSize = 16;
+const int BinaryRecordWriter::ItemSize = 16;
+
+
+BinaryRecordWriter::BinaryRecordWriter(const FieldDefinitionsController& fieldDefinitionsController,
+                                       const TypesController& typesController)
+    : fieldDefinitionsController(fieldDefinitionsController),
+      typesController(typesController)
+{
+}
+
+void BinaryRecordWriter::write(QIODevice& device, const RecordExportData& data) const
+{
+    BinaryTables tables;
+    tables.itemCount = 0;
+
+    // String 0 is always the empty string.
+    this->addString(tables, QString());
+
+    const int recordCount = data.records.size();
+    const int bitmapSize = ((recordCount + 7) / 8 + 7) / 8 * 8;
+
+    // Write column data.
+    QVector<const FieldDefinition*> fieldDefinitions;
+    QVector<BinaryValueType::BinaryValueType> valueTypes;
+    QVector<BinaryValueType::BinaryValueType> itemTypes;
+    QVector<QByteArray> columnData;
+
+    const FieldDefinitionSetList& fieldDefinitionSets = this->fieldDefinitionsController.getFieldDefinitionSets();
+
+    for (int i = 0; i < fieldDefinitionSets.size(); ++i)
+    {
+        const FieldDefinitionSet& fieldDefinitionSet = fieldDefinitionSets.at(i);
+
+        for (int j = 0; j < fieldDefinitionSet.fieldDefinitions.size(); ++j)
+        {
+            const FieldDefinition& fieldDefinition = fieldDefinitionSet.fieldDefinitions.at(j);
+
+            // Resolve value types.
+            const BinaryValueType::BinaryValueType valueType = this->getValueType(fieldDefinition.fieldType);
+            BinaryValueType::BinaryValueType itemType = BinaryValueType::None;
+
+            if (valueType == BinaryValueType::List)
+            {
+                itemType = this->getItemType(this->typesController.getCustomType(fieldDefinition.fieldType).getItemType());
+            }
+            else if (valueType == BinaryValueType::Map)
+            {
+                itemType = this->getItemType(this->typesController.getCustomType(fieldDefinition.fieldType).getValueType());
+            }
+
+            // Write presence bitmap, followed by one value per record.
+            const int cellSize = BinaryValueType::getCellSize(valueType);
+
+            QByteArray bytes(bitmapSize + cellSize * recordCount, '\0');
+            uchar* column = reinterpret_cast<uchar*>(bytes.data());
+
+            for (int row = 0; row < recordCount; ++row)
+            {
+                const RecordFieldValueMap& fieldValues = data.fieldValues[row];
+                RecordFieldValueMap::const_iterator it = fieldValues.constFind(fieldDefinition.id);
+
+                if (it == fieldValues.cend())
+                {
+                    continue;
+                }
+
+                column[row / 8] |= static_cast<uchar>(1 << (row % 8));
+
+                uchar* cell = column + bitmapSize + row * cellSize;
+
+                if (valueType == BinaryValueType::List || valueType == BinaryValueType::Map)
+                {
+                    this->writeItems(tables, cell, it.value(), valueType, itemType);
+                }
+                else
+                {
+                    this->writeValue(tables, cell, it.value(), valueType);
+                }
+            }
+
+            this->align(bytes);
+
+            fieldDefinitions << &fieldDefinition;
+            valueTypes << valueType;
+            itemTypes << itemType;
+            columnData << bytes;
+        }
+    }
+
+    // Write records.
+    QByteArray records;
+    records.reserve(recordCount * RecordSize);
+
+    QVector<QByteArray> recordIds(recordCount);
+    QVector<quint32> recordIndex(recordCount);
+
+    for (int row = 0; row < recordCount; ++row)
+    {
+        const Record* record = data.records[row];
+        const QString recordId = record->id.toString();
+        const int parentRow = data.parents[row];
+
+        this->appendUInt32(records, this->addString(tables, recordId));
+        this->appendUInt32(records, this->addString(tables, record->displayName));
+        this->appendUInt32(records, parentRow >= 0 ? static_cast<quint32>(parentRow) : NoParent);
+        this->appendUInt32(records, 0);
+
+        recordIds[row] = recordId.toUtf8();
+        recordIndex[row] = static_cast<quint32>(row);
+    }
+
+    // Sort record index by id, for binary search.
+    std::sort(recordIndex.begin(), recordIndex.end(), [&recordIds](quint32 lhs, quint32 rhs)
+    {
+        return recordIds[lhs] < recordIds[rhs];
+    });
+
+    QByteArray recordIndexBytes;
+    recordIndexBytes.reserve(recordCount * 4 + 4);
+
+    for (const quint32 row : recordIndex)
+    {
+        this->appendUInt32(recordIndexBytes, row);
+    }
+
+    this->align(recordIndexBytes);
+
+    // Collect column strings, before the string table is complete.
+    QVector<quint32> columnStrings;
+
+    for (const FieldDefinition* fieldDefinition : fieldDefinitions)
+    {
+        columnStrings << this->addString(tables, fieldDefinition->id)
+                      << this->addString(tables, fieldDefinition->fieldType)
+                      << this->addString(tables, fieldDefinition->component);
+    }
+
+    // Write string table.
+    const quint32 stringCount = static_cast<quint32>(tables.stringOffsets.size());
+
+    QByteArray stringOffsets;
+    stringOffsets.reserve((stringCount + 2) * 4);
+
+    for (const quint32 offset : tables.stringOffsets)
+    {
+        this->appendUInt32(stringOffsets, offset);
+    }
+
+    this->appendUInt32(stringOffsets, static_cast<quint32>(tables.stringData.size()));
+    this->align(stringOffsets);
+    this->align(tables.stringData);
+
+    // Lay out sections.
+    const int columnCount = fieldDefinitions.size();
+
+    const quint32 stringOffsetsOffset = HeaderSize;
+    const quint32 stringDataOffset = stringOffsetsOffset + stringOffsets.size();
+    const quint32 columnsOffset = stringDataOffset + tables.stringData.size();
+
+    quint32 offset = columnsOffset + columnCount * ColumnSize;
+
+    QByteArray columns;
+    columns.reserve(columnCount * ColumnSize);
+
+    for (int i = 0; i < columnCount; ++i)
+    {
+        this->appendUInt32(columns, columnStrings[i * 3]);
+        this->appendUInt32(columns, columnStrings[i * 3 + 1]);
+        this->appendUInt32(columns, columnStrings[i * 3 + 2]);
+        columns.append(static_cast<char>(valueTypes[i]));
+        columns.append(static_cast<char>(itemTypes[i]));
+        columns.append(2, '\0');
+        this->appendUInt32(columns, offset);
+        this->appendUInt32(columns, 0);
+
+        offset += columnData[i].size();
+    }
+
+    const quint32 recordsOffset = offset;
+    const quint32 recordIndexOffset = recordsOffset + records.size();
+    const quint32 itemsOffset = recordIndexOffset + recordIndexBytes.size();
+
+    // Write header.
+    QByteArray header;
+    header.reserve(HeaderSize);
+
+    this->appendUInt32(header, Magic);
+    this->appendUInt32(header, Version);
+    this->appendUInt32(header, static_cast<quint32>(recordCount));
+    this->appendUInt32(header, static_cast<quint32>(columnCount));
+    this->appendUInt32(header, stringCount);
+    this->appendUInt32(header, tables.itemCount);
+    this->appendUInt32(header, stringOffsetsOffset);
+    this->appendUInt32(header, stringDataOffset);
+    this->appendUInt32(header, columnsOffset);
+    this->appendUInt32(header, recordsOffset);
+    this->appendUInt32(header, recordIndexOffset);
+    this->appendUInt32(header, itemsOffset);
+    header.append(HeaderSize - header.size(), '\0');
+
+    // Write file.
+    QVector<QByteArray> sections;
+    sections << header << stringOffsets << tables.stringData << columns << columnData
+             << records << recordIndexBytes << tables.items;
+
+    for (const QByteArray& section : sections)
+    {
+        if (device.write(section) != section.size())
+        {
+            const QString errorMessage = QObject::tr("Binary export could not be written: %1").arg(device.errorString());
+            throw std::runtime_error(errorMessage.toStdString());
+        }
+    }
+}
+
+quint32 BinaryRecordWriter::addString(BinaryTables& tables, const QString& s) const
+{
+    QHash<QString, quint32>::const_iterator it = tables.stringIndices.constFind(s);
+
+    if (it != tables.stringIndices.cend())
+    {
+        return it.value();
+    }
+
+    const quint32 index = static_cast<quint32>(tables.stringOffsets.size());
+
+    tables.stringOffsets.append(static_cast<quint32>(tables.stringData.size()));
+    tables.stringData.append(s.toUtf8());
+    tables.stringData.append('\0');
+    tables.stringIndices.insert(s, index);
+
+    return index;
+}
+
+void BinaryRecordWriter::align(QByteArray& bytes) const
+{
+    const int padding = (8 - bytes.size() % 8) % 8;
+    bytes.append(padding, '\0');
+}
+
+void BinaryRecordWriter::appendUInt32(QByteArray& bytes, quint32 value) const
+{
+    uchar buffer[4];
+    qToLittleEndian<quint32>(value, buffer);
+    bytes.append(reinterpret_cast<const char*>(buffer), 4);
+}
+
+BinaryValueType::BinaryValueType BinaryRecordWriter::getItemType(const QString& typeName) const
+{
+    const BinaryValueType::BinaryValueType itemType = this->getValueType(typeName);
+
+    // Items that don't fit into a single item slot are stored as strings.
+    return BinaryValueType::isItemType(itemType) ? itemType : BinaryValueType::String;
+}
+
+BinaryValueType::BinaryValueType BinaryRecordWriter::getValueType(const QString& typeName) const
+{
+    // Check built-in types.
+    if (typeName == BuiltInType::Boolean)
+    {
+        return BinaryValueType::Boolean;
+    }
+
+    if (typeName == BuiltInType::Color)
+    {
+        return BinaryValueType::Color;
+    }
+
+    if (typeName == BuiltInType::Integer)
+    {
+        return BinaryValueType::Integer;
+    }
+
+    if (typeName == BuiltInType::Real)
+    {
+        return BinaryValueType::Real;
+    }
+
+    if (typeName == BuiltInType::Vector2I)
+    {
+        return BinaryValueType::Vector2I;
+    }
+
+    if (typeName == BuiltInType::Vector2R)
+    {
+        return BinaryValueType::Vector2R;
+    }
+
+    if (typeName == BuiltInType::Vector3I)
+    {
+        return BinaryValueType::Vector3I;
+    }
+
+    if (typeName == BuiltInType::Vector3R)
+    {
+        return BinaryValueType::Vector3R;
+    }
+
+    // Check custom types.
+    if (this->typesController.isCustomType(typeName))
+    {
+        const CustomType& customType = this->typesController.getCustomType(typeName);
+
+        if (customType.isList())
+        {
+            return BinaryValueType::List;
+        }
+
+        if (customType.isMap())
+        {
+            return BinaryValueType::Map;
+        }
+
+        if (customType.isDerivedType())
+        {
+            return this->getValueType(customType.getBaseType());
+        }
+    }
+
+    // Strings, files, references, enumerations and all other values are stored as strings.
+    return BinaryValueType::String;
+}
+
+void BinaryRecordWriter::writeItems(BinaryTables& tables,
+                                    uchar* cell,
+                                    const QVariant& value,
+                                    BinaryValueType::BinaryValueType valueType,
+                                    BinaryValueType::BinaryValueType itemType) const
+{
+    const quint32 firstItem = tables.itemCount;
+
+    QByteArray item(ItemSize, '\0');
+    uchar* itemData = reinterpret_cast<uchar*>(item.data());
+
+    if (valueType == BinaryValueType::List)
+    {
+        const QVariantList list = value.toList();
+
+        for (const QVariant& listItem : list)
+        {
+            item.fill('\0');
+            this->writeValue(tables, itemData + 8, listItem, itemType);
+            tables.items.append(item);
+            ++tables.itemCount;
+        }
+    }
+    else
+    {
+        const QVariantMap map = value.toMap();
+
+        for (QVariantMap::const_iterator it = map.cbegin(); it != map.cend(); ++it)
+        {
+            item.fill('\0');
+            qToLittleEndian<quint32>(this->addString(tables, it.key()), itemData);
+            this->writeValue(tables, itemData + 8, it.value(), itemType);
+            tables.items.append(item);
+            ++tables.itemCount;
+        }
+    }
+
+    qToLittleEndian<quint32>(firstItem, cell);
+    qToLittleEndian<quint32>(tables.itemCount - firstItem, cell + 4);
+}
+
+void BinaryRecordWriter::writeValue(BinaryTables& tables,
+                                    uchar* cell,
+                                    const QVariant& value,
+                                    BinaryValueType::BinaryValueType valueType) const
+{
+    switch (valueType)
+    {
+        case BinaryValueType::Boolean:
+            cell[0] = value.toBool() ? 1 : 0;
+            break;
+
+        case BinaryValueType::Integer:
+            qToLittleEndian<qint32>(value.toInt(), cell);
+            break;
+
+        case BinaryValueType::Real:
+        {
+            const double real = value.toDouble();
+            quint64 bits;
+            memcpy(&bits, &real, sizeof(bits));
+            qToLittleEndian<quint64>(bits, cell);
+            break;
+        }
+
+        case BinaryValueType::Color:
+            qToLittleEndian<quint32>(value.value<QColor>().rgba(), cell);
+            break;
+
+        case BinaryValueType::Vector2I:
+        case BinaryValueType::Vector3I:
+        {
+            const QVariantMap vector = value.toMap();
+
+            this->writeValue(tables, cell, vector[BuiltInType::Vector::X], BinaryValueType::Integer);
+            this->writeValue(tables, cell + 4, vector[BuiltInType::Vector::Y], BinaryValueType::Integer);
+
+            if (valueType == BinaryValueType::Vector3I)
+            {
+                this->writeValue(tables, cell + 8, vector[BuiltInType::Vector::Z], BinaryValueType::Integer);
+            }
+            break;
+        }
+
+        case BinaryValueType::Vector2R:
+        case BinaryValueType::Vector3R:
+        {
+            const QVariantMap vector = value.toMap();
+
+            this->writeValue(tables, cell, vector[BuiltInType::Vector::X], BinaryValueType::Real);
+            this->writeValue(tables, cell + 8, vector[BuiltInType::Vector::Y], BinaryValueType::Real);
+
+            if (valueType == BinaryValueType::Vector3R)
+            {
+                this->writeValue(tables, cell + 16, vector[BuiltInType::Vector::Z], BinaryValueType::Real);
+            }
+            break;
+        }
+
+        default:
+            qToLittleEndian<quint32>(this->addString(tables, value.toString()), cell);
+            break;
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef BINARYRECORDWRITER_H
+#define BINARYRECORDWRITER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QIODevice>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include "../Model/binaryvaluetype.h"
+
+namespace Tome
+{
+    class FieldDefinitionsController;
+    class RecordExportData;
+    class TypesController;
+
+    /**
+     * @brief Writes all records to a typed binary file that can be memory-mapped and read without any parsing.
+     *
+     * All numbers are little-endian, and all offsets are absolute byte offsets from the start of the file.
+     * Every section starts at a multiple of eight bytes. The file consists of:
+     *
+     * - Header (64 bytes): magic "TOMB", version, record count, column count, string count, item count,
+     *   followed by the offsets of the string offset table, string data, columns, records, record index and items.
+     * - String offset table: string count + 1 uint32 offsets into the string data. String 0 is always empty.
+     * - String data: UTF-8 strings, each followed by a terminating zero byte.
+     * - Columns (24 bytes each): field id, field type and component string indices, value type, item type,
+     *   and the offset of the column data. Column data is a presence bitmap with one bit per record, padded to
+     *   eight bytes, followed by one fixed-width value per record.
+     * - Records (16 bytes each): id and display name string indices, and the row of the parent record.
+     * - Record index: rows of all records, sorted by the UTF-8 bytes of their ids.
+     * - Items (16 bytes each): key string index and value of list and map items.
+     *
+     * Source/TomeBinaryReader/tomebinaryreader.h contains a reader for this format.
+     */
+    class BinaryRecordWriter
+    {
+        public:
+            /**
+             * @brief Constructs a new writer for exporting records to binary files.
+             * @param fieldDefinitionsController Controller for adding, updating and removing field definitions.
+             * @param typesController Controller for adding, updating and removing custom types.
+             */
+            BinaryRecordWriter(const FieldDefinitionsController& fieldDefinitionsController,
+                               const TypesController& typesController);
+
+            /**
+             * @brief Writes the passed records to the specified device.
+             *
+             * @exception std::runtime_error if the device could not be written.
+             *
+             * @param device Device to write the records to.
+             * @param data Records to write, along with their hierarchy and resolved field values.
+             */
+            void write(QIODevice& device, const RecordExportData& data) const;
+
+            /**
+             * @brief Current version of the binary file format.
+             */
+            static const quint32 Version;
+
+        private:
+            /**
+             * @brief Strings and list or map items collected while writing a file.
+             */
+            struct BinaryTables
+            {
+                QHash<QString, quint32> stringIndices;
+                QVector<quint32> stringOffsets;
+                QByteArray stringData;
+                QByteArray items;
+                quint32 itemCount;
+            };
+
+            static const quint32 Magic;
+            static const quint32 NoParent;
+            static const int HeaderSize;
+            static const int ColumnSize;
+            static const int RecordSize;
+            static const int ItemSize;
+
+            const FieldDefinitionsController& fieldDefinitionsController;
+            const TypesController& typesController;
+
+            quint32 addString(BinaryTables& tables, const QString& s) const;
+            void align(QByteArray& bytes) const;
+            void appendUInt32(QByteArray& bytes, quint32 value) const;
+            BinaryValueType::BinaryValueType getItemType(const QString& typeName) const;
+            BinaryValueType::BinaryValueType getValueType(const QString& typeName) const;
+            void writeItems(BinaryTables& tables,
+                            uchar* cell,
+                            const QVariant& value,
+                            BinaryValueType::BinaryValueType valueType,
+                            BinaryValueType::BinaryValueType itemType) const;
+            void writeValue(BinaryTables& tables,
+                            uchar* cell,
+                            const QVariant& value,
+                            BinaryValueType::BinaryValueType valueType) const;
+    };
+}
+
+#endif // BINARYRECORDWRITER_H
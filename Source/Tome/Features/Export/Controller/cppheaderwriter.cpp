@@ -0,0 +1,571 @@
+#include "cppheaderwriter.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include <QColor>
+#include <QObject>
+
+#include "../Model/recordexportdata.h"
+#include "../../Fields/Controller/fielddefinitionscontroller.h"
+#include "../../Fields/Model/fielddefinition.h"
+#include "../../Records/Model/record.h"
+#include "../../Types/Controller/typescontroller.h"
+#include "../../Types/Model/builtintype.h"
+#include "../../Types/Model/vector.h"
+
+using namespace Tome;
+
+
+const QStringList CppHeaderWriter::Keywords = QStringList()
+        << "alignas" << "alignof" << "and" << "and_eq" << "asm" << "auto" << "bitand" << "bitor" << "bool"
+        << "break" << "case" << "catch" << "char" << "char16_t" << "char32_t" << "class" << "compl" << "const"
+        << "constexpr" << "const_cast" << "continue" << "decltype" << "default" << "delete" << "do" << "double"
+        << "dynamic_cast" << "else" << "enum" << "explicit" << "export" << "extern" << "false" << "float" << "for"
+        << "friend" << "goto" << "if" << "inline" << "int" << "long" << "mutable" << "namespace" << "new"
+        << "noexcept" << "not" << "not_eq" << "nullptr" << "operator" << "or" << "or_eq" << "private"
+        << "protected" << "public" << "register" << "reinterpret_cast" << "return" << "short" << "signed"
+        << "sizeof" << "static" << "static_assert" << "static_cast" << "struct" << "switch" << "template" << "this"
+        << "thread_local" << "throw" << "true" << "try" << "typedef" << "typeid" << "typename" << "union"
+        << "unsigned" << "using" << "virtual" << "void" << "volatile" << "wchar_t" << "while" << "xor" << "xor_eq";
+
+const QStringList CppHeaderWriter::ReservedIdentifiers = QStringList()
+        << "Detail" << "MapEntry" << "Record" << "RecordIds" << "Records" << "Span"
+        << "Vector2I" << "Vector2R" << "Vector3I" << "Vector3R";
+
+
+CppHeaderWriter::CppHeaderWriter(const FieldDefinitionsController& fieldDefinitionsController,
+                                 const TypesController& typesController)
+    : fieldDefinitionsController(fieldDefinitionsController),
+      typesController(typesController)
+{
+}
+
+void CppHeaderWriter::write(QIODevice& device, const RecordExportData& data, const QString& namespaceName) const
+{
+    CppHeaderNames names;
+    names.storageCount = 0;
+
+    QSet<QString> usedNamespaceIdentifiers;
+    QSet<QString> usedIdentifiers;
+
+    for (const QString& identifier : ReservedIdentifiers)
+    {
+        usedIdentifiers.insert(identifier);
+    }
+
+    // Index custom types.
+    const CustomTypeSetList& customTypeSets = this->typesController.getCustomTypeSets();
+
+    for (int i = 0; i < customTypeSets.size(); ++i)
+    {
+        const CustomTypeSet& customTypeSet = customTypeSets.at(i);
+
+        for (int j = 0; j < customTypeSet.types.size(); ++j)
+        {
+            const CustomType& customType = customTypeSet.types.at(j);
+            names.customTypes.insert(customType.name, customType);
+        }
+    }
+
+    // Write preamble.
+    QString header;
+
+    header += QString("// Generated by Tome %1. Do not edit.\n\n").arg(APP_VERSION);
+    header += "#pragma once\n\n";
+    header += "#include <cstddef>\n";
+    header += "#include <cstdint>\n\n";
+    header += "namespace " + this->getIdentifier(namespaceName, usedNamespaceIdentifiers) + "\n{\n";
+
+    header += "    template<typename T>\n";
+    header += "    struct Span\n";
+    header += "    {\n";
+    header += "        const T* data;\n";
+    header += "        std::size_t size;\n\n";
+    header += "        constexpr const T* begin() const { return data; }\n";
+    header += "        constexpr const T* end() const { return data + size; }\n";
+    header += "        constexpr const T& operator[](std::size_t index) const { return data[index]; }\n";
+    header += "    };\n\n";
+
+    header += "    template<typename K, typename V>\n";
+    header += "    struct MapEntry\n";
+    header += "    {\n";
+    header += "        K key;\n";
+    header += "        V value;\n";
+    header += "    };\n\n";
+
+    header += "    struct Vector2I { std::int32_t x; std::int32_t y; };\n";
+    header += "    struct Vector2R { double x; double y; };\n";
+    header += "    struct Vector3I { std::int32_t x; std::int32_t y; std::int32_t z; };\n";
+    header += "    struct Vector3R { double x; double y; double z; };\n\n";
+
+    // Write enumerations.
+    for (int i = 0; i < customTypeSets.size(); ++i)
+    {
+        const CustomTypeSet& customTypeSet = customTypeSets.at(i);
+
+        for (int j = 0; j < customTypeSet.types.size(); ++j)
+        {
+            const CustomType& customType = customTypeSet.types.at(j);
+
+            if (!customType.isEnumeration())
+            {
+                continue;
+            }
+
+            const QString enumerationIdentifier = this->getIdentifier(customType.name, usedIdentifiers);
+            names.enumerationIdentifiers.insert(customType.name, enumerationIdentifier);
+
+            QHash<QString, QString>& memberIdentifiers = names.enumerationMemberIdentifiers[customType.name];
+            QSet<QString> usedMemberIdentifiers;
+            QStringList members;
+
+            for (const QString& member : customType.getEnumeration())
+            {
+                const QString memberIdentifier = this->getIdentifier(member, usedMemberIdentifiers);
+                memberIdentifiers.insert(member, memberIdentifier);
+                members << "        " + memberIdentifier;
+            }
+
+            header += "    enum class " + enumerationIdentifier + "\n    {\n";
+            header += members.join(",\n") + "\n";
+            header += "    };\n\n";
+        }
+    }
+
+    // Write record ids.
+    QSet<QString> usedRecordIdentifiers;
+
+    header += "    namespace RecordIds\n    {\n";
+
+    for (const Record* record : data.records)
+    {
+        const QString recordId = record->id.toString();
+
+        if (names.recordIdentifiers.contains(recordId))
+        {
+            continue;
+        }
+
+        const QString recordIdentifier = this->getIdentifier(recordId, usedRecordIdentifiers);
+        names.recordIdentifiers.insert(recordId, recordIdentifier);
+
+        header += "        constexpr const char* " + recordIdentifier + " = " + this->getLiteral(recordId) + ";\n";
+    }
+
+    header += "    }\n\n";
+
+    // Group fields by component, in the order of their first appearance.
+    QStringList components;
+    QHash<QString, QVector<const FieldDefinition*>> componentFieldDefinitions;
+
+    const FieldDefinitionSetList& fieldDefinitionSets = this->fieldDefinitionsController.getFieldDefinitionSets();
+
+    for (int i = 0; i < fieldDefinitionSets.size(); ++i)
+    {
+        const FieldDefinitionSet& fieldDefinitionSet = fieldDefinitionSets.at(i);
+
+        for (int j = 0; j < fieldDefinitionSet.fieldDefinitions.size(); ++j)
+        {
+            const FieldDefinition& fieldDefinition = fieldDefinitionSet.fieldDefinitions.at(j);
+
+            if (!fieldDefinition.component.isEmpty() && !componentFieldDefinitions.contains(fieldDefinition.component))
+            {
+                components << fieldDefinition.component;
+            }
+
+            componentFieldDefinitions[fieldDefinition.component] << &fieldDefinition;
+        }
+    }
+
+    // Write one table per component, followed by the table of all records for fields without component.
+    components << QString();
+
+    for (const QString& component : components)
+    {
+        const QVector<const FieldDefinition*> fieldDefinitions = componentFieldDefinitions.value(component);
+        const bool componentTable = !component.isEmpty();
+
+        const QString structIdentifier = componentTable
+                ? this->getIdentifier(component, usedIdentifiers)
+                : QString("Record");
+        const QString arrayIdentifier = componentTable
+                ? this->getIdentifier(structIdentifier + "Records", usedIdentifiers)
+                : QString("Records");
+
+        // Write struct.
+        QSet<QString> usedMemberIdentifiers;
+        usedMemberIdentifiers << structIdentifier << "id" << "displayName";
+
+        header += "    struct " + structIdentifier + "\n    {\n";
+        header += "        const char* id;\n";
+
+        if (!componentTable)
+        {
+            header += "        const char* displayName;\n";
+        }
+
+        for (const FieldDefinition* fieldDefinition : fieldDefinitions)
+        {
+            header += "        " + this->getCppType(names, fieldDefinition->fieldType) + " " +
+                    this->getIdentifier(fieldDefinition->id, usedMemberIdentifiers) + ";\n";
+        }
+
+        header += "    };\n\n";
+
+        // Write rows.
+        QString rows;
+        int rowCount = 0;
+
+        for (int row = 0; row < data.records.size(); ++row)
+        {
+            const RecordFieldValueMap& fieldValues = data.fieldValues[row];
+
+            if (componentTable)
+            {
+                bool hasComponent = false;
+
+                for (const FieldDefinition* fieldDefinition : fieldDefinitions)
+                {
+                    if (fieldValues.contains(fieldDefinition->id))
+                    {
+                        hasComponent = true;
+                        break;
+                    }
+                }
+
+                if (!hasComponent)
+                {
+                    continue;
+                }
+            }
+
+            const Record* record = data.records[row];
+            QStringList values;
+
+            values << "RecordIds::" + names.recordIdentifiers[record->id.toString()];
+
+            if (!componentTable)
+            {
+                values << this->getLiteral(record->displayName);
+            }
+
+            for (const FieldDefinition* fieldDefinition : fieldDefinitions)
+            {
+                const QVariant value = fieldValues.value(fieldDefinition->id, fieldDefinition->defaultValue);
+                values << this->getValue(names, value, fieldDefinition->fieldType);
+            }
+
+            rows += "        { " + values.join(", ") + " },\n";
+            ++rowCount;
+        }
+
+        // Write static storage of lists and maps, which has to precede the table.
+        if (!names.storage.isEmpty())
+        {
+            header += "    namespace Detail\n    {\n" + names.storage + "    }\n\n";
+            names.storage.clear();
+        }
+
+        // Write table. C++ doesn't allow empty arrays.
+        if (rowCount == 0)
+        {
+            header += "    // No records with component " + structIdentifier + ".\n\n";
+            continue;
+        }
+
+        header += "    constexpr " + structIdentifier + " " + arrayIdentifier + "[] =\n    {\n";
+        header += rows;
+        header += "    };\n\n";
+    }
+
+    header += "}\n";
+
+    // Write file.
+    const QByteArray bytes = header.toUtf8();
+
+    if (device.write(bytes) != bytes.size())
+    {
+        const QString errorMessage = QObject::tr("C++ header could not be written: %1").arg(device.errorString());
+        throw std::runtime_error(errorMessage.toStdString());
+    }
+}
+
+QString CppHeaderWriter::getCppType(const CppHeaderNames& names, const QString& typeName) const
+{
+    // Check built-in types.
+    if (typeName == BuiltInType::Boolean)
+    {
+        return "bool";
+    }
+
+    if (typeName == BuiltInType::Color)
+    {
+        return "std::uint32_t";
+    }
+
+    if (typeName == BuiltInType::Integer)
+    {
+        return "std::int32_t";
+    }
+
+    if (typeName == BuiltInType::Real)
+    {
+        return "double";
+    }
+
+    if (typeName == BuiltInType::Vector2I)
+    {
+        return "Vector2I";
+    }
+
+    if (typeName == BuiltInType::Vector2R)
+    {
+        return "Vector2R";
+    }
+
+    if (typeName == BuiltInType::Vector3I)
+    {
+        return "Vector3I";
+    }
+
+    if (typeName == BuiltInType::Vector3R)
+    {
+        return "Vector3R";
+    }
+
+    // Check custom types.
+    QHash<QString, CustomType>::const_iterator it = names.customTypes.constFind(typeName);
+
+    if (it != names.customTypes.cend())
+    {
+        const CustomType& customType = it.value();
+
+        if (customType.isEnumeration())
+        {
+            return names.enumerationIdentifiers[customType.name];
+        }
+
+        if (customType.isList())
+        {
+            return "Span<" + this->getCppType(names, customType.getItemType()) + ">";
+        }
+
+        if (customType.isMap())
+        {
+            return "Span<MapEntry<" + this->getCppType(names, customType.getKeyType()) + ", " +
+                    this->getCppType(names, customType.getValueType()) + ">>";
+        }
+
+        if (customType.isDerivedType())
+        {
+            return this->getCppType(names, customType.getBaseType());
+        }
+    }
+
+    // Strings, files, references and all other values are exported as string literals.
+    return "const char*";
+}
+
+QString CppHeaderWriter::getIdentifier(const QString& name, QSet<QString>& usedIdentifiers) const
+{
+    // Replace all characters that aren't allowed in identifiers.
+    QString identifier;
+    identifier.reserve(name.size() + 1);
+
+    for (const QChar c : name)
+    {
+        const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        identifier += allowed ? c : QChar('_');
+    }
+
+    if (identifier.isEmpty() || identifier[0].isDigit())
+    {
+        identifier.prepend('_');
+    }
+
+    if (Keywords.contains(identifier))
+    {
+        identifier += '_';
+    }
+
+    // Disambiguate names that map to the same identifier.
+    QString uniqueIdentifier = identifier;
+
+    for (int i = 2; usedIdentifiers.contains(uniqueIdentifier); ++i)
+    {
+        uniqueIdentifier = identifier + "_" + QString::number(i);
+    }
+
+    usedIdentifiers.insert(uniqueIdentifier);
+    return uniqueIdentifier;
+}
+
+QString CppHeaderWriter::getLiteral(const QString& s) const
+{
+    const QByteArray bytes = s.toUtf8();
+
+    QString literal;
+    literal.reserve(bytes.size() + 2);
+    literal += '"';
+
+    for (const char byte : bytes)
+    {
+        const uchar c = static_cast<uchar>(byte);
+
+        if (c == '\\' || c == '"' || c == '?')
+        {
+            literal += '\\';
+            literal += QChar(c);
+        }
+        else if (c < 0x20 || c >= 0x7F)
+        {
+            // Escape control characters and UTF-8 sequences as octal, which never consumes following characters.
+            literal += QString("\\%1").arg(c, 3, 8, QChar('0'));
+        }
+        else
+        {
+            literal += QChar(c);
+        }
+    }
+
+    literal += '"';
+    return literal;
+}
+
+QString CppHeaderWriter::getValue(CppHeaderNames& names, const QVariant& value, const QString& typeName) const
+{
+    // Check built-in types.
+    if (typeName == BuiltInType::Boolean)
+    {
+        return value.toBool() ? "true" : "false";
+    }
+
+    if (typeName == BuiltInType::Color)
+    {
+        const QColor color = value.value<QColor>();
+        return "0x" + QString("%1").arg(color.rgba(), 8, 16, QChar('0')).toUpper() + "u";
+    }
+
+    if (typeName == BuiltInType::Integer)
+    {
+        return QString::number(value.toInt());
+    }
+
+    if (typeName == BuiltInType::Real)
+    {
+        const double real = value.toDouble();
+
+        if (!std::isfinite(real))
+        {
+            return "0.0";
+        }
+
+        QString literal = QString::number(real, 'g', 17);
+
+        if (!literal.contains('.') && !literal.contains('e'))
+        {
+            literal += ".0";
+        }
+
+        return literal;
+    }
+
+    if (typeName == BuiltInType::Vector2I || typeName == BuiltInType::Vector3I ||
+            typeName == BuiltInType::Vector2R || typeName == BuiltInType::Vector3R)
+    {
+        const QVariantMap vector = value.toMap();
+        const QString componentType = (typeName == BuiltInType::Vector2I || typeName == BuiltInType::Vector3I)
+                ? BuiltInType::Integer
+                : BuiltInType::Real;
+
+        QStringList components;
+        components << this->getValue(names, vector[BuiltInType::Vector::X], componentType)
+                   << this->getValue(names, vector[BuiltInType::Vector::Y], componentType);
+
+        if (typeName == BuiltInType::Vector3I || typeName == BuiltInType::Vector3R)
+        {
+            components << this->getValue(names, vector[BuiltInType::Vector::Z], componentType);
+        }
+
+        return "{ " + components.join(", ") + " }";
+    }
+
+    if (typeName == BuiltInType::Reference)
+    {
+        const QString recordId = value.toString();
+        QHash<QString, QString>::const_iterator it = names.recordIdentifiers.constFind(recordId);
+
+        return it != names.recordIdentifiers.cend() ? "RecordIds::" + it.value() : this->getLiteral(recordId);
+    }
+
+    // Check custom types.
+    QHash<QString, CustomType>::const_iterator it = names.customTypes.constFind(typeName);
+
+    if (it != names.customTypes.cend())
+    {
+        const CustomType customType = it.value();
+
+        if (customType.isEnumeration())
+        {
+            const QHash<QString, QString>& memberIdentifiers = names.enumerationMemberIdentifiers[customType.name];
+            QHash<QString, QString>::const_iterator memberIt = memberIdentifiers.constFind(value.toString());
+
+            return memberIt != memberIdentifiers.cend()
+                    ? names.enumerationIdentifiers[customType.name] + "::" + memberIt.value()
+                    : QString("{}");
+        }
+
+        if (customType.isList() || customType.isMap())
+        {
+            QStringList items;
+            QString itemType;
+
+            if (customType.isList())
+            {
+                const QVariantList list = value.toList();
+
+                for (const QVariant& item : list)
+                {
+                    items << this->getValue(names, item, customType.getItemType());
+                }
+
+                itemType = this->getCppType(names, customType.getItemType());
+            }
+            else
+            {
+                const QVariantMap map = value.toMap();
+
+                for (QVariantMap::const_iterator mapIt = map.cbegin(); mapIt != map.cend(); ++mapIt)
+                {
+                    items << "{ " + this->getValue(names, mapIt.key(), customType.getKeyType()) + ", " +
+                             this->getValue(names, mapIt.value(), customType.getValueType()) + " }";
+                }
+
+                itemType = "MapEntry<" + this->getCppType(names, customType.getKeyType()) + ", " +
+                        this->getCppType(names, customType.getValueType()) + ">";
+            }
+
+            if (items.isEmpty())
+            {
+                return "{ nullptr, 0 }";
+            }
+
+            // Add static storage for the items, after the storage of any nested lists and maps.
+            const QString storageIdentifier = "Items" + QString::number(names.storageCount++);
+
+            names.storage += "        constexpr " + itemType + " " + storageIdentifier + "[] = { " +
+                    items.join(", ") + " };\n";
+
+            return "{ Detail::" + storageIdentifier + ", " + QString::number(items.size()) + " }";
+        }
+
+        if (customType.isDerivedType())
+        {
+            return this->getValue(names, value, customType.getBaseType());
+        }
+    }
+
+    // Strings, files and all other values are exported as string literals.
+    return this->getLiteral(value.toString());
+}
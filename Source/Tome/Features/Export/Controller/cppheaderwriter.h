@@ -0,0 +1,82 @@
+#ifndef CPPHEADERWRITER_H
+#define CPPHEADERWRITER_H
+
+#include <QHash>
+#include <QIODevice>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include "../../Types/Model/customtype.h"
+
+namespace Tome
+{
+    class FieldDefinitionsController;
+    class RecordExportData;
+    class TypesController;
+
+    /**
+     * @brief Writes all records to a C++ header with constexpr tables that can be compiled into the game.
+     *
+     * The generated header contains:
+     *
+     * - One enum class for each enumeration type.
+     * - One string constant for each record id, in the RecordIds namespace.
+     * - One struct and constexpr array for each component, holding the values of all records with any field of that
+     *   component. Missing values are replaced by the default value of the respective field.
+     * - The struct Record and constexpr array Records, holding id, display name and all fields without component
+     *   of every record.
+     *
+     * Lists and maps are exported as spans over static storage in the Detail namespace.
+     */
+    class CppHeaderWriter
+    {
+        public:
+            /**
+             * @brief Constructs a new writer for exporting records to C++ headers.
+             * @param fieldDefinitionsController Controller for adding, updating and removing field definitions.
+             * @param typesController Controller for adding, updating and removing custom types.
+             */
+            CppHeaderWriter(const FieldDefinitionsController& fieldDefinitionsController,
+                            const TypesController& typesController);
+
+            /**
+             * @brief Writes the passed records to the specified device.
+             *
+             * @exception std::runtime_error if the device could not be written.
+             *
+             * @param device Device to write the header to.
+             * @param data Records to write, along with their hierarchy and resolved field values.
+             * @param namespaceName Name of the namespace to put all generated types and tables into.
+             */
+            void write(QIODevice& device, const RecordExportData& data, const QString& namespaceName) const;
+
+        private:
+            /**
+             * @brief Identifiers of all generated types and constants, and static storage collected while writing a header.
+             */
+            struct CppHeaderNames
+            {
+                QHash<QString, CustomType> customTypes;
+                QHash<QString, QString> enumerationIdentifiers;
+                QHash<QString, QHash<QString, QString>> enumerationMemberIdentifiers;
+                QHash<QString, QString> recordIdentifiers;
+                QString storage;
+                int storageCount;
+            };
+
+            static const QStringList Keywords;
+            static const QStringList ReservedIdentifiers;
+
+            const FieldDefinitionsController& fieldDefinitionsController;
+            const TypesController& typesController;
+
+            QString getCppType(const CppHeaderNames& names, const QString& typeName) const;
+            QString getIdentifier(const QString& name, QSet<QString>& usedIdentifiers) const;
+            QString getLiteral(const QString& s) const;
+            QString getValue(CppHeaderNames& names, const QVariant& value, const QString& typeName) const;
+    };
+}
+
+#endif // CPPHEADERWRITER_H
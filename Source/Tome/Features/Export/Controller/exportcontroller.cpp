@@ -2,45 +2,46 @@
 
 #include <stdexcept>
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSemaphore>
+#include <QSet>
 #include <QStringBuilder>
 #include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent>
 
+#include "binaryrecordwriter.h"
+#include "cppheaderwriter.h"
+#include "exporttemplatecompiler.h"
+#include "recordexportcacheserializer.h"
 #include "../../Facets/Controller/facetscontroller.h"
 #include "../../Facets/Controller/localizedstringfacet.h"
 #include "../../Fields//Controller/fielddefinitionscontroller.h"
 #include "../../Fields/Model/fielddefinition.h"
+#include "../../Projects/Controller/projectcontroller.h"
 #include "../../Records/Controller/recordscontroller.h"
 #include "../../Types/Controller/typescontroller.h"
 #include "../../Types/Model/builtintype.h"
 #include "../../Types/Model/vector.h"
+#include "../../../IO/gzipdevice.h"
+#include "../../../IO/hashingdevice.h"
 
 using namespace Tome;
 
-const QString ExportController::PlaceholderAppVersion = "$APP_VERSION$";
-const QString ExportController::PlaceholderAppVersionName = "$APP_VERSION_NAME$";
-const QString ExportController::PlaceholderComponents = "$RECORD_COMPONENTS$";
-const QString ExportController::PlaceholderComponentName = "$COMPONENT_NAME$";
-const QString ExportController::PlaceholderExportTime = "$EXPORT_TIME$";
-const QString ExportController::PlaceholderFieldComponent = "$FIELD_COMPONENT$";
-const QString ExportController::PlaceholderFieldDescription = "$FIELD_DESCRIPTION$";
-const QString ExportController::PlaceholderFieldDisplayName = "$FIELD_DISPLAY_NAME$";
-const QString ExportController::PlaceholderFieldId = "$FIELD_ID$";
-const QString ExportController::PlaceholderFieldKey = "$FIELD_KEY$";
-const QString ExportController::PlaceholderFieldType = "$FIELD_TYPE$";
-const QString ExportController::PlaceholderFieldValue = "$FIELD_VALUE$";
-const QString ExportController::PlaceholderHash = "$HASH$";
-const QString ExportController::PlaceholderItemType = "$ITEM_TYPE$";
-const QString ExportController::PlaceholderKeyType = "$KEY_TYPE$";
-const QString ExportController::PlaceholderListItem = "$LIST_ITEM$";
-const QString ExportController::PlaceholderRecordDisplayName = "$RECORD_DISPLAY_NAME$";
-const QString ExportController::PlaceholderRecordFields = "$RECORD_FIELDS$";
-const QString ExportController::PlaceholderRecordId = "$RECORD_ID$";
-const QString ExportController::PlaceholderRecordParentId = "$RECORD_PARENT$";
-const QString ExportController::PlaceholderRecordRootId = "$RECORD_ROOT$";
-const QString ExportController::PlaceholderRecords = "$RECORDS$";
-const QString ExportController::PlaceholderValueType = "$VALUE_TYPE$";
+
+const QString ExportController::CacheFileExtension = ".tomecache";
+const QString ExportController::HashFileExtension = ".sha1";
+const int ExportController::StreamingHashLength = 40;
+const QString ExportController::ManifestFileExtension = ".manifest";
+const int ExportController::ParallelExportChunkSize = 256;
 
 
 ExportController::ExportController(const FacetsController& facetsController,
@@ -73,7 +74,9 @@ const RecordExportTemplate ExportController::getRecordExportTemplate(const QStri
     {
         if (it->name == name)
         {
-            return *it;
+            RecordExportTemplate exportTemplate = *it;
+            this->loadTemplateContents(exportTemplate);
+            return exportTemplate;
         }
     }
 
@@ -102,533 +105,1655 @@ bool ExportController::hasRecordExportTemplate(const QString& name) const
     return false;
 }
 
-void ExportController::exportRecords(const RecordExportTemplate& exportTemplate, const QString& filePath) const
+void ExportController::exportRecords(const RecordExportTemplate& exportTemplate,
+                                     const QString& filePath,
+                                     const RecordExportOptions& options) const
 {
-    QFile file(filePath);
+    this->exportRecords(RecordExportTemplateList() << exportTemplate, QStringList() << filePath, options);
+}
+
+void ExportController::exportRecords(const RecordExportTemplate& exportTemplate,
+                                     QIODevice& device,
+                                     const RecordExportOptions& options) const
+{
+    const CompiledRecordExportTemplate compiledTemplate = this->compileTemplate(exportTemplate);
+    const RecordExportData data = this->resolveRecords(this->requiresHash(compiledTemplate) && !options.streamingHash);
+
+    const QVector<RecordExportItem> items = this->selectRecords(exportTemplate, data);
+
+    this->writeRecordFile(device, exportTemplate, compiledTemplate, data, items, nullptr, nullptr, options, false, true);
+}
 
-    qInfo(qUtf8Printable(QString("Opening file %1 for record export.").arg(filePath)));
+void ExportController::exportRecords(const RecordExportTemplateList& exportTemplates,
+                                     const QStringList& filePaths,
+                                     const RecordExportOptions& options) const
+{
+    // Compile templates.
+    QVector<CompiledRecordExportTemplate> compiledTemplates;
+    bool hashRequired = false;
 
-    if (file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+    for (const RecordExportTemplate& exportTemplate : exportTemplates)
     {
-        this->exportRecords(exportTemplate, file);
+        const CompiledRecordExportTemplate compiledTemplate = this->compileTemplate(exportTemplate);
+        hashRequired = hashRequired || this->requiresHash(compiledTemplate);
+        compiledTemplates.append(compiledTemplate);
     }
-    else
+
+    // Compressed output can't be patched afterwards, so hash all records up front instead of streaming the hash.
+    RecordExportOptions exportOptions = options;
+
+    if (options.compression != RecordExportCompression::None)
+    {
+        exportOptions.streamingHash = false;
+    }
+
+    // Resolve records once for all templates. Streaming hashes are computed from the output instead.
+    const RecordExportData data = this->resolveRecords(hashRequired && !exportOptions.streamingHash);
+
+    // Write record files.
+    for (int i = 0; i < exportTemplates.size(); ++i)
+    {
+        const QString& filePath = filePaths.at(i);
+
+        if (exportTemplates.at(i).splitMode != RecordExportSplitMode::None)
+        {
+            // Split exports aren't incremental, but only changed files have to be reloaded, according to their manifest.
+            this->writeSplitRecordFiles(filePath, exportTemplates.at(i), compiledTemplates.at(i), data, exportOptions);
+            continue;
+        }
+
+        const QVector<RecordExportItem> items = this->selectRecords(exportTemplates.at(i), data);
+        const QString outputFilePath = filePath + RecordExportCompression::getFileExtension(options.compression);
+        QFile file(outputFilePath);
+
+        qInfo(qUtf8Printable(QString("Opening file %1 for record export.").arg(outputFilePath)));
+
+        if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+        {
+            QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + outputFilePath;
+            qCritical(qUtf8Printable(errorMessage));
+            throw std::runtime_error(errorMessage.toStdString());
+        }
+
+        // Compress output while writing it, if requested.
+        GzipDevice gzipDevice(file);
+        QIODevice* device = &file;
+
+        if (options.compression == RecordExportCompression::Gzip)
+        {
+            if (!gzipDevice.open(QIODevice::WriteOnly))
+            {
+                qCritical(qUtf8Printable(gzipDevice.errorString()));
+                throw std::runtime_error(gzipDevice.errorString().toStdString());
+            }
+
+            device = &gzipDevice;
+        }
+
+        QByteArray hash;
+
+        if (!options.incremental)
+        {
+            hash = this->writeRecordFile(*device, exportTemplates.at(i), compiledTemplates.at(i), data, items,
+                                         nullptr, nullptr, exportOptions, options.streamingHash, true);
+        }
+        else
+        {
+            // Load output of previous export, and replace it by the output of this one.
+            const QString cacheFilePath = filePath + CacheFileExtension;
+
+            RecordExportCache cache;
+            cache.templateDigest = this->computeTemplateDigest(exportTemplates.at(i), compiledTemplates.at(i));
+
+            const RecordExportCache previousCache = this->loadCache(cacheFilePath, cache.templateDigest);
+
+            hash = this->writeRecordFile(*device, exportTemplates.at(i), compiledTemplates.at(i), data, items,
+                                         &previousCache, &cache, exportOptions, options.streamingHash, true);
+            this->saveCache(cacheFilePath, cache);
+        }
+
+        if (!gzipDevice.finish())
+        {
+            qCritical(qUtf8Printable(gzipDevice.errorString()));
+            throw std::runtime_error(gzipDevice.errorString().toStdString());
+        }
+
+        if (options.streamingHash)
+        {
+            this->saveHash(filePath + HashFileExtension, hash);
+        }
+    }
+}
+
+void ExportController::exportRecordsBinary(const QString& filePath) const
+{
+    QFile file(filePath);
+
+    qInfo(qUtf8Printable(QString("Opening file %1 for binary record export.").arg(filePath)));
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
     {
         QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + filePath;
         qCritical(qUtf8Printable(errorMessage));
         throw std::runtime_error(errorMessage.toStdString());
     }
+
+    this->exportRecordsBinary(file);
 }
 
-void ExportController::exportRecords(const RecordExportTemplate& exportTemplate, QIODevice& device) const
+void ExportController::exportRecordsBinary(QIODevice& device) const
 {
-    qInfo(qUtf8Printable(QString("Exporting records with template %1.").arg(exportTemplate.name)));
+    const RecordExportData data = this->resolveRecords(false);
 
-    // Build record file string.
-    QString recordsString;
+    BinaryRecordWriter writer(this->fieldDefinitionsController, this->typesController);
+    writer.write(device, data);
+}
 
-    const RecordSetList& recordSets = this->recordsController.getRecordSets();
-    const FieldDefinitionList& fields = this->fieldDefinitionsController.getFieldDefinitions();
+void ExportController::exportRecordsCppHeader(const QString& filePath) const
+{
+    QFile file(filePath);
 
-    for (int i = 0; i < recordSets.size(); ++i)
+    qInfo(qUtf8Printable(QString("Opening file %1 for C++ header record export.").arg(filePath)));
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
     {
-        const RecordSet& recordSet = recordSets[i];
+        QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + filePath;
+        qCritical(qUtf8Printable(errorMessage));
+        throw std::runtime_error(errorMessage.toStdString());
+    }
 
-        for (int j = 0; j < recordSet.records.size(); ++j)
-        {
-            const Record& record = recordSet.records[j];
+    this->exportRecordsCppHeader(file, QFileInfo(filePath).baseName());
+}
 
-            // Report progress.
-            emit this->progressChanged(tr("Exporting Data"), record.displayName, j, recordSet.records.size());
+void ExportController::exportRecordsCppHeader(QIODevice& device, const QString& namespaceName) const
+{
+    const RecordExportData data = this->resolveRecords(false);
 
-            // Check if should export.
-            if (record.parentId.isNull())
-            {
-                // Root node.
-                if (!exportTemplate.exportRoots)
-                {
-                    continue;
-                }
-            }
-            else
-            {
-                if (this->recordsController.getChildren(record.id).empty())
-                {
-                    // Leaf node.
-                    if (!exportTemplate.exportLeafs)
-                    {
-                        continue;
-                    }
-                }
-                else
-                {
-                    // Inner node.
-                    if (!exportTemplate.exportInnerNodes)
-                    {
-                        continue;
-                    }
-                }
-            }
+    CppHeaderWriter writer(this->fieldDefinitionsController, this->typesController);
+    writer.write(device, data, namespaceName);
+}
 
-            // Check if whitelisted.
-            if (!exportTemplate.includedRecords.isEmpty())
-            {
-                bool whitelisted = exportTemplate.includedRecords.contains(record.id.toString());
+bool ExportController::removeExportTemplate(const QString& name)
+{
+    qInfo(qUtf8Printable(QString("Removing export template %1.").arg(name)));
 
-                if (!whitelisted)
-                {
-                    // Check if any ancestor whitelisted.
-                    RecordList ancestors = this->recordsController.getAncestors(record.id);
+    // Update model.
+    for (RecordExportTemplateList::iterator it = this->model->begin();
+         it != this->model->end();
+         ++it)
+    {
+        if (it->name == name)
+        {
+            this->model->erase(it);
 
-                    for (int i = 0; i < ancestors.size(); ++i)
-                    {
-                        if (exportTemplate.includedRecords.contains(ancestors[i].id.toString()))
-                        {
-                            whitelisted = true;
-                            break;
-                        }
-                    }
-                }
+            // Notify listeners.
+            emit this->exportTemplatesChanged();
+            return true;
+        }
+    }
 
-                if (!whitelisted)
-                {
-                    continue;
-                }
-            }
+    return false;
+}
 
-            // Check if ignored.
-            if (exportTemplate.ignoredRecords.contains(record.id.toString()))
-            {
-                continue;
-            }
+bool ExportController::renderRecord(const RecordExportItem& item,
+                                    const RecordExportTemplate& exportTemplate,
+                                    const CompiledRecordExportTemplate& compiledTemplate,
+                                    QString& recordString) const
+{
+    recordString.resize(0);
 
-            // Check if any ancestor ignored.
-            RecordList ancestors = this->recordsController.getAncestors(record.id);
-            bool anyAncestorIgnored = false;
+    const Record& record = *item.record;
 
-            for (int i = 0; i < ancestors.size(); ++i)
-            {
-                if (exportTemplate.ignoredRecords.contains(ancestors[i].id.toString()))
-                {
-                    anyAncestorIgnored = true;
-                    break;
-                }
-            }
+    // Get fields to export.
+    RecordFieldValueMap fieldValues = *item.fieldValues;
 
-            if (anyAncestorIgnored)
+    if (exportTemplate.exportAsTable)
+    {
+        // Build field table, filling up with empty values.
+        for (QHash<QString, ExportFieldPlan>::const_iterator it = compiledTemplate.fieldPlans.cbegin();
+             it != compiledTemplate.fieldPlans.cend();
+             ++it)
+        {
+            if (!fieldValues.contains(it.key()))
             {
-                continue;
+                fieldValues[it.key()] = "";
             }
+        }
+    }
 
-            // Build field values string.
-            QString fieldValuesString;
+    // Do not export empty records.
+    if (fieldValues.empty())
+    {
+        return false;
+    }
 
-            // Get fields to export.
-            RecordFieldValueMap fieldValues = recordsController.getRecordFieldValues(record.id);
+    // Get record data.
+    const QString recordId = record.id.toString();
+    const QString& recordRoot = item.rootId;
+    const QString& recordParent = item.parentId;
 
-            if (exportTemplate.exportAsTable)
-            {
-                // Build field table, filling up with empty values.
-                for (int k = 0; k < fields.count(); ++k)
-                {
-                    const FieldDefinition& field = fields[k];
+    // Build field value text representations, by field ordinal.
+    QVector<QString> fieldValueTexts(compiledTemplate.recordTemplateFields.size());
 
-                    if (!fieldValues.contains(field.id))
-                    {
-                        fieldValues[field.id] = "";
-                    }
-                }
-            }
+    for (RecordFieldValueMap::const_iterator itFields = fieldValues.cbegin();
+         itFields != fieldValues.cend();
+         ++itFields)
+    {
+        const QString fieldId = itFields.key();
+        const QVariant fieldValue = itFields.value();
+        const ExportFieldPlan& fieldPlan = this->getFieldPlan(compiledTemplate, fieldId);
+        QString fieldValueText;
 
-            // Do not export empty records.
-            if (fieldValues.empty())
+        switch (fieldPlan.kind)
+        {
+            case ExportFieldKind::List:
             {
-                continue;
-            }
+                // Build list string.
+                const QVariantList list = fieldValue.toList();
 
-            // Get record data.
-            QVariant recordRoot = this->recordsController.getRootRecordId(record.id);
-            QVariant recordParent;
+                const QString* values[ExportTemplatePlaceholder::Count] = {};
+                values[ExportTemplatePlaceholder::FieldId] = &fieldId;
+                values[ExportTemplatePlaceholder::ItemType] = &fieldPlan.exportedItemType;
 
-            if (!record.parentId.isNull())
-            {
-                RecordFieldValueMap parentFieldValues = recordsController.getRecordFieldValues(record.parentId);
-
-                if (!parentFieldValues.empty())
+                for (int i = 0; i < list.size(); ++i)
                 {
-                    // Only export record parent if that parent isn't empty.
-                    recordParent = record.parentId;
+                    const QString listItem = list[i].toString();
+                    values[ExportTemplatePlaceholder::ListItem] = &listItem;
+
+                    this->appendTemplate(fieldValueText, compiledTemplate.listItemTemplate, values);
+
+                    if (i < list.size() - 1)
+                    {
+                        fieldValueText.append(exportTemplate.listItemDelimiter);
+                    }
                 }
+                break;
             }
 
-            // Build field value text representations.
-            QMap<QString, QString> fieldValueTexts;
-
-            for (RecordFieldValueMap::iterator itFields = fieldValues.begin();
-                 itFields != fieldValues.end();
-                 ++itFields)
+            case ExportFieldKind::Map:
             {
-                QString fieldId = itFields.key();
-                QVariant fieldValue = itFields.value();
-                QString fieldValueText = fieldValue.toString();
-
-                const FieldDefinition& fieldDefinition = this->fieldDefinitionsController.getFieldDefinition(fieldId);
+                // Build map string.
+                const QVariantMap map = fieldValue.toMap();
 
-                // Get field type name.
-                QString fieldType = fieldDefinition.fieldType;
+                const QString* values[ExportTemplatePlaceholder::Count] = {};
+                values[ExportTemplatePlaceholder::FieldId] = &fieldId;
 
-                // Check if list.
-                if (this->typesController.isCustomType(fieldType))
+                for (QVariantMap::const_iterator it = map.cbegin();
+                     it != map.cend();
+                     ++it)
                 {
-                    const CustomType& customType = this->typesController.getCustomType(fieldType);
+                    const QString mapKey = it.key();
+                    const QString mapValue = it.value().toString();
+                    values[ExportTemplatePlaceholder::FieldKey] = &mapKey;
+                    values[ExportTemplatePlaceholder::FieldValue] = &mapValue;
 
-                    if (customType.isList())
-                    {
-                        QString itemType = customType.getItemType();
-                        QString exportedItemType = exportTemplate.typeMap.value(itemType, itemType);
-                        // Build list string.
-                        fieldValueText = QString();
-
-                        QVariantList list = fieldValue.toList();
-
-                        for (int i = 0; i < list.size(); ++i)
-                        {
-                            QString listItem = exportTemplate.listItemTemplate;
-                            listItem = listItem.replace(PlaceholderFieldId, fieldId);
-                            listItem = listItem.replace(PlaceholderItemType, exportedItemType);
-                            listItem = listItem.replace(PlaceholderListItem, list[i].toString());
-                            fieldValueText.append(listItem);
-
-                            if (i < list.size() - 1)
-                            {
-                                fieldValueText.append(exportTemplate.listItemDelimiter);
-                            }
-                        }
-                    }
-                    else if (customType.isMap())
+                    this->appendTemplate(fieldValueText, compiledTemplate.mapItemTemplate, values);
+
+                    if (it + 1 != map.end())
                     {
-                        // Build map string.
-                        fieldValueText = QString();
-
-                        const QVariantMap map = fieldValue.toMap();
-
-                        for (QVariantMap::const_iterator it = map.cbegin();
-                             it != map.cend();
-                             ++it)
-                        {
-                            QString mapItem = exportTemplate.mapItemTemplate;
-                            mapItem = mapItem.replace(PlaceholderFieldId, fieldId);
-                            mapItem = mapItem.replace(PlaceholderFieldKey, it.key());
-                            mapItem = mapItem.replace(PlaceholderFieldValue, QVariant(it.value()).toString());
-                            fieldValueText.append(mapItem);
-
-                            if (it + 1 != map.end())
-                            {
-                                fieldValueText.append(exportTemplate.mapItemDelimiter);
-                            }
-                        }
+                        fieldValueText.append(exportTemplate.mapItemDelimiter);
                     }
                 }
-                // Check if vector.
-                else if (fieldType == BuiltInType::Vector2I || fieldType == BuiltInType::Vector2R ||
-                         fieldType == BuiltInType::Vector3I || fieldType == BuiltInType::Vector3R)
-                {
-                    // Build vector string.
-                    fieldValueText = QString();
+                break;
+            }
 
-                    QVariantMap vector = fieldValue.toMap();
+            case ExportFieldKind::Vector2:
+            case ExportFieldKind::Vector3:
+            {
+                // Build vector string.
+                const QVariantMap vector = fieldValue.toMap();
 
-                    QVariant x = vector[BuiltInType::Vector::X];
-                    QVariant y = vector[BuiltInType::Vector::Y];
+                const QString x = vector[BuiltInType::Vector::X].toString();
+                const QString y = vector[BuiltInType::Vector::Y].toString();
 
-                    // X.
-                    QString vectorComponent = exportTemplate.mapItemTemplate;
-                    vectorComponent = vectorComponent.replace(PlaceholderFieldId, fieldId);
-                    vectorComponent = vectorComponent.replace(PlaceholderFieldKey, "X");
-                    vectorComponent = vectorComponent.replace(PlaceholderFieldValue, x.toString());
-                    fieldValueText.append(vectorComponent);
-                    fieldValueText.append(exportTemplate.mapItemDelimiter);
+                const QString* values[ExportTemplatePlaceholder::Count] = {};
+                values[ExportTemplatePlaceholder::FieldId] = &fieldId;
 
-                    // Y.
-                    vectorComponent = exportTemplate.mapItemTemplate;
-                    vectorComponent = vectorComponent.replace(PlaceholderFieldId, fieldId);
-                    vectorComponent = vectorComponent.replace(PlaceholderFieldKey, "Y");
-                    vectorComponent = vectorComponent.replace(PlaceholderFieldValue, y.toString());
-                    fieldValueText.append(vectorComponent);
+                // X.
+                const QString keyX = "X";
+                values[ExportTemplatePlaceholder::FieldKey] = &keyX;
+                values[ExportTemplatePlaceholder::FieldValue] = &x;
+                this->appendTemplate(fieldValueText, compiledTemplate.mapItemTemplate, values);
+                fieldValueText.append(exportTemplate.mapItemDelimiter);
 
-                    if (fieldType == BuiltInType::Vector3I || fieldType == BuiltInType::Vector3R)
-                    {
-                        QVariant z = vector[BuiltInType::Vector::Z];
+                // Y.
+                const QString keyY = "Y";
+                values[ExportTemplatePlaceholder::FieldKey] = &keyY;
+                values[ExportTemplatePlaceholder::FieldValue] = &y;
+                this->appendTemplate(fieldValueText, compiledTemplate.mapItemTemplate, values);
 
-                        // Z.
-                        fieldValueText.append(exportTemplate.mapItemDelimiter);
+                if (fieldPlan.kind == ExportFieldKind::Vector3)
+                {
+                    const QString z = vector[BuiltInType::Vector::Z].toString();
 
-                        vectorComponent = exportTemplate.mapItemTemplate;
-                        vectorComponent = vectorComponent.replace(PlaceholderFieldId, fieldId);
-                        vectorComponent = vectorComponent.replace(PlaceholderFieldKey, "Z");
-                        vectorComponent = vectorComponent.replace(PlaceholderFieldValue, z.toString());
-                        fieldValueText.append(vectorComponent);
-                    }
-                }
+                    // Z.
+                    fieldValueText.append(exportTemplate.mapItemDelimiter);
 
-                // Apply string replacement.
-                for (auto itStringReplacementMap = exportTemplate.stringReplacementMap.cbegin();
-                     itStringReplacementMap != exportTemplate.stringReplacementMap.cend();
-                     ++itStringReplacementMap)
-                {
-                    fieldValueText = fieldValueText.replace(itStringReplacementMap.key(), itStringReplacementMap.value());
+                    const QString keyZ = "Z";
+                    values[ExportTemplatePlaceholder::FieldKey] = &keyZ;
+                    values[ExportTemplatePlaceholder::FieldValue] = &z;
+                    this->appendTemplate(fieldValueText, compiledTemplate.mapItemTemplate, values);
                 }
-
-                // Store for later use.
-                fieldValueTexts[fieldId] = fieldValueText;
+                break;
             }
 
-            // Apply record template.
-            QString recordString = exportTemplate.recordTemplate;
-
-            // Use regular expressions to match specific fields.
-            QRegExp regEx("\\$FIELD_VALUE:([a-zA-Z]*)\\$");
-            QStringList matchedSpecificFields;
+            default:
+                fieldValueText = fieldValue.toString();
+                break;
+        }
 
-            int pos = 0;
-            while ((pos = regEx.indexIn(recordString, pos)) != -1)
-            {
-                QString fieldId = regEx.cap(1);
-                QString fieldValue = fieldValueTexts[fieldId];
+        // Apply string replacement.
+        compiledTemplate.stringReplacer.replace(fieldValueText);
 
-                recordString.replace(pos, regEx.matchedLength(), fieldValue);
-                pos += fieldValue.length();
+        // Store for later use.
+        fieldValueTexts[fieldPlan.ordinal] = fieldValueText;
+    }
 
-                // Remember this field has already been matched, so it can be omitted later.
-                matchedSpecificFields << fieldId;
-            }
+    // Build full field values string.
+    QString fieldValuesString;
+    QString fieldValueString;
 
-            // Build full field values string.
-            for (RecordFieldValueMap::iterator itFields = fieldValues.begin();
-                 itFields != fieldValues.end();
-                 ++itFields)
-            {
-                // Get field data.
-                const QString fieldId = itFields.key();
-                const FieldDefinition& fieldDefinition = this->fieldDefinitionsController.getFieldDefinition(fieldId);
+    for (RecordFieldValueMap::const_iterator itFields = fieldValues.cbegin();
+         itFields != fieldValues.cend();
+         ++itFields)
+    {
+        // Get field data.
+        const QString fieldId = itFields.key();
+        const ExportFieldPlan& fieldPlan = this->getFieldPlan(compiledTemplate, fieldId);
+        const FieldDefinition& fieldDefinition = *fieldPlan.fieldDefinition;
 
-                const QString fieldType = fieldDefinition.fieldType;
-                const QString fieldComponent = fieldDefinition.component;
-                const QString fieldDescription = fieldDefinition.description;
-                const QString fieldDisplayName = fieldDefinition.displayName;
+        if (compiledTemplate.recordTemplateFields.testBit(fieldPlan.ordinal))
+        {
+            // Field has already explicitly been placed by the record template. Skip.
+            continue;
+        }
 
-                if (matchedSpecificFields.contains(fieldId))
-                {
-                    // Field has already explicitly been matched by a regular expression before. Skip.
-                    continue;
-                }
+        if (!fieldPlan.exported)
+        {
+            // Field ignored by template, or not localized while only exporting localized fields.
+            continue;
+        }
 
-                if (exportTemplate.ignoredFields.contains(fieldId))
-                {
-                    // Field ignored by template.
-                    continue;
-                }
+        const QString& fieldValueText = fieldValueTexts.at(fieldPlan.ordinal);
 
-                if (exportTemplate.exportLocalizedFieldsOnly)
-                {
-                    QVariant localized = this->facetsController.getFacetValue(fieldType, LocalizedStringFacet::FacetKey);
-                    if (!localized.isValid() || !localized.toBool())
-                    {
-                        // We only want to export localized fields, but this one is not.
-                        continue;
-                    }
-                }
+        const QString* values[ExportTemplatePlaceholder::Count] = {};
+        values[ExportTemplatePlaceholder::FieldId] = &fieldId;
+        values[ExportTemplatePlaceholder::FieldType] = &fieldPlan.exportedFieldType;
+        values[ExportTemplatePlaceholder::FieldValue] = &fieldValueText;
+        values[ExportTemplatePlaceholder::FieldComponent] = &fieldDefinition.component;
+        values[ExportTemplatePlaceholder::FieldDisplayName] = &fieldDefinition.displayName;
+        values[ExportTemplatePlaceholder::FieldDescription] = &fieldDefinition.description;
+        values[ExportTemplatePlaceholder::RecordId] = &recordId;
+        values[ExportTemplatePlaceholder::RecordParentId] = &recordParent;
+        values[ExportTemplatePlaceholder::RecordRootId] = &recordRoot;
+        values[ExportTemplatePlaceholder::RecordDisplayName] = &record.displayName;
 
-                const QString fieldValueText = fieldValueTexts[fieldId];
-                const QString exportedFieldType = exportTemplate.typeMap.value(fieldType, fieldType);
+        // Select field value template.
+        const ExportTemplateTokenList* fieldValueTemplate = &compiledTemplate.fieldValueTemplate;
 
-                // Apply field value template.
-                QString fieldValueString = exportTemplate.fieldValueTemplate;
+        switch (fieldPlan.kind)
+        {
+            case ExportFieldKind::List:
+                fieldValueTemplate = &compiledTemplate.listTemplate;
+                values[ExportTemplatePlaceholder::ItemType] = &fieldPlan.exportedItemType;
+                break;
+
+            case ExportFieldKind::Map:
+            case ExportFieldKind::Vector2:
+            case ExportFieldKind::Vector3:
+                fieldValueTemplate = &compiledTemplate.mapTemplate;
+                values[ExportTemplatePlaceholder::KeyType] = &fieldPlan.exportedKeyType;
+                values[ExportTemplatePlaceholder::ValueType] = &fieldPlan.exportedValueType;
+                break;
+
+            case ExportFieldKind::Localized:
+                fieldValueTemplate = &compiledTemplate.localizedFieldValueTemplate;
+                break;
+
+            default:
+                break;
+        }
 
-                // Check if custom type.
-                if (this->typesController.isCustomType(fieldType))
-                {
-                    const CustomType& customType = this->typesController.getCustomType(fieldType);
+        // Apply field value template.
+        fieldValueString.resize(0);
+        this->appendTemplate(fieldValueString, *fieldValueTemplate, values);
 
-                    if (customType.isList())
-                    {
-                        // Use list template.
-                        fieldValueString = exportTemplate.listTemplate;
+        // Add delimiter, if necessary.
+        if (!fieldValuesString.isEmpty() && !fieldValueString.isEmpty())
+        {
+            // Any previous field export succeeded (e.g. wasn't skipped). Add delimiter.
+            fieldValuesString.append(exportTemplate.fieldValueDelimiter);
+        }
 
-                        QString itemType = customType.getItemType();
-                        QString exportedItemType = exportTemplate.typeMap.value(itemType, itemType);
+        fieldValuesString.append(fieldValueString);
+    }
 
-                        fieldValueString = fieldValueString.replace(PlaceholderItemType, exportedItemType);
-                    }
-                    else if (customType.isMap())
-                    {
-                        // Use map template.
-                        fieldValueString = exportTemplate.mapTemplate;
+    // Collect components.
+    QStringList components;
 
-                        QString keyType = customType.getKeyType();
-                        QString valueType = customType.getValueType();
+    for (QMap<QString, QVariant>::const_iterator itFields = fieldValues.cbegin();
+         itFields != fieldValues.cend();
+         ++itFields)
+    {
+        const FieldDefinition& fieldDefinition = *this->getFieldPlan(compiledTemplate, itFields.key()).fieldDefinition;
 
-                        QString exportedKeyType = exportTemplate.typeMap.value(keyType, keyType);
-                        QString exportedValueType = exportTemplate.typeMap.value(valueType, valueType);
+        if (!fieldDefinition.component.isEmpty() && !components.contains(fieldDefinition.component))
+        {
+            components.append(fieldDefinition.component);
+        }
+    }
 
-                        fieldValueString = fieldValueString.replace(PlaceholderKeyType, exportedKeyType);
-                        fieldValueString = fieldValueString.replace(PlaceholderValueType, exportedValueType);
-                    }
-                    else if (customType.isDerivedType())
-                    {
-                        QVariant localized = this->facetsController.getFacetValue(fieldType, LocalizedStringFacet::FacetKey);
-                        if (localized.isValid() && localized.toBool())
-                        {
-                            // Use localized template.
-                            fieldValueString = exportTemplate.localizedFieldValueTemplate;
-                        }
-                    }
-                }
-                // Check if vector.
-                else if (fieldType == BuiltInType::Vector2I || fieldType == BuiltInType::Vector2R ||
-                         fieldType == BuiltInType::Vector3I || fieldType == BuiltInType::Vector3R)
-                {
-                    // Use vector template.
-                    fieldValueString = exportTemplate.mapTemplate;
+    // Build components string.
+    QString componentsString;
 
-                    QString exportedKeyType = exportTemplate.typeMap.value("String", "String");
-                    QString exportedValueType;
+    for (QStringList::iterator itComponents = components.begin();
+         itComponents != components.end();
+         ++itComponents)
+    {
+        // Apply component template.
+        const QString* values[ExportTemplatePlaceholder::Count] = {};
+        values[ExportTemplatePlaceholder::ComponentName] = &(*itComponents);
 
-                    if (fieldType == BuiltInType::Vector2I || fieldType == BuiltInType::Vector3I)
-                    {
-                        exportedValueType = exportTemplate.typeMap.value("Integer", "Integer");
-                    }
-                    else
-                    {
-                        exportedValueType = exportTemplate.typeMap.value("Real", "Real");
-                    }
+        this->appendTemplate(componentsString, compiledTemplate.componentTemplate, values);
 
-                    fieldValueString = fieldValueString.replace(PlaceholderKeyType, exportedKeyType);
-                    fieldValueString = fieldValueString.replace(PlaceholderValueType, exportedValueType);
-                }
+        // Add delimiter, if necessary.
+        if (itComponents != components.end() - 1)
+        {
+            componentsString.append(exportTemplate.componentDelimiter);
+        }
+    }
 
-                fieldValueString = fieldValueString.replace(PlaceholderFieldId, fieldId);
-                fieldValueString = fieldValueString.replace(PlaceholderFieldType, exportedFieldType);
-                fieldValueString = fieldValueString.replace(PlaceholderFieldValue, fieldValueText);
-                fieldValueString = fieldValueString.replace(PlaceholderFieldComponent, fieldComponent);
-                fieldValueString = fieldValueString.replace(PlaceholderFieldDisplayName, fieldDisplayName);
-                fieldValueString = fieldValueString.replace(PlaceholderFieldDescription, fieldDescription);
-                fieldValueString = fieldValueString.replace(PlaceholderRecordId, record.id.toString());
-                fieldValueString = fieldValueString.replace(PlaceholderRecordParentId, recordParent.toString());
-                fieldValueString = fieldValueString.replace(PlaceholderRecordRootId, recordRoot.toString());
-                fieldValueString = fieldValueString.replace(PlaceholderRecordDisplayName, record.displayName);
-
-                // Add delimiter, if necessary.
-                if (!fieldValuesString.isEmpty() && !fieldValueString.isEmpty())
-                {
-                    // Any previous field export succeeded (e.g. wasn't skipped). Add delimiter.
-                    fieldValuesString.append(exportTemplate.fieldValueDelimiter);
-                }
+    // Apply record template.
+    const QString* values[ExportTemplatePlaceholder::Count] = {};
+    values[ExportTemplatePlaceholder::RecordId] = &recordId;
+    values[ExportTemplatePlaceholder::RecordParentId] = &recordParent;
+    values[ExportTemplatePlaceholder::RecordRootId] = &recordRoot;
+    values[ExportTemplatePlaceholder::RecordFields] = &fieldValuesString;
+    values[ExportTemplatePlaceholder::Components] = &componentsString;
+    values[ExportTemplatePlaceholder::RecordDisplayName] = &record.displayName;
 
-                fieldValuesString.append(fieldValueString);
+    for (const ExportTemplateToken& token : compiledTemplate.recordTemplate)
+    {
+        if (token.placeholder == ExportTemplatePlaceholder::FieldValueById)
+        {
+            // Insert value of specific field, if it exists.
+            if (token.fieldOrdinal >= 0)
+            {
+                recordString.append(fieldValueTexts.at(token.fieldOrdinal));
             }
+        }
+        else
+        {
+            this->appendToken(recordString, token, values);
+        }
+    }
 
-            // Collect components.
-            QStringList components;
+    return true;
+}
 
-            for (QMap<QString, QVariant>::const_iterator itFields = fieldValues.cbegin();
-                 itFields != fieldValues.cend();
-                 ++itFields)
-            {
-                QString fieldId = itFields.key();
-                const FieldDefinition& fieldDefinition = this->fieldDefinitionsController.getFieldDefinition(fieldId);
+void ExportController::renderRecordFragment(const RecordExportItem& item,
+                                            const RecordExportTemplate& exportTemplate,
+                                            const CompiledRecordExportTemplate& compiledTemplate,
+                                            const RecordExportCache* previousCache,
+                                            RecordExportCacheEntry& entry) const
+{
+    if (previousCache != nullptr)
+    {
+        entry.recordId = item.record->id.toString();
+        entry.digest = this->computeRecordDigest(item);
 
-                if (!fieldDefinition.component.isEmpty() && !components.contains(fieldDefinition.component))
-                {
-                    components.append(fieldDefinition.component);
-                }
-            }
+        // Reuse previous output if the record hasn't changed.
+        QHash<QString, RecordExportCacheEntry>::const_iterator it = previousCache->entries.constFind(entry.recordId);
 
-            // Build components string.
-            QString componentsString;
+        if (it != previousCache->entries.cend() && it->digest == entry.digest)
+        {
+            entry.fragment = it->fragment;
+            return;
+        }
+    }
 
-            for (QStringList::iterator itComponents = components.begin();
-                 itComponents != components.end();
-                 ++itComponents)
-            {
-                QString& component = *itComponents;
+    // Skipped records leave an empty fragment.
+    this->renderRecord(item, exportTemplate, compiledTemplate, entry.fragment);
+}
 
-                // Apply component template.
-                QString componentString = exportTemplate.componentTemplate;
-                componentString = componentString.replace(PlaceholderComponentName, component);
+void ExportController::renderRecords(RecordExportChunk& chunk,
+                                     const RecordExportTemplate& exportTemplate,
+                                     const CompiledRecordExportTemplate& compiledTemplate,
+                                     const RecordExportCache* previousCache) const
+{
+    RecordExportCacheEntry entry;
 
-                componentsString.append(componentString);
+    try
+    {
+        for (const RecordExportItem& item : chunk.items)
+        {
+            this->renderRecordFragment(item, exportTemplate, compiledTemplate, previousCache, entry);
 
-                // Add delimiter, if necessary.
-                if (itComponents != components.end() - 1)
-                {
-                    componentsString.append(exportTemplate.componentDelimiter);
-                }
+            if (previousCache != nullptr)
+            {
+                chunk.cacheEntries.append(entry);
             }
 
-            // Replace other record placeholders.
-            recordString = recordString.replace(PlaceholderRecordId, record.id.toString());
-            recordString = recordString.replace(PlaceholderRecordParentId, recordParent.toString());
-            recordString = recordString.replace(PlaceholderRecordRootId, recordRoot.toString());
-            recordString = recordString.replace(PlaceholderRecordFields, fieldValuesString);
-            recordString = recordString.replace(PlaceholderComponents, componentsString);
-            recordString = recordString.replace(PlaceholderRecordDisplayName, record.displayName);
+            if (entry.fragment.isEmpty())
+            {
+                continue;
+            }
 
-            if (!recordsString.isEmpty() && !recordString.isEmpty())
+            if (!chunk.output.isEmpty())
             {
-                // Any previous record export succeeded (e.g. wasn't skipped). Add delimiter.
-                recordsString.append(exportTemplate.recordDelimiter);
+                chunk.output.append(exportTemplate.recordDelimiter);
             }
 
-            recordsString.append(recordString);
+            chunk.output.append(entry.fragment);
         }
     }
+    catch (const std::exception& e)
+    {
+        // Report errors to the exporting thread.
+        chunk.error = e.what();
+    }
+}
 
-    // Apply record file template.
-    QString recordFileString = exportTemplate.recordFileTemplate;
-    recordFileString = recordFileString.replace(PlaceholderRecords, recordsString);
-    recordFileString = recordFileString.replace(PlaceholderAppVersion, APP_VERSION);
-    recordFileString = recordFileString.replace(PlaceholderAppVersionName, APP_VERSION_NAME);
-    recordFileString = recordFileString.replace(PlaceholderExportTime, QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+void ExportController::saveCache(const QString& filePath, const RecordExportCache& cache) const
+{
+    QFile file(filePath);
 
-    if (recordFileString.contains(PlaceholderHash))
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
     {
-        QString hash = this->recordsController.computeRecordsHash();
-        recordFileString = recordFileString.replace(PlaceholderHash, hash);
+        // Cache is optional - just render all records again next time.
+        qWarning(qUtf8Printable(QString("Record export cache %1 could not be written.").arg(filePath)));
+        return;
     }
 
-    // Write record file.
-    QTextStream textStream(&device);
-    textStream.setCodec("UTF-8");
-    textStream << recordFileString;
-
-    // Report finish.
-    emit this->progressChanged(tr("Exporting Data"), QString(), 1, 1);
+    RecordExportCacheSerializer serializer;
+    serializer.serialize(file, cache);
 }
 
-bool ExportController::removeExportTemplate(const QString& name)
+void ExportController::saveHash(const QString& filePath, const QByteArray& hash) const
 {
-    qInfo(qUtf8Printable(QString("Removing export template %1.").arg(name)));
+    QFile file(filePath);
 
-    // Update model.
-    for (RecordExportTemplateList::iterator it = this->model->begin();
-         it != this->model->end();
-         ++it)
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(hash + "\n") < 0)
     {
-        if (it->name == name)
+        qWarning(qUtf8Printable(QString("Record export hash %1 could not be written.").arg(filePath)));
+    }
+}
+
+QVector<RecordExportItem> ExportController::selectRecords(const RecordExportTemplate& exportTemplate,
+                                                          const RecordExportData& data) const
+{
+    const int recordCount = data.records.size();
+
+    const QSet<QString> includedRecords = QSet<QString>::fromList(exportTemplate.includedRecords);
+    const QSet<QString> ignoredRecords = QSet<QString>::fromList(exportTemplate.ignoredRecords);
+
+    // Propagate flags from ancestors to descendants.
+    QVector<bool> whitelisted(recordCount, false);
+    QVector<bool> ignored(recordCount, false);
+
+    if (!includedRecords.isEmpty() || !ignoredRecords.isEmpty())
+    {
+        for (const int index : data.hierarchyOrder)
         {
-            this->model->erase(it);
+            const int parentIndex = data.parents[index];
+            const QString id = data.records[index]->id.toString();
 
-            // Notify listeners.
-            emit this->exportTemplatesChanged();
-            return true;
+            whitelisted[index] = (parentIndex >= 0 && whitelisted[parentIndex]) || includedRecords.contains(id);
+            ignored[index] = (parentIndex >= 0 && ignored[parentIndex]) || ignoredRecords.contains(id);
         }
     }
 
-    return false;
+    // Select records, keeping their original order.
+    QVector<RecordExportItem> items;
+
+    for (int i = 0; i < recordCount; ++i)
+    {
+        const Record* record = data.records[i];
+
+        if (data.roots[i] < 0)
+        {
+            // Not reachable from any root, i.e. part of a parent cycle.
+            continue;
+        }
+
+        // Check if should export.
+        if (record->parentId.isNull())
+        {
+            // Root node.
+            if (!exportTemplate.exportRoots)
+            {
+                continue;
+            }
+        }
+        else if (data.children[i].isEmpty())
+        {
+            // Leaf node.
+            if (!exportTemplate.exportLeafs)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            // Inner node.
+            if (!exportTemplate.exportInnerNodes)
+            {
+                continue;
+            }
+        }
+
+        // Check if whitelisted.
+        if (!includedRecords.isEmpty() && !whitelisted[i])
+        {
+            continue;
+        }
+
+        // Check if record or any ancestor ignored.
+        if (ignored[i])
+        {
+            continue;
+        }
+
+        RecordExportItem item;
+        item.record = record;
+        item.fieldValues = &data.fieldValues[i];
+        item.rootId = data.records[data.roots[i]]->id.toString();
+
+        if (data.parents[i] >= 0 && data.hasFieldValues[data.parents[i]])
+        {
+            // Only export record parent if that parent isn't empty.
+            item.parentId = record->parentId.toString();
+        }
+
+        items.append(item);
+    }
+
+    return items;
 }
 
 void ExportController::setRecordExportTemplates(RecordExportTemplateList& exportTemplates)
 {
     this->model = &exportTemplates;
+    this->templateFileCache.clear();
+}
+
+QVector<ExportController::RecordExportSplit> ExportController::splitRecords(const QString& filePath,
+                                                                           const RecordExportTemplate& exportTemplate,
+                                                                           const CompiledRecordExportTemplate& compiledTemplate,
+                                                                           const RecordExportData& data) const
+{
+    const QVector<RecordExportItem> items = this->selectRecords(exportTemplate, data);
+    QVector<RecordExportSplit> splits;
+
+    if (exportTemplate.splitMode == RecordExportSplitMode::Component)
+    {
+        // Group fields by component, in the order of their first appearance.
+        QStringList components;
+        QHash<QString, QSet<QString>> componentFieldIds;
+
+        const FieldDefinitionSetList& fieldDefinitionSets = this->fieldDefinitionsController.getFieldDefinitionSets();
+
+        for (int i = 0; i < fieldDefinitionSets.size(); ++i)
+        {
+            const FieldDefinitionSet& fieldDefinitionSet = fieldDefinitionSets.at(i);
+
+            for (int j = 0; j < fieldDefinitionSet.fieldDefinitions.size(); ++j)
+            {
+                const FieldDefinition& fieldDefinition = fieldDefinitionSet.fieldDefinitions.at(j);
+
+                if (!componentFieldIds.contains(fieldDefinition.component))
+                {
+                    components << fieldDefinition.component;
+                }
+
+                componentFieldIds[fieldDefinition.component].insert(fieldDefinition.id);
+            }
+        }
+
+        // Export each record with the fields of each of its components. Fields without component form a split on their own.
+        for (const QString& component : components)
+        {
+            const QSet<QString>& fieldIds = componentFieldIds[component];
+
+            RecordExportSplit split;
+            split.key = component;
+            split.compiledTemplate = compiledTemplate;
+
+            // Restrict field plans to the component, e.g. for exporting as table.
+            for (QHash<QString, ExportFieldPlan>::const_iterator it = compiledTemplate.fieldPlans.cbegin();
+                 it != compiledTemplate.fieldPlans.cend();
+                 ++it)
+            {
+                if (!fieldIds.contains(it.key()))
+                {
+                    split.compiledTemplate.fieldPlans.remove(it.key());
+                }
+            }
+
+            for (const RecordExportItem& item : items)
+            {
+                RecordFieldValueMap fieldValues;
+
+                for (RecordFieldValueMap::const_iterator it = item.fieldValues->cbegin();
+                     it != item.fieldValues->cend();
+                     ++it)
+                {
+                    if (fieldIds.contains(it.key()))
+                    {
+                        fieldValues.insert(it.key(), it.value());
+                    }
+                }
+
+                if (fieldValues.isEmpty())
+                {
+                    continue;
+                }
+
+                split.items.append(item);
+                split.fieldValues.append(fieldValues);
+            }
+
+            if (!split.items.isEmpty())
+            {
+                splits.append(split);
+            }
+        }
+    }
+    else
+    {
+        QHash<QString, int> splitIndices;
+
+        for (const RecordExportItem& item : items)
+        {
+            const QString key = exportTemplate.splitMode == RecordExportSplitMode::RecordSet
+                    ? item.record->recordSetName
+                    : item.rootId;
+
+            int splitIndex = splitIndices.value(key, -1);
+
+            if (splitIndex < 0)
+            {
+                RecordExportSplit split;
+                split.key = key;
+                split.compiledTemplate = compiledTemplate;
+
+                splitIndex = splits.size();
+                splitIndices.insert(key, splitIndex);
+                splits.append(split);
+            }
+
+            splits[splitIndex].items.append(item);
+        }
+    }
+
+    // Name files after their splits. The split without key is written to the original file.
+    QString basePath = filePath;
+
+    if (!exportTemplate.fileExtension.isEmpty() && basePath.endsWith(exportTemplate.fileExtension))
+    {
+        basePath.chop(exportTemplate.fileExtension.size());
+    }
+
+    QSet<QString> filePaths;
+
+    for (RecordExportSplit& split : splits)
+    {
+        QString fileName = split.key;
+
+        for (QChar& c : fileName)
+        {
+            if (!c.isLetterOrNumber() && c != '-' && c != '_')
+            {
+                c = '_';
+            }
+        }
+
+        QString splitFilePath = split.key.isEmpty()
+                ? filePath
+                : basePath + "_" + fileName + exportTemplate.fileExtension;
+
+        for (int i = 2; filePaths.contains(splitFilePath); ++i)
+        {
+            splitFilePath = basePath + "_" + fileName + "_" + QString::number(i) + exportTemplate.fileExtension;
+        }
+
+        filePaths.insert(splitFilePath);
+        split.filePath = splitFilePath;
+
+        // Point items to their restricted field values, now that these won't be moved anymore.
+        for (int i = 0; i < split.fieldValues.size(); ++i)
+        {
+            split.items[i].fieldValues = &split.fieldValues[i];
+        }
+    }
+
+    return splits;
+}
+
+void ExportController::appendTemplate(QString& output,
+                                      const ExportTemplateTokenList& tokens,
+                                      const QString* const* values) const
+{
+    for (const ExportTemplateToken& token : tokens)
+    {
+        this->appendToken(output, token, values);
+    }
+}
+
+void ExportController::appendToken(QString& output,
+                                   const ExportTemplateToken& token,
+                                   const QString* const* values) const
+{
+    const QString* value = values[token.placeholder];
+
+    if (token.placeholder != ExportTemplatePlaceholder::None && value)
+    {
+        output.append(*value);
+    }
+    else
+    {
+        // Literal text, or placeholder not available in this template.
+        output.append(token.text);
+    }
+}
+
+QHash<QString, ExportFieldPlan> ExportController::buildFieldPlans(const RecordExportTemplate& exportTemplate) const
+{
+    QHash<QString, ExportFieldPlan> fieldPlans;
+
+    const FieldDefinitionSetList& fieldDefinitionSets = this->fieldDefinitionsController.getFieldDefinitionSets();
+
+    for (int i = 0; i < fieldDefinitionSets.size(); ++i)
+    {
+        const FieldDefinitionSet& fieldDefinitionSet = fieldDefinitionSets.at(i);
+
+        for (int j = 0; j < fieldDefinitionSet.fieldDefinitions.size(); ++j)
+        {
+            const FieldDefinition& fieldDefinition = fieldDefinitionSet.fieldDefinitions.at(j);
+            const QString& fieldType = fieldDefinition.fieldType;
+
+            ExportFieldPlan fieldPlan;
+            fieldPlan.fieldDefinition = &fieldDefinition;
+            fieldPlan.ordinal = fieldPlans.contains(fieldDefinition.id)
+                    ? fieldPlans[fieldDefinition.id].ordinal
+                    : fieldPlans.size();
+            fieldPlan.exportedFieldType = exportTemplate.typeMap.value(fieldType, fieldType);
+
+            // Check if localized.
+            const QVariant localizedFacetValue =
+                    this->facetsController.getFacetValue(fieldType, LocalizedStringFacet::FacetKey);
+            const bool localized = localizedFacetValue.isValid() && localizedFacetValue.toBool();
+
+            // Resolve kind.
+            if (this->typesController.isCustomType(fieldType))
+            {
+                const CustomType& customType = this->typesController.getCustomType(fieldType);
+
+                if (customType.isList())
+                {
+                    const QString itemType = customType.getItemType();
+
+                    fieldPlan.kind = ExportFieldKind::List;
+                    fieldPlan.exportedItemType = exportTemplate.typeMap.value(itemType, itemType);
+                }
+                else if (customType.isMap())
+                {
+                    const QString keyType = customType.getKeyType();
+                    const QString valueType = customType.getValueType();
+
+                    fieldPlan.kind = ExportFieldKind::Map;
+                    fieldPlan.exportedKeyType = exportTemplate.typeMap.value(keyType, keyType);
+                    fieldPlan.exportedValueType = exportTemplate.typeMap.value(valueType, valueType);
+                }
+                else if (customType.isDerivedType() && localized)
+                {
+                    fieldPlan.kind = ExportFieldKind::Localized;
+                }
+            }
+            else if (fieldType == BuiltInType::Vector2I || fieldType == BuiltInType::Vector2R ||
+                     fieldType == BuiltInType::Vector3I || fieldType == BuiltInType::Vector3R)
+            {
+                fieldPlan.kind = (fieldType == BuiltInType::Vector2I || fieldType == BuiltInType::Vector2R)
+                        ? ExportFieldKind::Vector2
+                        : ExportFieldKind::Vector3;
+                fieldPlan.exportedKeyType = exportTemplate.typeMap.value("String", "String");
+
+                if (fieldType == BuiltInType::Vector2I || fieldType == BuiltInType::Vector3I)
+                {
+                    fieldPlan.exportedValueType = exportTemplate.typeMap.value("Integer", "Integer");
+                }
+                else
+                {
+                    fieldPlan.exportedValueType = exportTemplate.typeMap.value("Real", "Real");
+                }
+            }
+
+            // Check if exported.
+            fieldPlan.exported = !exportTemplate.ignoredFields.contains(fieldDefinition.id) &&
+                    (!exportTemplate.exportLocalizedFieldsOnly || localized);
+
+            fieldPlans.insert(fieldDefinition.id, fieldPlan);
+        }
+    }
+
+    return fieldPlans;
+}
+
+CompiledRecordExportTemplate ExportController::compileTemplate(const RecordExportTemplate& exportTemplate) const
+{
+    ExportTemplateCompiler compiler;
+    CompiledRecordExportTemplate compiledTemplate = compiler.compile(exportTemplate);
+    compiledTemplate.fieldPlans = this->buildFieldPlans(exportTemplate);
+
+    // Resolve fields that are explicitly placed by the record template, so they can be omitted from the field list.
+    compiledTemplate.recordTemplateFields.resize(compiledTemplate.fieldPlans.size());
+
+    for (ExportTemplateToken& token : compiledTemplate.recordTemplate)
+    {
+        if (token.placeholder != ExportTemplatePlaceholder::FieldValueById)
+        {
+            continue;
+        }
+
+        QHash<QString, ExportFieldPlan>::const_iterator it = compiledTemplate.fieldPlans.constFind(token.fieldId);
+
+        if (it != compiledTemplate.fieldPlans.cend())
+        {
+            token.fieldOrdinal = it->ordinal;
+            compiledTemplate.recordTemplateFields.setBit(it->ordinal);
+        }
+    }
+
+    return compiledTemplate;
+}
+
+QByteArray ExportController::computeRecordDigest(const RecordExportItem& item) const
+{
+    QByteArray buffer;
+    QDataStream stream(&buffer, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Hash everything the record output is rendered from, including its ancestry.
+    stream << item.record->id.toString()
+           << item.record->displayName
+           << item.parentId
+           << item.rootId
+           << *item.fieldValues;
+
+    return QCryptographicHash::hash(buffer, QCryptographicHash::Sha1);
+}
+
+QByteArray ExportController::computeTemplateDigest(const RecordExportTemplate& exportTemplate,
+                                                   const CompiledRecordExportTemplate& compiledTemplate) const
+{
+    QByteArray buffer;
+    QDataStream stream(&buffer, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Hash all templates applied to single records.
+    stream << APP_VERSION
+           << exportTemplate.componentDelimiter
+           << exportTemplate.componentTemplate
+           << exportTemplate.exportAsTable
+           << exportTemplate.fieldValueDelimiter
+           << exportTemplate.fieldValueTemplate
+           << exportTemplate.listTemplate
+           << exportTemplate.listItemTemplate
+           << exportTemplate.listItemDelimiter
+           << exportTemplate.localizedFieldValueTemplate
+           << exportTemplate.mapTemplate
+           << exportTemplate.mapItemTemplate
+           << exportTemplate.mapItemDelimiter
+           << exportTemplate.recordTemplate
+           << exportTemplate.stringReplacementMap;
+
+    // Hash resolved field metadata, which reflects field definitions, custom types and the type map.
+    QStringList fieldIds = compiledTemplate.fieldPlans.keys();
+    fieldIds.sort();
+
+    for (const QString& fieldId : fieldIds)
+    {
+        const ExportFieldPlan& fieldPlan = compiledTemplate.fieldPlans[fieldId];
+        const FieldDefinition& fieldDefinition = *fieldPlan.fieldDefinition;
+
+        stream << fieldId
+               << static_cast<qint32>(fieldPlan.kind)
+               << fieldPlan.exported
+               << fieldPlan.exportedFieldType
+               << fieldPlan.exportedItemType
+               << fieldPlan.exportedKeyType
+               << fieldPlan.exportedValueType
+               << fieldDefinition.component
+               << fieldDefinition.description
+               << fieldDefinition.displayName;
+    }
+
+    return QCryptographicHash::hash(buffer, QCryptographicHash::Sha1);
+}
+
+const ExportFieldPlan& ExportController::getFieldPlan(const CompiledRecordExportTemplate& compiledTemplate,
+                                                      const QString& fieldId) const
+{
+    QHash<QString, ExportFieldPlan>::const_iterator it = compiledTemplate.fieldPlans.constFind(fieldId);
+
+    if (it == compiledTemplate.fieldPlans.cend())
+    {
+        const QString errorMessage = "Field not found: " + fieldId;
+        qCritical(qUtf8Printable(errorMessage));
+        throw std::out_of_range(errorMessage.toStdString());
+    }
+
+    return it.value();
+}
+
+RecordExportCache ExportController::loadCache(const QString& filePath, const QByteArray& templateDigest) const
+{
+    RecordExportCache cache;
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        // No previous export.
+        return cache;
+    }
+
+    try
+    {
+        RecordExportCacheSerializer serializer;
+        serializer.deserialize(file, cache);
+    }
+    catch (const std::runtime_error& e)
+    {
+        qWarning(qUtf8Printable(QString("Ignoring record export cache %1: %2").arg(filePath, e.what())));
+        return RecordExportCache();
+    }
+
+    if (cache.templateDigest != templateDigest)
+    {
+        // Template or field definitions have changed - all records have to be rendered again.
+        qInfo(qUtf8Printable(QString("Record export cache %1 is outdated.").arg(filePath)));
+        return RecordExportCache();
+    }
+
+    qInfo(qUtf8Printable(QString("Loaded %1 records from record export cache %2.")
+                         .arg(QString::number(cache.entries.size()), filePath)));
+    return cache;
+}
+
+void ExportController::loadTemplateContents(RecordExportTemplate& exportTemplate) const
+{
+    if (exportTemplate.fullTemplateFilesPath.isEmpty())
+    {
+        // Template contents have been provided directly.
+        return;
+    }
+
+    const QString& templatePath = exportTemplate.fullTemplateFilesPath;
+
+    try
+    {
+        exportTemplate.fieldValueDelimiter =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportFieldValueDelimiterExtension);
+        exportTemplate.fieldValueTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportFieldValueTemplateExtension);
+        exportTemplate.recordDelimiter =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportRecordDelimiterExtension);
+        exportTemplate.recordFileTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportRecordFileTemplateExtension);
+        exportTemplate.recordTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportRecordTemplateExtension);
+        exportTemplate.componentDelimiter =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportComponentDelimiterExtension);
+        exportTemplate.componentTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportComponentTemplateExtension);
+        exportTemplate.listTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportListTemplateExtension);
+        exportTemplate.listItemTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportListItemTemplateExtension);
+        exportTemplate.listItemDelimiter =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportListItemDelimiterExtension);
+        exportTemplate.mapTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportMapTemplateExtension);
+        exportTemplate.mapItemTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportMapItemTemplateExtension);
+        exportTemplate.mapItemDelimiter =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportMapItemDelimiterExtension);
+        exportTemplate.localizedFieldValueTemplate =
+                this->readTemplateFile(templatePath + ProjectController::RecordExportLocalizedFieldValueTemplateExtension);
+    }
+    catch (const std::runtime_error& e)
+    {
+        QString errorMessage = QObject::tr("Export template %1 is missing a required file: %2")
+                .arg(exportTemplate.name, e.what());
+        qCritical(qUtf8Printable(errorMessage));
+    }
+}
+
+QString ExportController::readTemplateFile(const QString& fullPath) const
+{
+    QFileInfo fileInfo(fullPath);
+
+    // Check if cached contents are still up-to-date.
+    QMap<QString, TemplateFileCacheEntry>::const_iterator it = this->templateFileCache.constFind(fullPath);
+
+    if (it != this->templateFileCache.cend() &&
+            it->lastModified == fileInfo.lastModified() &&
+            it->size == fileInfo.size())
+    {
+        return it->contents;
+    }
+
+    // Read file.
+    QFile file(fullPath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        throw std::runtime_error(fullPath.toStdString());
+    }
+
+    qInfo(qUtf8Printable(QString("Reading export template file %1.").arg(fullPath)));
+
+    QTextStream textStream(&file);
+
+    TemplateFileCacheEntry entry;
+    entry.contents = textStream.readAll();
+    entry.lastModified = fileInfo.lastModified();
+    entry.size = fileInfo.size();
+
+    this->templateFileCache[fullPath] = entry;
+    return entry.contents;
+}
+
+bool ExportController::requiresHash(const CompiledRecordExportTemplate& compiledTemplate) const
+{
+    for (const ExportTemplateToken& token : compiledTemplate.recordFileTemplate)
+    {
+        if (token.placeholder == ExportTemplatePlaceholder::Hash)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+RecordExportData ExportController::resolveRecords(bool computeHash) const
+{
+    RecordExportData data;
+
+    const RecordSetList& recordSets = this->recordsController.getRecordSets();
+
+    // Index records and their children.
+    QHash<QString, int> recordIndices;
+
+    for (int i = 0; i < recordSets.size(); ++i)
+    {
+        const RecordSet& recordSet = recordSets.at(i);
+
+        for (int j = 0; j < recordSet.records.size(); ++j)
+        {
+            const Record& record = recordSet.records.at(j);
+            recordIndices.insert(record.id.toString(), data.records.size());
+            data.records.append(&record);
+        }
+    }
+
+    const int recordCount = data.records.size();
+
+    data.children.resize(recordCount);
+    data.parents = QVector<int>(recordCount, -1);
+
+    for (int i = 0; i < recordCount; ++i)
+    {
+        const Record* record = data.records[i];
+
+        if (!record->parentId.isNull())
+        {
+            const int parentIndex = recordIndices.value(record->parentId.toString(), -1);
+
+            if (parentIndex >= 0)
+            {
+                data.parents[i] = parentIndex;
+                data.children[parentIndex].append(i);
+            }
+        }
+    }
+
+    // Resolve roots and inherited field values in a single depth-first traversal.
+    data.fieldValues.resize(recordCount);
+    data.hasFieldValues = QVector<bool>(recordCount, false);
+    data.roots = QVector<int>(recordCount, -1);
+    data.hierarchyOrder.reserve(recordCount);
+
+    QVector<int> stack;
+
+    for (int i = 0; i < recordCount; ++i)
+    {
+        if (data.parents[i] < 0)
+        {
+            stack.append(i);
+        }
+    }
+
+    while (!stack.isEmpty())
+    {
+        const int index = stack.takeLast();
+        const int parentIndex = data.parents[index];
+        const Record* record = data.records[index];
+
+        data.hierarchyOrder.append(index);
+
+        if (parentIndex < 0)
+        {
+            data.roots[index] = index;
+            data.hasFieldValues[index] = !record->fieldValues.isEmpty();
+            data.fieldValues[index] = record->fieldValues;
+        }
+        else
+        {
+            data.roots[index] = data.roots[parentIndex];
+            data.hasFieldValues[index] = data.hasFieldValues[parentIndex] || !record->fieldValues.isEmpty();
+
+            // Override inherited values. Records without own values share the map of their parent.
+            RecordFieldValueMap& fieldValues = data.fieldValues[index];
+            fieldValues = data.fieldValues[parentIndex];
+
+            for (RecordFieldValueMap::const_iterator it = record->fieldValues.cbegin();
+                 it != record->fieldValues.cend();
+                 ++it)
+            {
+                fieldValues[it.key()] = it.value();
+            }
+        }
+
+        stack << data.children[index];
+    }
+
+    if (computeHash)
+    {
+        data.hash = this->recordsController.computeRecordsHash();
+    }
+
+    return data;
+}
+
+QByteArray ExportController::writeRecordFile(QIODevice& device,
+                                             const RecordExportTemplate& exportTemplate,
+                                             const CompiledRecordExportTemplate& compiledTemplate,
+                                             const RecordExportData& data,
+                                             const QVector<RecordExportItem>& items,
+                                             const RecordExportCache* previousCache,
+                                             RecordExportCache* cache,
+                                             const RecordExportOptions& options,
+                                             bool hashOutput,
+                                             bool reportProgress) const
+{
+    qInfo(qUtf8Printable(QString("Exporting records with template %1.").arg(exportTemplate.name)));
+
+    // Hash output while writing it, if requested.
+    const bool hashing = options.streamingHash || hashOutput;
+    const qint64 startPosition = device.pos();
+
+    HashingDevice hashingDevice(device);
+    QIODevice* outputDevice = &device;
+
+    if (hashing)
+    {
+        hashingDevice.open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+        outputDevice = &hashingDevice;
+    }
+
+    // Prepare record file template values.
+    // Streamed hashes are not known before the end of the file, so we write a placeholder and patch it afterwards.
+    const QString appVersion = APP_VERSION;
+    const QString appVersionName = APP_VERSION_NAME;
+    const QString exportTime = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    const QString hashPlaceholder(StreamingHashLength, QChar('0'));
+
+    const QString* values[ExportTemplatePlaceholder::Count] = {};
+    values[ExportTemplatePlaceholder::AppVersion] = &appVersion;
+    values[ExportTemplatePlaceholder::AppVersionName] = &appVersionName;
+    values[ExportTemplatePlaceholder::ExportTime] = &exportTime;
+    values[ExportTemplatePlaceholder::Hash] = options.streamingHash ? &hashPlaceholder : &data.hash;
+
+    // Write record file, streaming all records in place of their placeholder.
+    QTextStream textStream(outputDevice);
+    textStream.setCodec("UTF-8");
+
+    QString tokenString;
+    QVector<qint64> hashOffsets;
+
+    for (const ExportTemplateToken& token : compiledTemplate.recordFileTemplate)
+    {
+        if (token.placeholder == ExportTemplatePlaceholder::Records)
+        {
+            if (options.parallel)
+            {
+                this->writeRecordsParallel(textStream, exportTemplate, compiledTemplate, items, previousCache, cache,
+                                           reportProgress);
+            }
+            else
+            {
+                this->writeRecords(textStream, exportTemplate, compiledTemplate, items, previousCache, cache,
+                                   reportProgress);
+            }
+        }
+        else
+        {
+            if (options.streamingHash && token.placeholder == ExportTemplatePlaceholder::Hash)
+            {
+                // Remember where to patch the hash.
+                textStream.flush();
+                hashOffsets.append(hashingDevice.getBytesWritten());
+            }
+
+            tokenString.resize(0);
+            this->appendToken(tokenString, token, values);
+            textStream << tokenString;
+        }
+    }
+
+    textStream.flush();
+
+    if (!hashing)
+    {
+        // Report finish.
+        if (reportProgress)
+        {
+            emit this->progressChanged(tr("Exporting Data"), QString(), 1, 1);
+        }
+
+        return QByteArray();
+    }
+
+    const QByteArray hash = hashingDevice.getHash().toHex();
+    hashingDevice.close();
+
+    // Patch streamed hash into the output.
+    if (!hashOffsets.isEmpty())
+    {
+        if (device.isSequential())
+        {
+            qWarning(qUtf8Printable(QString("Hash placeholders of template %1 could not be replaced in sequential output.")
+                                    .arg(exportTemplate.name)));
+        }
+        else
+        {
+            const qint64 endPosition = device.pos();
+
+            for (qint64 offset : hashOffsets)
+            {
+                device.seek(startPosition + offset);
+                device.write(hash);
+            }
+
+            device.seek(endPosition);
+        }
+    }
+
+    // Report finish.
+    if (reportProgress)
+    {
+        emit this->progressChanged(tr("Exporting Data"), QString(), 1, 1);
+    }
+
+    return hash;
+}
+
+void ExportController::writeRecords(QTextStream& textStream,
+                                    const RecordExportTemplate& exportTemplate,
+                                    const CompiledRecordExportTemplate& compiledTemplate,
+                                    const QVector<RecordExportItem>& items,
+                                    const RecordExportCache* previousCache,
+                                    RecordExportCache* cache,
+                                    bool reportProgress) const
+{
+    // Reuse record buffer to avoid reallocations.
+    RecordExportCacheEntry entry;
+    bool anyRecordWritten = false;
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        const RecordExportItem& item = items[i];
+
+        // Report progress.
+        if (reportProgress)
+        {
+            emit this->progressChanged(tr("Exporting Data"), item.record->displayName, i, items.size());
+        }
+
+        this->renderRecordFragment(item, exportTemplate, compiledTemplate, previousCache, entry);
+
+        if (cache != nullptr)
+        {
+            cache->entries.insert(entry.recordId, entry);
+        }
+
+        if (entry.fragment.isEmpty())
+        {
+            continue;
+        }
+
+        if (anyRecordWritten)
+        {
+            // Any previous record export succeeded (e.g. wasn't skipped). Add delimiter.
+            textStream << exportTemplate.recordDelimiter;
+        }
+
+        textStream << entry.fragment;
+        anyRecordWritten = true;
+    }
+}
+
+void ExportController::writeRecordsParallel(QTextStream& textStream,
+                                            const RecordExportTemplate& exportTemplate,
+                                            const CompiledRecordExportTemplate& compiledTemplate,
+                                            const QVector<RecordExportItem>& items,
+                                            const RecordExportCache* previousCache,
+                                            RecordExportCache* cache,
+                                            bool reportProgress) const
+{
+    const int recordCount = items.size();
+
+    // Split records into chunks, keeping their order.
+    QVector<RecordExportChunk> chunks;
+
+    for (int i = 0; i < recordCount; i += ParallelExportChunkSize)
+    {
+        RecordExportChunk chunk;
+        chunk.items = items.mid(i, ParallelExportChunkSize);
+        chunks.append(chunk);
+    }
+
+    // Render a limited number of chunks at a time, to keep memory usage bounded.
+    const int chunksPerBatch = qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 4);
+    int recordsWritten = 0;
+    bool anyRecordWritten = false;
+
+    for (int batchStart = 0; batchStart < chunks.size(); batchStart += chunksPerBatch)
+    {
+        const int batchEnd = qMin(batchStart + chunksPerBatch, chunks.size());
+
+        // Render batch.
+        QtConcurrent::blockingMap(chunks.begin() + batchStart, chunks.begin() + batchEnd,
+                                  [this, &exportTemplate, &compiledTemplate, previousCache](RecordExportChunk& chunk)
+        {
+            this->renderRecords(chunk, exportTemplate, compiledTemplate, previousCache);
+        });
+
+        // Write batch in original order.
+        for (int i = batchStart; i < batchEnd; ++i)
+        {
+            RecordExportChunk& chunk = chunks[i];
+
+            if (!chunk.error.isEmpty())
+            {
+                qCritical(qUtf8Printable(chunk.error));
+                throw std::runtime_error(chunk.error.toStdString());
+            }
+
+            if (!chunk.output.isEmpty())
+            {
+                if (anyRecordWritten)
+                {
+                    // Any previous record export succeeded (e.g. wasn't skipped). Add delimiter.
+                    textStream << exportTemplate.recordDelimiter;
+                }
+
+                textStream << chunk.output;
+                anyRecordWritten = true;
+            }
+
+            if (cache != nullptr)
+            {
+                for (const RecordExportCacheEntry& entry : chunk.cacheEntries)
+                {
+                    cache->entries.insert(entry.recordId, entry);
+                }
+            }
+
+            recordsWritten += chunk.items.size();
+
+            // Free memory early.
+            chunk.output = QString();
+            chunk.cacheEntries.clear();
+        }
+
+        // Report progress.
+        if (reportProgress)
+        {
+            emit this->progressChanged(tr("Exporting Data"), QString(), recordsWritten, recordCount);
+        }
+    }
+}
+
+void ExportController::writeSplitRecordFiles(const QString& filePath,
+                                             const RecordExportTemplate& exportTemplate,
+                                             const CompiledRecordExportTemplate& compiledTemplate,
+                                             const RecordExportData& data,
+                                             const RecordExportOptions& options) const
+{
+    QVector<RecordExportSplit> splits = this->splitRecords(filePath, exportTemplate, compiledTemplate, data);
+
+    qInfo(qUtf8Printable(QString("Exporting records with template %1 to %2 files split by %3.")
+                         .arg(exportTemplate.name,
+                              QString::number(splits.size()),
+                              RecordExportSplitMode::toString(exportTemplate.splitMode))));
+
+    // Write files concurrently, rendering the records of each file sequentially.
+    // Workers don't report progress themselves, as signals must not be emitted from pooled threads.
+    RecordExportOptions splitOptions = options;
+    splitOptions.parallel = false;
+
+    QSemaphore filesWritten;
+
+    QFuture<void> future = QtConcurrent::map(splits,
+                                             [this, &exportTemplate, &data, &splitOptions, &filesWritten]
+                                             (RecordExportSplit& split)
+    {
+        try
+        {
+            const QString outputFilePath =
+                    split.filePath + RecordExportCompression::getFileExtension(splitOptions.compression);
+            QFile file(outputFilePath);
+
+            if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+            {
+                const QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + outputFilePath;
+                throw std::runtime_error(errorMessage.toStdString());
+            }
+
+            // Compress output while writing it, if requested.
+            // The manifest lists the hashes of the files as written, so compressed output is hashed after compression.
+            const bool compressed = splitOptions.compression == RecordExportCompression::Gzip;
+
+            HashingDevice hashingDevice(file);
+            GzipDevice gzipDevice(hashingDevice);
+            QIODevice* device = &file;
+
+            if (compressed)
+            {
+                hashingDevice.open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+
+                if (!gzipDevice.open(QIODevice::WriteOnly))
+                {
+                    throw std::runtime_error(gzipDevice.errorString().toStdString());
+                }
+
+                device = &gzipDevice;
+            }
+
+            const QByteArray hash = this->writeRecordFile(*device, exportTemplate, split.compiledTemplate, data,
+                                                          split.items, nullptr, nullptr, splitOptions, !compressed,
+                                                          false);
+
+            if (compressed)
+            {
+                if (!gzipDevice.finish())
+                {
+                    throw std::runtime_error(gzipDevice.errorString().toStdString());
+                }
+
+                split.hash = hashingDevice.getHash().toHex();
+            }
+            else
+            {
+                split.hash = hash;
+            }
+
+            split.filePath = outputFilePath;
+        }
+        catch (const std::exception& e)
+        {
+            // Report errors to the exporting thread.
+            split.error = e.what();
+        }
+
+        filesWritten.release();
+    });
+
+    // Report one progress step per finished file.
+    for (int i = 0; i < splits.size(); ++i)
+    {
+        filesWritten.acquire();
+        emit this->progressChanged(tr("Exporting Data"), QString(), i + 1, splits.size());
+    }
+
+    future.waitForFinished();
+
+    // Write manifest.
+    const QDir directory = QFileInfo(filePath).absoluteDir();
+    QJsonArray files;
+
+    for (const RecordExportSplit& split : splits)
+    {
+        if (!split.error.isEmpty())
+        {
+            qCritical(qUtf8Printable(split.error));
+            throw std::runtime_error(split.error.toStdString());
+        }
+
+        QJsonObject file;
+        file["key"] = split.key;
+        file["path"] = directory.relativeFilePath(split.filePath);
+        file["records"] = split.items.size();
+        file["sha1"] = QString::fromLatin1(split.hash);
+        files.append(file);
+    }
+
+    QJsonObject manifest;
+    manifest["template"] = exportTemplate.name;
+    manifest["splitMode"] = RecordExportSplitMode::toString(exportTemplate.splitMode);
+    manifest["files"] = files;
+
+    const QString manifestFilePath = filePath + ManifestFileExtension;
+    QFile manifestFile(manifestFilePath);
+
+    if (!manifestFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            manifestFile.write(QJsonDocument(manifest).toJson()) < 0)
+    {
+        QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + manifestFilePath;
+        qCritical(qUtf8Printable(errorMessage));
+        throw std::runtime_error(errorMessage.toStdString());
+    }
 }
@@ -1,9 +1,20 @@
 #ifndef EXPORTCONTROLLER_H
 #define EXPORTCONTROLLER_H
 
+#include <QDateTime>
 #include <QIODevice>
+#include <QMap>
 #include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
 
+#include "../Model/compiledrecordexporttemplate.h"
+#include "../Model/exporttemplatetokenlist.h"
+#include "../Model/recordexportcache.h"
+#include "../Model/recordexportdata.h"
+#include "../Model/recordexportitem.h"
+#include "../Model/recordexportoptions.h"
 #include "../Model/recordexporttemplatelist.h"
 #include "../Model/recordexporttemplatemap.h"
 
@@ -41,7 +52,9 @@ namespace Tome
             void addRecordExportTemplate(const RecordExportTemplate& exportTemplate);
 
             /**
-             * @brief Gets the record export template with the specified name.
+             * @brief Gets the record export template with the specified name, including its template contents.
+             *
+             * Template contents are read from disk on first use, and re-read only if the respective files have changed since.
              *
              * @exception std::out_of_range if the export template could not be found.
              *
@@ -72,15 +85,98 @@ namespace Tome
              *
              * @param exportTemplate Template to apply when exporting the records.
              * @param filePath Path of the file to write the exported data to.
+             * @param options Options for this export.
              */
-            void exportRecords(const RecordExportTemplate& exportTemplate, const QString& filePath) const;
+            void exportRecords(const RecordExportTemplate& exportTemplate,
+                               const QString& filePath,
+                               const RecordExportOptions& options = RecordExportOptions()) const;
 
             /**
              * @brief Exports all records using the passed export template to the specified device.
+             *
+             * Records are rendered one by one and streamed to the device through a buffered UTF-8 writer,
+             * so memory usage doesn't grow with the size of the export. For parallel exports, records are
+             * rendered in chunks on the global thread pool, and written in their original order.
+             *
+             * The split mode of the template is ignored, because all records are written to the same device.
+             * Streamed hashes are patched into the output only if the device is not sequential.
+             *
              * @param exportTemplate Template to apply when exporting the records.
              * @param device Device to write the exported data to.
+             * @param options Options for this export.
+             */
+            void exportRecords(const RecordExportTemplate& exportTemplate,
+                               QIODevice& device,
+                               const RecordExportOptions& options = RecordExportOptions()) const;
+
+            /**
+             * @brief Exports all records using each of the passed export templates to the file at the respective path.
+             *
+             * The record hierarchy and inherited field values are resolved only once and shared by all templates.
+             *
+             * Templates with a split mode write one file per record set, component or root record next to the
+             * respective path, concurrently, along with a manifest listing all files and the SHA-1 hashes of their
+             * contents as written, i.e. after compression.
+             *
+             * Compressed files get the extension of their compression appended to their path. If the hash is
+             * streamed, it is additionally written to a .sha1 file next to each (uncompressed) path.
+             *
+             * @exception std::runtime_error if any of the files could not be written.
+             *
+             * @param exportTemplates Templates to apply when exporting the records.
+             * @param filePaths Paths of the files to write the exported data to, one for each template.
+             * @param options Options for this export.
+             */
+            void exportRecords(const RecordExportTemplateList& exportTemplates,
+                               const QStringList& filePaths,
+                               const RecordExportOptions& options = RecordExportOptions()) const;
+
+            /**
+             * @brief Exports all records with their resolved field values to a typed binary file at the specified path.
+             *
+             * @exception std::runtime_error if the file at the specified path could not be written.
+             *
+             * @see BinaryRecordWriter for the format of the exported file.
+             *
+             * @param filePath Path of the file to write the exported data to.
+             */
+            void exportRecordsBinary(const QString& filePath) const;
+
+            /**
+             * @brief Exports all records with their resolved field values as typed binary data to the specified device.
+             *
+             * @exception std::runtime_error if the device could not be written.
+             *
+             * @see BinaryRecordWriter for the format of the exported data.
+             *
+             * @param device Device to write the exported data to.
              */
-            void exportRecords(const RecordExportTemplate& exportTemplate, QIODevice& device) const;
+            void exportRecordsBinary(QIODevice& device) const;
+
+            /**
+             * @brief Exports all records with their resolved field values to a C++ header at the specified path.
+             *
+             * All generated types and tables are put into a namespace named after the base name of the file.
+             *
+             * @exception std::runtime_error if the file at the specified path could not be written.
+             *
+             * @see CppHeaderWriter for the contents of the generated header.
+             *
+             * @param filePath Path of the header to write the exported data to.
+             */
+            void exportRecordsCppHeader(const QString& filePath) const;
+
+            /**
+             * @brief Exports all records with their resolved field values as C++ header to the specified device.
+             *
+             * @exception std::runtime_error if the device could not be written.
+             *
+             * @see CppHeaderWriter for the contents of the generated header.
+             *
+             * @param device Device to write the header to.
+             * @param namespaceName Name of the namespace to put all generated types and tables into.
+             */
+            void exportRecordsCppHeader(QIODevice& device, const QString& namespaceName) const;
 
             /**
              * @brief Removes the record export template with the specified name from the project.
@@ -111,36 +207,119 @@ namespace Tome
             void progressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const;
 
         private:
-            RecordExportTemplateList* model;
+            /**
+             * @brief Contents of a template file, along with the file state they have been read at.
+             */
+            struct TemplateFileCacheEntry
+            {
+                QString contents;
+                QDateTime lastModified;
+                qint64 size;
+            };
 
-            static const QString PlaceholderAppVersion;
-            static const QString PlaceholderAppVersionName;
-            static const QString PlaceholderComponents;
-            static const QString PlaceholderComponentName;
-            static const QString PlaceholderExportTime;
-            static const QString PlaceholderFieldComponent;
-            static const QString PlaceholderFieldDescription;
-            static const QString PlaceholderFieldDisplayName;
-            static const QString PlaceholderFieldId;
-            static const QString PlaceholderFieldKey;
-            static const QString PlaceholderFieldType;
-            static const QString PlaceholderFieldValue;
-            static const QString PlaceholderHash;
-            static const QString PlaceholderItemType;
-            static const QString PlaceholderKeyType;
-            static const QString PlaceholderListItem;
-            static const QString PlaceholderRecordDisplayName;
-            static const QString PlaceholderRecordFields;
-            static const QString PlaceholderRecordId;
-            static const QString PlaceholderRecordParentId;
-            static const QString PlaceholderRecordRootId;
-            static const QString PlaceholderRecords;
-            static const QString PlaceholderValueType;
+            /**
+             * @brief Consecutive records rendered together by a single thread.
+             */
+            struct RecordExportChunk
+            {
+                QVector<RecordExportItem> items;
+                QVector<RecordExportCacheEntry> cacheEntries;
+                QString output;
+                QString error;
+            };
+
+            /**
+             * @brief Records written to a single file of an export that is split by record set, component or root record.
+             */
+            struct RecordExportSplit
+            {
+                QString key;
+                QString filePath;
+                QVector<RecordExportItem> items;
+                QVector<RecordFieldValueMap> fieldValues;
+                CompiledRecordExportTemplate compiledTemplate;
+                QByteArray hash;
+                QString error;
+            };
+
+            static const QString CacheFileExtension;
+            static const QString HashFileExtension;
+            static const QString ManifestFileExtension;
+            static const int ParallelExportChunkSize;
+            static const int StreamingHashLength;
+
+            RecordExportTemplateList* model;
+            mutable QMap<QString, TemplateFileCacheEntry> templateFileCache;
 
             const FacetsController& facetsController;
             const FieldDefinitionsController& fieldDefinitionsController;
             const RecordsController& recordsController;
             const TypesController& typesController;
+
+            void appendTemplate(QString& output, const ExportTemplateTokenList& tokens, const QString* const* values) const;
+            void appendToken(QString& output, const ExportTemplateToken& token, const QString* const* values) const;
+            QHash<QString, ExportFieldPlan> buildFieldPlans(const RecordExportTemplate& exportTemplate) const;
+            CompiledRecordExportTemplate compileTemplate(const RecordExportTemplate& exportTemplate) const;
+            QByteArray computeRecordDigest(const RecordExportItem& item) const;
+            QByteArray computeTemplateDigest(const RecordExportTemplate& exportTemplate,
+                                             const CompiledRecordExportTemplate& compiledTemplate) const;
+            const ExportFieldPlan& getFieldPlan(const CompiledRecordExportTemplate& compiledTemplate,
+                                                const QString& fieldId) const;
+            RecordExportCache loadCache(const QString& filePath, const QByteArray& templateDigest) const;
+            void loadTemplateContents(RecordExportTemplate& exportTemplate) const;
+            QString readTemplateFile(const QString& fullPath) const;
+            bool renderRecord(const RecordExportItem& item,
+                              const RecordExportTemplate& exportTemplate,
+                              const CompiledRecordExportTemplate& compiledTemplate,
+                              QString& recordString) const;
+            void renderRecordFragment(const RecordExportItem& item,
+                                      const RecordExportTemplate& exportTemplate,
+                                      const CompiledRecordExportTemplate& compiledTemplate,
+                                      const RecordExportCache* previousCache,
+                                      RecordExportCacheEntry& entry) const;
+            void renderRecords(RecordExportChunk& chunk,
+                               const RecordExportTemplate& exportTemplate,
+                               const CompiledRecordExportTemplate& compiledTemplate,
+                               const RecordExportCache* previousCache) const;
+            bool requiresHash(const CompiledRecordExportTemplate& compiledTemplate) const;
+            RecordExportData resolveRecords(bool computeHash) const;
+            void saveCache(const QString& filePath, const RecordExportCache& cache) const;
+            void saveHash(const QString& filePath, const QByteArray& hash) const;
+            QVector<RecordExportItem> selectRecords(const RecordExportTemplate& exportTemplate,
+                                                    const RecordExportData& data) const;
+            QVector<RecordExportSplit> splitRecords(const QString& filePath,
+                                                    const RecordExportTemplate& exportTemplate,
+                                                    const CompiledRecordExportTemplate& compiledTemplate,
+                                                    const RecordExportData& data) const;
+            QByteArray writeRecordFile(QIODevice& device,
+                                       const RecordExportTemplate& exportTemplate,
+                                       const CompiledRecordExportTemplate& compiledTemplate,
+                                       const RecordExportData& data,
+                                       const QVector<RecordExportItem>& items,
+                                       const RecordExportCache* previousCache,
+                                       RecordExportCache* cache,
+                                       const RecordExportOptions& options,
+                                       bool hashOutput,
+                                       bool reportProgress) const;
+            void writeRecords(QTextStream& textStream,
+                              const RecordExportTemplate& exportTemplate,
+                              const CompiledRecordExportTemplate& compiledTemplate,
+                              const QVector<RecordExportItem>& items,
+                              const RecordExportCache* previousCache,
+                              RecordExportCache* cache,
+                              bool reportProgress) const;
+            void writeRecordsParallel(QTextStream& textStream,
+                                      const RecordExportTemplate& exportTemplate,
+                                      const CompiledRecordExportTemplate& compiledTemplate,
+                                      const QVector<RecordExportItem>& items,
+                                      const RecordExportCache* previousCache,
+                                      RecordExportCache* cache,
+                                      bool reportProgress) const;
+            void writeSplitRecordFiles(const QString& filePath,
+                                       const RecordExportTemplate& exportTemplate,
+                                       const CompiledRecordExportTemplate& compiledTemplate,
+                                       const RecordExportData& data,
+                                       const RecordExportOptions& options) const;
     };
 }
 
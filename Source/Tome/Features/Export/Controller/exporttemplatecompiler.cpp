@@ -0,0 +1,101 @@
+#include "exporttemplatecompiler.h"
+
+using namespace Tome;
+
+
+const QString ExportTemplateCompiler::FieldValueByIdPrefix = "$FIELD_VALUE:";
+
+
+CompiledRecordExportTemplate ExportTemplateCompiler::compile(const RecordExportTemplate& exportTemplate) const
+{
+    CompiledRecordExportTemplate compiledTemplate;
+    compiledTemplate.componentTemplate = this->tokenize(exportTemplate.componentTemplate);
+    compiledTemplate.fieldValueTemplate = this->tokenize(exportTemplate.fieldValueTemplate);
+    compiledTemplate.listTemplate = this->tokenize(exportTemplate.listTemplate);
+    compiledTemplate.listItemTemplate = this->tokenize(exportTemplate.listItemTemplate);
+    compiledTemplate.localizedFieldValueTemplate = this->tokenize(exportTemplate.localizedFieldValueTemplate);
+    compiledTemplate.mapTemplate = this->tokenize(exportTemplate.mapTemplate);
+    compiledTemplate.mapItemTemplate = this->tokenize(exportTemplate.mapItemTemplate);
+    compiledTemplate.recordFileTemplate = this->tokenize(exportTemplate.recordFileTemplate);
+    compiledTemplate.recordTemplate = this->tokenize(exportTemplate.recordTemplate);
+    compiledTemplate.stringReplacer = StringReplacer(exportTemplate.stringReplacementMap);
+    return compiledTemplate;
+}
+
+ExportTemplateTokenList ExportTemplateCompiler::tokenize(const QString& templateText) const
+{
+    ExportTemplateTokenList tokens;
+
+    int literalStart = 0;
+    int position = 0;
+    int placeholderStart;
+
+    while ((placeholderStart = templateText.indexOf('$', position)) >= 0)
+    {
+        const int placeholderEnd = templateText.indexOf('$', placeholderStart + 1);
+
+        if (placeholderEnd < 0)
+        {
+            break;
+        }
+
+        // Check for known placeholder.
+        ExportTemplateToken token;
+        token.text = templateText.mid(placeholderStart, placeholderEnd - placeholderStart + 1);
+        token.placeholder = ExportTemplatePlaceholder::fromString(token.text);
+
+        if (token.placeholder == ExportTemplatePlaceholder::None &&
+                token.text.startsWith(FieldValueByIdPrefix) &&
+                this->isFieldId(templateText, placeholderStart + FieldValueByIdPrefix.length(), placeholderEnd))
+        {
+            token.placeholder = ExportTemplatePlaceholder::FieldValueById;
+            token.fieldId = templateText.mid(placeholderStart + FieldValueByIdPrefix.length(),
+                                             placeholderEnd - placeholderStart - FieldValueByIdPrefix.length());
+        }
+
+        if (token.placeholder == ExportTemplatePlaceholder::None)
+        {
+            // Not a placeholder. Closing $ might start the next one.
+            position = placeholderEnd;
+            continue;
+        }
+
+        // Add literal text before placeholder.
+        if (placeholderStart > literalStart)
+        {
+            ExportTemplateToken literal;
+            literal.text = templateText.mid(literalStart, placeholderStart - literalStart);
+            tokens.append(literal);
+        }
+
+        tokens.append(token);
+
+        literalStart = placeholderEnd + 1;
+        position = literalStart;
+    }
+
+    // Add remaining literal text.
+    if (literalStart < templateText.length())
+    {
+        ExportTemplateToken literal;
+        literal.text = templateText.mid(literalStart);
+        tokens.append(literal);
+    }
+
+    return tokens;
+}
+
+bool ExportTemplateCompiler::isFieldId(const QString& text, int from, int to) const
+{
+    for (int i = from; i < to; ++i)
+    {
+        const QChar c = text[i];
+
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef EXPORTTEMPLATECOMPILER_H
+#define EXPORTTEMPLATECOMPILER_H
+
+#include <QString>
+
+#include "../Model/compiledrecordexporttemplate.h"
+#include "../Model/recordexporttemplate.h"
+
+namespace Tome
+{
+    /**
+     * @brief Splits export templates into literal text and placeholders once, so they can be rendered without searching and replacing text.
+     */
+    class ExportTemplateCompiler
+    {
+        public:
+            /**
+             * @brief Compiles all templates of the passed record export template.
+             * @param exportTemplate Record export template to compile.
+             * @return Compiled record export template.
+             */
+            CompiledRecordExportTemplate compile(const RecordExportTemplate& exportTemplate) const;
+
+            /**
+             * @brief Splits the passed template text into literal text and placeholders.
+             *
+             * Text enclosed in $ signs that isn't a known placeholder is kept as literal text.
+             *
+             * @param templateText Template text to split.
+             * @return Literal text and placeholder tokens of the template, in order.
+             */
+            ExportTemplateTokenList tokenize(const QString& templateText) const;
+
+        private:
+            static const QString FieldValueByIdPrefix;
+
+            bool isFieldId(const QString& text, int from, int to) const;
+    };
+}
+
+#endif // EXPORTTEMPLATECOMPILER_H
@@ -14,6 +14,7 @@ const QString ExportTemplateSerializer::AttributeExportInnerNodes = "ExportInner
 const QString ExportTemplateSerializer::AttributeExportLeafs = "ExportLeafs";
 const QString ExportTemplateSerializer::AttributeExportLocalizedFieldsOnly = "ExportLocalizedFieldsOnly";
 const QString ExportTemplateSerializer::AttributeExportedType = "ExportedType";
+const QString ExportTemplateSerializer::AttributeSplitMode = "SplitMode";
 const QString ExportTemplateSerializer::AttributeTomeType = "TomeType";
 const QString ExportTemplateSerializer::AttributeVersion = "Version";
 const QString ExportTemplateSerializer::ElementDefaultFilename = "DefaultFilename";
@@ -78,6 +79,11 @@ void ExportTemplateSerializer::serialize(QIODevice& device, const RecordExportTe
                 writer.writeAttribute(AttributeExportLocalizedFieldsOnly, "true");
             }
 
+            if (exportTemplate.splitMode != RecordExportSplitMode::None)
+            {
+                writer.writeAttribute(AttributeSplitMode, RecordExportSplitMode::toString(exportTemplate.splitMode));
+            }
+
             // Write name and file extension.
             writer.writeTextElement(ElementName, exportTemplate.name);
             writer.writeTextElement(ElementDefaultFilename, exportTemplate.defaultFileName);
@@ -166,12 +172,15 @@ void ExportTemplateSerializer::deserialize(QIODevice& device, RecordExportTempla
         bool exportInnerNodes = reader.readAttribute(AttributeExportInnerNodes) == "true";
         bool exportLeafs = reader.readAttribute(AttributeExportLeafs) == "true";
         bool exportLocalizedFieldsOnly = reader.readAttribute(AttributeExportLocalizedFieldsOnly) == "true";
+        RecordExportSplitMode::RecordExportSplitMode splitMode =
+                RecordExportSplitMode::fromString(reader.readAttribute(AttributeSplitMode));
 
         exportTemplate.exportAsTable = exportAsTable;
         exportTemplate.exportRoots = exportRoots;
         exportTemplate.exportInnerNodes = exportInnerNodes;
         exportTemplate.exportLeafs = exportLeafs;
         exportTemplate.exportLocalizedFieldsOnly = exportLocalizedFieldsOnly;
+        exportTemplate.splitMode = splitMode;
 
         // Read record export templates.
         reader.readStartElement(ElementTemplate);
@@ -39,6 +39,7 @@ namespace Tome
             static const QString AttributeExportLeafs;
             static const QString AttributeExportLocalizedFieldsOnly;
             static const QString AttributeExportedType;
+            static const QString AttributeSplitMode;
             static const QString AttributeTomeType;
             static const QString AttributeVersion;
             static const QString ElementDefaultFilename;
@@ -0,0 +1,77 @@
+#include "recordexportcacheserializer.h"
+
+#include <stdexcept>
+
+#include <QDataStream>
+#include <QObject>
+
+#include "../Model/recordexportcache.h"
+
+using namespace Tome;
+
+
+const quint32 RecordExportCacheSerializer::Magic = 0x546f6d43;
+const quint32 RecordExportCacheSerializer::Version = 1;
+
+
+void RecordExportCacheSerializer::serialize(QIODevice& device, const RecordExportCache& cache) const
+{
+    QDataStream stream(&device);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Write header.
+    stream << Magic << Version;
+    stream << cache.templateDigest;
+    stream << static_cast<qint32>(cache.entries.size());
+
+    // Write entries.
+    for (QHash<QString, RecordExportCacheEntry>::const_iterator it = cache.entries.cbegin();
+         it != cache.entries.cend();
+         ++it)
+    {
+        const RecordExportCacheEntry& entry = it.value();
+        stream << entry.recordId << entry.digest << entry.fragment;
+    }
+}
+
+void RecordExportCacheSerializer::deserialize(QIODevice& device, RecordExportCache& cache) const
+{
+    QDataStream stream(&device);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Read header.
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 entryCount = 0;
+
+    stream >> magic >> version;
+
+    if (magic != Magic || version != Version)
+    {
+        throw std::runtime_error(QObject::tr("Unsupported record export cache.").toStdString());
+    }
+
+    stream >> cache.templateDigest;
+    stream >> entryCount;
+
+    if (entryCount < 0)
+    {
+        throw std::runtime_error(QObject::tr("Record export cache is corrupt.").toStdString());
+    }
+
+    // Read entries.
+    cache.entries.reserve(entryCount);
+
+    for (qint32 i = 0; i < entryCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        RecordExportCacheEntry entry;
+        stream >> entry.recordId >> entry.digest >> entry.fragment;
+
+        cache.entries.insert(entry.recordId, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        throw std::runtime_error(QObject::tr("Record export cache is corrupt.").toStdString());
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef RECORDEXPORTCACHESERIALIZER_H
+#define RECORDEXPORTCACHESERIALIZER_H
+
+#include <QIODevice>
+
+namespace Tome
+{
+    class RecordExportCache;
+
+    /**
+     * @brief Reads and writes caches of rendered records from any device.
+     */
+    class RecordExportCacheSerializer
+    {
+        public:
+            /**
+             * @brief Writes the passed record export cache to the specified device.
+             * @param device Device to write the record export cache to.
+             * @param cache Record export cache to write.
+             */
+            void serialize(QIODevice& device, const RecordExportCache& cache) const;
+
+            /**
+             * @brief Reads the record export cache from the specified device.
+             *
+             * @exception std::runtime_error if the device doesn't contain a valid record export cache of the current version.
+             *
+             * @param device Device to read the record export cache from.
+             * @param cache Record export cache to read the data into.
+             */
+            void deserialize(QIODevice& device, RecordExportCache& cache) const;
+
+        private:
+            static const quint32 Magic;
+            static const quint32 Version;
+    };
+}
+
+#endif // RECORDEXPORTCACHESERIALIZER_H
@@ -0,0 +1,80 @@
+#ifndef BINARYVALUETYPE_H
+#define BINARYVALUETYPE_H
+
+namespace Tome
+{
+    namespace BinaryValueType
+    {
+        /**
+         * @brief Encoding of the values of a single column of a binary record export.
+         */
+        enum BinaryValueType
+        {
+            None,
+            Boolean,
+            Integer,
+            Real,
+            String,
+            Color,
+            Vector2I,
+            Vector2R,
+            Vector3I,
+            Vector3R,
+            List,
+            Map
+        };
+
+        /**
+         * @brief Gets the number of bytes each value of the specified type occupies in its column.
+         * @param valueType Type to get the value size of.
+         * @return Number of bytes each value of the specified type occupies in its column.
+         */
+        inline int getCellSize(BinaryValueType valueType)
+        {
+            switch (valueType)
+            {
+                case BinaryValueType::Boolean:
+                    return 1;
+
+                case BinaryValueType::Integer:
+                case BinaryValueType::String:
+                case BinaryValueType::Color:
+                    return 4;
+
+                case BinaryValueType::Real:
+                case BinaryValueType::Vector2I:
+                case BinaryValueType::List:
+                case BinaryValueType::Map:
+                    return 8;
+
+                case BinaryValueType::Vector3I:
+                    return 12;
+
+                case BinaryValueType::Vector2R:
+                    return 16;
+
+                case BinaryValueType::Vector3R:
+                    return 24;
+
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         * @brief Checks whether values of the specified type fit into a single list or map item.
+         * @param valueType Type to check.
+         * @return true, if values of the specified type can be stored as list or map items, and false otherwise.
+         */
+        inline bool isItemType(BinaryValueType valueType)
+        {
+            return valueType == BinaryValueType::Boolean ||
+                   valueType == BinaryValueType::Integer ||
+                   valueType == BinaryValueType::Real ||
+                   valueType == BinaryValueType::String ||
+                   valueType == BinaryValueType::Color;
+        }
+    }
+}
+
+#endif // BINARYVALUETYPE_H
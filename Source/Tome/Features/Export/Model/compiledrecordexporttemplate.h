@@ -0,0 +1,83 @@
+#ifndef COMPILEDRECORDEXPORTTEMPLATE_H
+#define COMPILEDRECORDEXPORTTEMPLATE_H
+
+#include <QBitArray>
+#include <QHash>
+
+#include "exportfieldplan.h"
+#include "exporttemplatetokenlist.h"
+#include "../../../Util/stringreplacer.h"
+
+namespace Tome
+{
+    /**
+     * @brief Record export template whose templates have been split into literal text and placeholders for rendering.
+     */
+    class CompiledRecordExportTemplate
+    {
+        public:
+            /**
+             * @brief Tokens of the template to apply for exporting components.
+             */
+            ExportTemplateTokenList componentTemplate;
+
+            /**
+             * @brief Resolved metadata of all fields of the project for this template, by field id.
+             */
+            QHash<QString, ExportFieldPlan> fieldPlans;
+
+            /**
+             * @brief Tokens of the template to apply for exporting field values.
+             */
+            ExportTemplateTokenList fieldValueTemplate;
+
+            /**
+             * @brief Tokens of the template to apply for exporting list field values.
+             */
+            ExportTemplateTokenList listTemplate;
+
+            /**
+             * @brief Tokens of the template to apply for exporting list field items.
+             */
+            ExportTemplateTokenList listItemTemplate;
+
+            /**
+             * @brief Tokens of the template to apply for exporting all values of fields whose type has the \ref LocalizedStringFacet applied.
+             */
+            ExportTemplateTokenList localizedFieldValueTemplate;
+
+            /**
+             * @brief Tokens of the template to apply for exporting map field values.
+             */
+            ExportTemplateTokenList mapTemplate;
+
+            /**
+             * @brief Tokens of the template to apply for exporting map field items.
+             */
+            ExportTemplateTokenList mapItemTemplate;
+
+            /**
+             * @brief Tokens of the main export template that recursively applies all other templates.
+             */
+            ExportTemplateTokenList recordFileTemplate;
+
+            /**
+             * @brief Tokens of the template to apply for exporting records.
+             */
+            ExportTemplateTokenList recordTemplate;
+
+            /**
+             * @brief Whether the value of the field with the respective ordinal is explicitly placed by the record template.
+             *
+             * Has one bit for each field plan, so its size is the number of field ordinals.
+             */
+            QBitArray recordTemplateFields;
+
+            /**
+             * @brief String replacements to apply to all exported field values.
+             */
+            StringReplacer stringReplacer;
+    };
+}
+
+#endif // COMPILEDRECORDEXPORTTEMPLATE_H
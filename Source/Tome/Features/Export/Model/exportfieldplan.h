@@ -0,0 +1,71 @@
+#ifndef EXPORTFIELDPLAN_H
+#define EXPORTFIELDPLAN_H
+
+#include <QString>
+
+namespace Tome
+{
+    class FieldDefinition;
+
+    namespace ExportFieldKind
+    {
+        enum ExportFieldKind
+        {
+            Plain,
+            List,
+            Map,
+            Vector2,
+            Vector3,
+            Localized
+        };
+    }
+
+    /**
+     * @brief Resolved metadata for exporting the values of a single field with a specific export template.
+     */
+    class ExportFieldPlan
+    {
+        public:
+            /**
+             * @brief Definition of the field to export.
+             */
+            const FieldDefinition* fieldDefinition = nullptr;
+
+            /**
+             * @brief Index of the field among all fields of the project, for looking up per-field data without hashing its id.
+             */
+            int ordinal = -1;
+
+            /**
+             * @brief Kind of the field, determining how to build value texts and which field value template to apply.
+             */
+            ExportFieldKind::ExportFieldKind kind = ExportFieldKind::Plain;
+
+            /**
+             * @brief Whether to export this field in the list of record fields, i.e. it is neither ignored nor skipped for not being localized.
+             */
+            bool exported = true;
+
+            /**
+             * @brief Type name of the field, after applying the type map of the export template.
+             */
+            QString exportedFieldType;
+
+            /**
+             * @brief Item type name of list fields, after applying the type map of the export template.
+             */
+            QString exportedItemType;
+
+            /**
+             * @brief Key type name of map and vector fields, after applying the type map of the export template.
+             */
+            QString exportedKeyType;
+
+            /**
+             * @brief Value type name of map and vector fields, after applying the type map of the export template.
+             */
+            QString exportedValueType;
+    };
+}
+
+#endif // EXPORTFIELDPLAN_H
@@ -0,0 +1,142 @@
+#ifndef EXPORTTEMPLATEPLACEHOLDER_H
+#define EXPORTTEMPLATEPLACEHOLDER_H
+
+#include <QString>
+
+namespace Tome
+{
+    namespace ExportTemplatePlaceholder
+    {
+        enum ExportTemplatePlaceholder
+        {
+            None,
+            AppVersion,
+            AppVersionName,
+            Components,
+            ComponentName,
+            ExportTime,
+            FieldComponent,
+            FieldDescription,
+            FieldDisplayName,
+            FieldId,
+            FieldKey,
+            FieldType,
+            FieldValue,
+            FieldValueById,
+            Hash,
+            ItemType,
+            KeyType,
+            ListItem,
+            RecordDisplayName,
+            RecordFields,
+            RecordId,
+            RecordParentId,
+            RecordRootId,
+            Records,
+            ValueType
+        };
+
+        /**
+         * @brief Number of different placeholders, including None.
+         */
+        const int Count = ValueType + 1;
+
+        inline const QString toString(ExportTemplatePlaceholder placeholder)
+        {
+            switch (placeholder)
+            {
+                case ExportTemplatePlaceholder::None:
+                    return QString();
+
+                case ExportTemplatePlaceholder::AppVersion:
+                    return "$APP_VERSION$";
+
+                case ExportTemplatePlaceholder::AppVersionName:
+                    return "$APP_VERSION_NAME$";
+
+                case ExportTemplatePlaceholder::Components:
+                    return "$RECORD_COMPONENTS$";
+
+                case ExportTemplatePlaceholder::ComponentName:
+                    return "$COMPONENT_NAME$";
+
+                case ExportTemplatePlaceholder::ExportTime:
+                    return "$EXPORT_TIME$";
+
+                case ExportTemplatePlaceholder::FieldComponent:
+                    return "$FIELD_COMPONENT$";
+
+                case ExportTemplatePlaceholder::FieldDescription:
+                    return "$FIELD_DESCRIPTION$";
+
+                case ExportTemplatePlaceholder::FieldDisplayName:
+                    return "$FIELD_DISPLAY_NAME$";
+
+                case ExportTemplatePlaceholder::FieldId:
+                    return "$FIELD_ID$";
+
+                case ExportTemplatePlaceholder::FieldKey:
+                    return "$FIELD_KEY$";
+
+                case ExportTemplatePlaceholder::FieldType:
+                    return "$FIELD_TYPE$";
+
+                case ExportTemplatePlaceholder::FieldValue:
+                    return "$FIELD_VALUE$";
+
+                case ExportTemplatePlaceholder::FieldValueById:
+                    return "$FIELD_VALUE:";
+
+                case ExportTemplatePlaceholder::Hash:
+                    return "$HASH$";
+
+                case ExportTemplatePlaceholder::ItemType:
+                    return "$ITEM_TYPE$";
+
+                case ExportTemplatePlaceholder::KeyType:
+                    return "$KEY_TYPE$";
+
+                case ExportTemplatePlaceholder::ListItem:
+                    return "$LIST_ITEM$";
+
+                case ExportTemplatePlaceholder::RecordDisplayName:
+                    return "$RECORD_DISPLAY_NAME$";
+
+                case ExportTemplatePlaceholder::RecordFields:
+                    return "$RECORD_FIELDS$";
+
+                case ExportTemplatePlaceholder::RecordId:
+                    return "$RECORD_ID$";
+
+                case ExportTemplatePlaceholder::RecordParentId:
+                    return "$RECORD_PARENT$";
+
+                case ExportTemplatePlaceholder::RecordRootId:
+                    return "$RECORD_ROOT$";
+
+                case ExportTemplatePlaceholder::Records:
+                    return "$RECORDS$";
+
+                case ExportTemplatePlaceholder::ValueType:
+                    return "$VALUE_TYPE$";
+            }
+
+            return QString();
+        }
+
+        inline ExportTemplatePlaceholder fromString(const QString& placeholder)
+        {
+            for (int i = None + 1; i < Count; ++i)
+            {
+                if (i != FieldValueById && toString(static_cast<ExportTemplatePlaceholder>(i)) == placeholder)
+                {
+                    return static_cast<ExportTemplatePlaceholder>(i);
+                }
+            }
+
+            return ExportTemplatePlaceholder::None;
+        }
+    }
+}
+
+#endif // EXPORTTEMPLATEPLACEHOLDER_H
@@ -0,0 +1,38 @@
+#ifndef EXPORTTEMPLATETOKEN_H
+#define EXPORTTEMPLATETOKEN_H
+
+#include <QString>
+
+#include "exporttemplateplaceholder.h"
+
+namespace Tome
+{
+    /**
+     * @brief Literal text or placeholder of a compiled export template.
+     */
+    class ExportTemplateToken
+    {
+        public:
+            /**
+             * @brief Placeholder to substitute, or None for literal text.
+             */
+            ExportTemplatePlaceholder::ExportTemplatePlaceholder placeholder = ExportTemplatePlaceholder::None;
+
+            /**
+             * @brief Literal text of this token. For placeholders, this is the original placeholder text, which is written if the placeholder can't be substituted.
+             */
+            QString text;
+
+            /**
+             * @brief Id of the field whose value to insert, if this is a field value placeholder for a specific field.
+             */
+            QString fieldId;
+
+            /**
+             * @brief Ordinal of the field whose value to insert, or -1 if the field doesn't exist or has not been resolved yet.
+             */
+            int fieldOrdinal = -1;
+    };
+}
+
+#endif // EXPORTTEMPLATETOKEN_H
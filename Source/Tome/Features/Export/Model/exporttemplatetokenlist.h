@@ -0,0 +1,13 @@
+#ifndef EXPORTTEMPLATETOKENLIST_H
+#define EXPORTTEMPLATETOKENLIST_H
+
+#include <QVector>
+#include "exporttemplatetoken.h"
+
+
+namespace Tome
+{
+    typedef QVector<ExportTemplateToken> ExportTemplateTokenList;
+}
+
+#endif // EXPORTTEMPLATETOKENLIST_H
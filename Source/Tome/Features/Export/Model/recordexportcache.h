@@ -0,0 +1,30 @@
+#ifndef RECORDEXPORTCACHE_H
+#define RECORDEXPORTCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include "recordexportcacheentry.h"
+
+namespace Tome
+{
+    /**
+     * @brief Output rendered for each record by a previous export with a specific template.
+     */
+    class RecordExportCache
+    {
+        public:
+            /**
+             * @brief Rendered output of all records, by record id.
+             */
+            QHash<QString, RecordExportCacheEntry> entries;
+
+            /**
+             * @brief Digest of all template data the records have been rendered with.
+             */
+            QByteArray templateDigest;
+    };
+}
+
+#endif // RECORDEXPORTCACHE_H
@@ -0,0 +1,32 @@
+#ifndef RECORDEXPORTCACHEENTRY_H
+#define RECORDEXPORTCACHEENTRY_H
+
+#include <QByteArray>
+#include <QString>
+
+namespace Tome
+{
+    /**
+     * @brief Output rendered for a single record by a previous export.
+     */
+    class RecordExportCacheEntry
+    {
+        public:
+            /**
+             * @brief Digest of all record data the output has been rendered from.
+             */
+            QByteArray digest;
+
+            /**
+             * @brief Rendered output of the record, or an empty string if the record has been skipped.
+             */
+            QString fragment;
+
+            /**
+             * @brief Id of the rendered record.
+             */
+            QString recordId;
+    };
+}
+
+#endif // RECORDEXPORTCACHEENTRY_H
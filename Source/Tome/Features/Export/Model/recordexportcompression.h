@@ -0,0 +1,65 @@
+#ifndef RECORDEXPORTCOMPRESSION_H
+#define RECORDEXPORTCOMPRESSION_H
+
+#include <QString>
+
+namespace Tome
+{
+    namespace RecordExportCompression
+    {
+        enum RecordExportCompression
+        {
+            Invalid,
+            None,
+            Gzip
+        };
+
+        inline const QString toString(RecordExportCompression compression)
+        {
+            switch (compression)
+            {
+                case RecordExportCompression::Invalid:
+                    return "Invalid";
+
+                case RecordExportCompression::None:
+                    return "None";
+
+                case RecordExportCompression::Gzip:
+                    return "Gzip";
+            }
+
+            return QString();
+        }
+
+        inline RecordExportCompression fromString(QString compression)
+        {
+            if (compression.isEmpty() || compression.compare("None", Qt::CaseInsensitive) == 0)
+            {
+                return RecordExportCompression::None;
+            }
+            else if (compression.compare("Gzip", Qt::CaseInsensitive) == 0)
+            {
+                return RecordExportCompression::Gzip;
+            }
+
+            return RecordExportCompression::Invalid;
+        }
+
+        inline const QString getFileExtension(RecordExportCompression compression)
+        {
+            switch (compression)
+            {
+                case RecordExportCompression::Invalid:
+                case RecordExportCompression::None:
+                    return QString();
+
+                case RecordExportCompression::Gzip:
+                    return ".gz";
+            }
+
+            return QString();
+        }
+    }
+}
+
+#endif // RECORDEXPORTCOMPRESSION_H
@@ -0,0 +1,61 @@
+#ifndef RECORDEXPORTDATA_H
+#define RECORDEXPORTDATA_H
+
+#include <QString>
+#include <QVector>
+
+#include "../../Records/Model/recordfieldvaluemap.h"
+
+namespace Tome
+{
+    class Record;
+
+    /**
+     * @brief Records of the project along with their hierarchy and resolved field values, shared by all templates of an export.
+     */
+    class RecordExportData
+    {
+        public:
+            /**
+             * @brief Indices of the children of each record.
+             */
+            QVector<QVector<int>> children;
+
+            /**
+             * @brief Field values of each record, including inherited ones.
+             */
+            QVector<RecordFieldValueMap> fieldValues;
+
+            /**
+             * @brief Whether each record or any of its ancestors has any field values of its own.
+             */
+            QVector<bool> hasFieldValues;
+
+            /**
+             * @brief Hash of all records, if required by any template of the export.
+             */
+            QString hash;
+
+            /**
+             * @brief Indices of all records reachable from any root, parents before their children.
+             */
+            QVector<int> hierarchyOrder;
+
+            /**
+             * @brief Index of the parent of each record, or -1 if the record has no parent.
+             */
+            QVector<int> parents;
+
+            /**
+             * @brief All records of the project, in the order of their record sets.
+             */
+            QVector<const Record*> records;
+
+            /**
+             * @brief Index of the topmost ancestor of each record, or -1 if the record isn't reachable from any root.
+             */
+            QVector<int> roots;
+    };
+}
+
+#endif // RECORDEXPORTDATA_H
@@ -0,0 +1,40 @@
+#ifndef RECORDEXPORTITEM_H
+#define RECORDEXPORTITEM_H
+
+#include <QString>
+
+#include "../../Records/Model/recordfieldvaluemap.h"
+
+namespace Tome
+{
+    class Record;
+
+    /**
+     * @brief Record selected for export, along with its position in the record hierarchy.
+     */
+    class RecordExportItem
+    {
+        public:
+            /**
+             * @brief Field values of the record, including inherited ones.
+             */
+            const RecordFieldValueMap* fieldValues = nullptr;
+
+            /**
+             * @brief Record to export.
+             */
+            const Record* record = nullptr;
+
+            /**
+             * @brief Id of the parent of the record, or an empty string if the record has no parent with any field values.
+             */
+            QString parentId;
+
+            /**
+             * @brief Id of the topmost ancestor of the record, or the id of the record itself if it has no ancestors.
+             */
+            QString rootId;
+    };
+}
+
+#endif // RECORDEXPORTITEM_H
@@ -0,0 +1,42 @@
+#ifndef RECORDEXPORTOPTIONS_H
+#define RECORDEXPORTOPTIONS_H
+
+#include "recordexportcompression.h"
+
+namespace Tome
+{
+    /**
+     * @brief Options for a single record export, independent of the export template used.
+     */
+    class RecordExportOptions
+    {
+        public:
+            /**
+             * @brief Format to compress exported files with while writing them. Compressed files get the respective
+             * extension appended to their path, e.g. .gz. Ignored when exporting to devices other than files.
+             */
+            RecordExportCompression::RecordExportCompression compression = RecordExportCompression::None;
+
+            /**
+             * @brief Whether to re-render only records that have changed since the previous export, reusing the output
+             * of all other records from a cache next to the exported file. Ignored when exporting to devices other than files.
+             */
+            bool incremental = false;
+
+            /**
+             * @brief Whether to render records on multiple threads. Output is identical to exporting on a single thread.
+             */
+            bool parallel = false;
+
+            /**
+             * @brief Whether to hash the exported output while writing it, instead of hashing all records up front.
+             *
+             * $HASH$ is written as zeros first, and patched with the SHA-1 of the output (with zeros in place of
+             * all hashes) afterwards. Compressed output can't be patched, so all records are hashed up front for $HASH$
+             * instead. In any case, the SHA-1 of the output is written to a .sha1 file next to the exported file.
+             */
+            bool streamingHash = false;
+    };
+}
+
+#endif // RECORDEXPORTOPTIONS_H
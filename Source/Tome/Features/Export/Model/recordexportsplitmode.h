@@ -0,0 +1,58 @@
+#ifndef RECORDEXPORTSPLITMODE_H
+#define RECORDEXPORTSPLITMODE_H
+
+#include <QString>
+
+namespace Tome
+{
+    namespace RecordExportSplitMode
+    {
+        enum RecordExportSplitMode
+        {
+            None,
+            RecordSet,
+            Component,
+            Root
+        };
+
+        inline const QString toString(RecordExportSplitMode splitMode)
+        {
+            switch (splitMode)
+            {
+                case RecordExportSplitMode::None:
+                    return "None";
+
+                case RecordExportSplitMode::RecordSet:
+                    return "RecordSet";
+
+                case RecordExportSplitMode::Component:
+                    return "Component";
+
+                case RecordExportSplitMode::Root:
+                    return "Root";
+            }
+
+            return QString();
+        }
+
+        inline RecordExportSplitMode fromString(QString splitMode)
+        {
+            if (splitMode == "RecordSet")
+            {
+                return RecordExportSplitMode::RecordSet;
+            }
+            else if (splitMode == "Component")
+            {
+                return RecordExportSplitMode::Component;
+            }
+            else if (splitMode == "Root")
+            {
+                return RecordExportSplitMode::Root;
+            }
+
+            return RecordExportSplitMode::None;
+        }
+    }
+}
+
+#endif // RECORDEXPORTSPLITMODE_H
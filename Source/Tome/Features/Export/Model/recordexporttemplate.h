@@ -4,6 +4,8 @@
 #include <QMap>
 #include <QString>
 
+#include "recordexportsplitmode.h"
+
 namespace Tome
 {
     /**
@@ -127,6 +129,11 @@ namespace Tome
              */
             QString recordTemplate;
 
+            /**
+             * @brief Whether to write one file per record set, component or root record, instead of a single file.
+             */
+            RecordExportSplitMode::RecordExportSplitMode splitMode = RecordExportSplitMode::None;
+
             /**
              * @brief Map that specifies which strings to replace by which ones during export.
              */
@@ -137,6 +144,13 @@ namespace Tome
              */
             QString templateFilesPath;
 
+            /**
+             * @brief Absolute path of the template content files on disk, without extension.
+             *
+             * Template contents are read from there when the template is first used for exporting.
+             */
+            QString fullTemplateFilesPath;
+
             /**
              * @brief Map that specifies which type names to replace on export.
              */
@@ -83,7 +83,25 @@ void FieldDefinitionsController::addFieldDefinitionSet(const FieldDefinitionSet&
 
 const FieldDefinition& FieldDefinitionsController::getFieldDefinition(const QString& id) const
 {
-    return *this->getFieldDefinitionById(id);
+    // Use const access only, so field definitions can be read from multiple threads at once.
+    for (int i = 0; i < this->model->size(); ++i)
+    {
+        const FieldDefinitionSet& fieldDefinitionSet = this->model->at(i);
+
+        for (int j = 0; j < fieldDefinitionSet.fieldDefinitions.size(); ++j)
+        {
+            const FieldDefinition& fieldDefinition = fieldDefinitionSet.fieldDefinitions.at(j);
+
+            if (fieldDefinition.id == id)
+            {
+                return fieldDefinition;
+            }
+        }
+    }
+
+    const QString errorMessage = "Field not found: " + id;
+    qCritical(qUtf8Printable(errorMessage));
+    throw std::out_of_range(errorMessage.toStdString());
 }
 
 const FieldDefinitionList FieldDefinitionsController::getFieldDefinitions() const
@@ -1,13 +1,16 @@
 #include "csvrecorddatasource.h"
 
-#include <QFile>
-#include <QTextStream>
+#include <QCryptographicHash>
+
+#include "../../../IO/csvreader.h"
+#include "../../../IO/mappedfile.h"
 
 using namespace Tome;
 
 
 const QString CsvRecordDataSource::ParameterDelimiter = "Delimiter";
-const QString CsvRecordDataSource::ParameterStripQuotes = "StripQuotes";
+const int CsvRecordDataSource::HashChunkSize = 64 * 1024 * 1024;
+const int CsvRecordDataSource::ProgressInterval = 1024;
 
 
 CsvRecordDataSource::CsvRecordDataSource()
@@ -15,12 +18,21 @@ CsvRecordDataSource::CsvRecordDataSource()
 }
 
 void CsvRecordDataSource::importData(const RecordTableImportTemplate& importTemplate, const QVariant& context)
+{
+    // Read file on a worker thread, applying rows on the model thread while reading.
+    this->runWorker([this, importTemplate, context]()
+    {
+        this->readData(importTemplate, context);
+    });
+}
+
+void CsvRecordDataSource::readData(const RecordTableImportTemplate& importTemplate, const QVariant& context)
 {
     // Open CSV file.
     const QString filePath = context.toString();
-    QFile file(filePath);
+    MappedFile file(filePath);
 
-    if (!file.open(QIODevice::ReadOnly))
+    if (!file.open())
     {
         QString errorMessage = QObject::tr("Source file could not be read:\r\n") + filePath;
         qCritical(qUtf8Printable(errorMessage));
@@ -29,143 +41,128 @@ void CsvRecordDataSource::importData(const RecordTableImportTemplate& importTemp
     }
 
     // Show progress bar.
-    QString progressBarTitle = tr("Importing %1 With %2").arg(file.fileName(), importTemplate.name);
+    QString progressBarTitle = tr("Importing %1 With %2").arg(filePath, importTemplate.name);
     emit this->progressChanged(progressBarTitle, tr("Opening File"), 0, 100);
 
-    QTextStream textStream(&file);
-    textStream.setCodec("UTF-8");
+    // Hash contents on this thread, to allow skipping the import if the file hasn't changed since the last import.
+    // Hash in chunks, as files may exceed the size that can be hashed at once.
+    const qint64 fileSize = file.getSize();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    for (qint64 offset = 0; offset < fileSize; offset += HashChunkSize)
+    {
+        hash.addData(file.getBytes() + offset, static_cast<int>(qMin<qint64>(fileSize - offset, HashChunkSize)));
+    }
+
+    emit this->contentDigestAvailable(importTemplate.name, context, hash.result());
 
     // Read configuration.
     QString delimiter = importTemplate.parameters.contains(ParameterDelimiter)
             ? importTemplate.parameters[ParameterDelimiter]
             : ";";
 
-    bool stripQuotes = importTemplate.parameters.contains(ParameterStripQuotes)
-            ? QVariant(importTemplate.parameters[ParameterStripQuotes]).toBool()
-            : false;
+    if (delimiter.isEmpty() || delimiter.contains('"') || delimiter.contains('\r') || delimiter.contains('\n'))
+    {
+        QString errorMessage = QObject::tr("CSV delimiter must not be empty or contain quotes or line breaks: %1")
+                .arg(delimiter);
+        qCritical(qUtf8Printable(errorMessage));
+        emit this->dataUnavailable(importTemplate.name, context, errorMessage);
+        return;
+    }
 
-    // Read headers.
-    QString line;
-    line = textStream.readLine();
+    CsvReader reader(file.getBytes(), fileSize, delimiter.toUtf8());
 
-    if (line.isEmpty())
+    // Read headers.
+    if (!reader.readRow())
     {
         QString errorMessage = QObject::tr("Source file is empty:\r\n") + filePath;
         qCritical(qUtf8Printable(errorMessage));
-        file.close();
         emit this->dataUnavailable(importTemplate.name, context, errorMessage);
         return;
     }
 
     QStringList headers;
 
-    if (stripQuotes)
-    {
-        // Clean headers.
-        QStringList rawHeaders = line.split(delimiter);
-
-        for (int i = 0; i < rawHeaders.count(); ++i)
-        {
-            QString rawHeader = rawHeaders[i];
-
-            if (rawHeader.startsWith('"') && rawHeader.endsWith('"'))
-            {
-                headers << rawHeader.mid(1, rawHeader.length() - 2);
-            }
-            else
-            {
-                headers << rawHeader;
-            }
-        }
-    }
-    else
+    for (int i = 0; i < reader.getFieldCount(); ++i)
     {
-        headers = line.split(delimiter);
+        headers << reader.getField(i);
     }
 
     // Find id column.
-    int idColumnIndex = -1;
-
-    for (int i = 0; i < headers.count(); ++i)
-    {
-        if (headers[i] == importTemplate.idColumn)
-        {
-            idColumnIndex = i;
-            break;
-        }
-    }
+    const int idColumnIndex = headers.indexOf(importTemplate.idColumn);
 
     if (idColumnIndex == -1)
     {
         QString errorMessage = QObject::tr("Could not find id column %1 in source file:\r\n%2")
                 .arg(importTemplate.idColumn, filePath);
         qCritical(qUtf8Printable(errorMessage));
-        file.close();
         emit this->dataUnavailable(importTemplate.name, context, errorMessage);
         return;
     }
 
+    emit this->columnsAvailable(importTemplate.name, context, headers);
+
     // Read rows.
-    QMap<QString, RecordFieldValueMap> data;
     int rowIndex = 0;
 
-    while (!(line = textStream.readLine()).isEmpty())
+    while (!this->isCancelled() && reader.readRow())
     {
         ++rowIndex;
-        QStringList row = line.split(delimiter);
 
-        if (row.count() != headers.count())
+        if (reader.hasUnterminatedQuote())
+        {
+            QString errorMessage = QObject::tr("Row %1 has a quoted field without closing quote.")
+                    .arg(QString::number(rowIndex));
+            qCritical(qUtf8Printable(errorMessage));
+            emit this->dataUnavailable(importTemplate.name, context, errorMessage);
+            return;
+        }
+
+        if (reader.getFieldCount() != headers.count())
         {
             QString errorMessage = QObject::tr("Row %1 has %2 columns, but the header has %3 columns.")
-                    .arg(QString::number(rowIndex), QString::number(row.count()), QString::number(headers.count()));
+                    .arg(QString::number(rowIndex),
+                         QString::number(reader.getFieldCount()),
+                         QString::number(headers.count()));
             qCritical(qUtf8Printable(errorMessage));
-            file.close();
             emit this->dataUnavailable(importTemplate.name, context, errorMessage);
             return;
         }
 
         // Get record id.
-        QString recordId = row[idColumnIndex];
+        RecordImportRow row;
+        row.recordId = reader.getField(idColumnIndex);
 
-        if (stripQuotes && recordId.startsWith('"') && recordId.endsWith('"'))
+        // Update progress bar.
+        if (rowIndex % ProgressInterval == 0)
         {
-            recordId = recordId.mid(1, recordId.length() - 2);
+            // Report progress in percent, as file offsets may exceed the range of progress values.
+            emit this->progressChanged(progressBarTitle, row.recordId,
+                                       static_cast<int>(reader.getPosition() * 100 / fileSize), 100);
         }
 
-        // Update progress bar.
-        emit this->progressChanged(progressBarTitle, recordId, file.pos(), file.size());
-
         // Check if ignored.
-        if (importTemplate.ignoredIds.contains(recordId))
+        if (importTemplate.ignoredIds.contains(row.recordId))
         {
             continue;
         }
 
         // Get data.
-        RecordFieldValueMap map;
+        row.values.reserve(reader.getFieldCount());
 
-        for (int i = 0; i < row.count(); ++i)
+        for (int i = 0; i < reader.getFieldCount(); ++i)
         {
-            if (i == idColumnIndex)
-            {
-                continue;
-            }
-
-            QString value = row[i];
-
-            if (stripQuotes && value.startsWith('"') && value.endsWith('"'))
-            {
-                value = value.mid(1, value.length() - 2);
-            }
-
-            map[headers[i]] = value;
+            row.values << (i == idColumnIndex ? row.recordId : reader.getField(i));
         }
 
-        data[recordId] = map;
+        this->addRow(importTemplate.name, context, row);
     }
 
-    file.close();
+    if (this->isCancelled())
+    {
+        return;
+    }
 
     emit this->progressChanged(progressBarTitle, QString(), 1, 1);
-    emit this->dataAvailable(importTemplate.name, context, data);
+    this->completeRows(importTemplate.name, context);
 }
@@ -35,6 +35,11 @@ void GoogleSheetsRecordDataSource::onFinished(QNetworkReply* reply)
 {
     reply->deleteLater();
 
+    if (this->isCancelled())
+    {
+        return;
+    }
+
     // Check for errors.
     if (reply->error() != QNetworkReply::NoError)
     {
@@ -92,12 +97,13 @@ void GoogleSheetsRecordDataSource::onFinished(QNetworkReply* reply)
         return;
     }
 
+    emit this->columnsAvailable(this->importTemplateName, this->context, headers);
+
     // Read rows.
-    QMap<QString, RecordFieldValueMap> data;
     int rowIndex = 0;
     QString progressBarTitle = tr("Importing %1 With %2").arg(this->context.toString(), this->importTemplateName);
 
-    while (!(line = textStream.readLine()).isEmpty())
+    while (!this->isCancelled() && !(line = textStream.readLine()).isEmpty())
     {
         ++rowIndex;
         QStringList row = line.split(',');
@@ -112,33 +118,34 @@ void GoogleSheetsRecordDataSource::onFinished(QNetworkReply* reply)
         }
 
         // Get record id.
-        QString recordId = row[idColumnIndex];
+        RecordImportRow importRow;
+        importRow.recordId = row[idColumnIndex];
 
         // Update progress bar.
-        emit this->progressChanged(progressBarTitle, recordId, reply->pos(), reply->size());
+        emit this->progressChanged(progressBarTitle, importRow.recordId, reply->pos(), reply->size());
 
         // Check if ignored.
-        if (this->ignoredIds.contains(recordId))
+        if (this->ignoredIds.contains(importRow.recordId))
         {
             continue;
         }
 
         // Get data.
-        RecordFieldValueMap map;
+        importRow.values.reserve(row.count());
 
         for (int i = 0; i < row.count(); ++i)
         {
-            if (i == idColumnIndex)
-            {
-                continue;
-            }
-
-            map[headers[i]] = row[i];
+            importRow.values << row[i];
         }
 
-        data[recordId] = map;
+        this->addRow(this->importTemplateName, this->context, importRow);
+    }
+
+    if (this->isCancelled())
+    {
+        return;
     }
 
     emit this->progressChanged(progressBarTitle, QString(), 1, 1);
-    emit this->dataAvailable(this->importTemplateName, this->context, data);
+    this->completeRows(this->importTemplateName, this->context);
 }
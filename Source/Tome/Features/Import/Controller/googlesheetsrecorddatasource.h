@@ -30,12 +30,36 @@ namespace Tome
 
         signals:
             /**
-             * @brief Importing records asynchronously has finished.
+             * @brief The header row has been read.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Google Sheet ID.
+             * @param columns Headers of all columns, in source order.
+             */
+            void columnsAvailable(const QString& importTemplateName, const QVariant& context, const QStringList& columns) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief The contents of the source file have been hashed.
+             * Never emitted, as Google Sheets are not read from files.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Google Sheet ID.
+             * @param digest SHA-1 hash of the whole source file.
+             */
+            void contentDigestAvailable(const QString& importTemplateName, const QVariant& context, const QByteArray& digest) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief A batch of rows has been read.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Google Sheet ID.
+             * @param rows Rows that have been read, in source order.
+             */
+            void rowsAvailable(const QString& importTemplateName, const QVariant& context, const RecordImportRowList& rows) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief Importing records asynchronously has finished, and all rows have been passed.
              * @param importTemplateName Name of the template that was used for importing the record data.
              * @param context Google Sheet ID.
-             * @param data Imported records and their field values.
              */
-            void dataAvailable(const QString& importTemplateName, const QVariant& context, const QMap<QString, RecordFieldValueMap>& data) const Q_DECL_OVERRIDE;
+            void dataComplete(const QString& importTemplateName, const QVariant& context) const Q_DECL_OVERRIDE;
 
             /**
              * @brief Importing records asynchronously has failed.
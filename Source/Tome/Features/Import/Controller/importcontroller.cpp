@@ -2,22 +2,72 @@
 
 using namespace Tome;
 
+#include <stdexcept>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
 #include <QFileInfo>
 
 #include "recorddatasource.h"
 #include "csvrecorddatasource.h"
 #include "googlesheetsrecorddatasource.h"
+#include "recordimportfingerprintserializer.h"
 #include "xlsxrecorddatasource.h"
 #include "../../Fields/Controller/fielddefinitionscontroller.h"
+#include "../../Fields/Model/fielddefinition.h"
 #include "../../Records/Controller/recordscontroller.h"
+#include "../../Records/Controller/Commands/importrecordscommand.h"
 #include "../../Types/Controller/typescontroller.h"
+#include "../../Undo/Controller/undocontroller.h"
+#include "../../../Util/stringreplacer.h"
+
 
+const QString ImportController::FingerprintFileExtension = ".tomeimportcache";
 
-ImportController::ImportController(FieldDefinitionsController& fieldDefinitionsController, RecordsController& recordsController, TypesController& typesController)
+
+ImportController::ImportController(FieldDefinitionsController& fieldDefinitionsController,
+                                   RecordsController& recordsController,
+                                   TypesController& typesController,
+                                   UndoController& undoController)
     : fieldDefinitionsController(fieldDefinitionsController),
       recordsController(recordsController),
-      typesController(typesController)
+      typesController(typesController),
+      undoController(undoController)
 {
+    // Allow passing rows from worker threads.
+    qRegisterMetaType<RecordImportRowList>("RecordImportRowList");
+
+    // Changes to records while importing would be overwritten by the import.
+    connect(&this->recordsController,
+            SIGNAL(recordAdded(const QVariant&, const QString&, const QVariant&)),
+            SLOT(onRecordsChanged()));
+
+    connect(&this->recordsController,
+            SIGNAL(recordFieldsChanged(const QVariant&)),
+            SLOT(onRecordsChanged()));
+
+    connect(&this->recordsController,
+            SIGNAL(recordRemoved(const QVariant&)),
+            SLOT(onRecordsChanged()));
+
+    connect(&this->recordsController,
+            SIGNAL(recordReparented(const QVariant&, const QVariant&, const QVariant&)),
+            SLOT(onRecordsChanged()));
+
+    connect(&this->recordsController,
+            SIGNAL(recordUpdated(const QVariant&, const QString&, const QString&, const QVariant&, const QString&, const QString&)),
+            SLOT(onRecordsChanged()));
+
+    connect(&this->recordsController,
+            SIGNAL(recordSetsChanged()),
+            SLOT(onRecordsChanged()));
+}
+
+ImportController::~ImportController()
+{
+    // Wake up and stop workers, so the application doesn't wait for them on exit.
+    this->abortImport();
 }
 
 void ImportController::addRecordImportTemplate(const RecordTableImportTemplate& importTemplate)
@@ -31,6 +81,22 @@ void ImportController::addRecordImportTemplate(const RecordTableImportTemplate&
     emit this->importTemplatesChanged();
 }
 
+void ImportController::cancelImport()
+{
+    if (!this->isImporting())
+    {
+        return;
+    }
+
+    qInfo("Cancelling import.");
+
+    this->abortImport();
+
+    // Hide progress bar.
+    emit this->progressChanged(QString(), QString(), 1, 1);
+    emit this->importFinished();
+}
+
 const RecordTableImportTemplate ImportController::getRecordTableImportTemplate(const QString& name) const
 {
     for (RecordTableImportTemplateList::iterator it = this->model->begin();
@@ -55,49 +121,181 @@ const RecordTableImportTemplateList ImportController::getRecordTableImportTempla
 
 void ImportController::importRecords(const RecordTableImportTemplate& importTemplate, const QVariant& context)
 {
-    qInfo(qUtf8Printable(QString("Importing data from %1 with import template %2.")
-             .arg(context.toString(), importTemplate.name)));
+    this->importRecords(RecordTableImportTemplateList() << importTemplate, QVariantList() << context);
+}
+
+void ImportController::importRecords(const RecordTableImportTemplateList& importTemplates, const QVariantList& contexts)
+{
+    if (this->isImporting())
+    {
+        emit this->importError(tr("Another import is still in progress."));
+        return;
+    }
 
-    // Create data source.
-    RecordDataSource* dataSource;
+    if (importTemplates.count() != contexts.count())
+    {
+        emit this->importError(tr("Each import template requires exactly one source to import from."));
+        return;
+    }
 
-    switch (importTemplate.sourceType)
+    if (this->recordsController.getRecordSetNames().isEmpty())
     {
-        case TableType::Csv:
-            dataSource = new CsvRecordDataSource();
-            break;
+        emit this->importError(tr("Please add a record set to import records into."));
+        return;
+    }
 
-        case TableType::GoogleSheets:
-            dataSource = new GoogleSheetsRecordDataSource();
-            break;
+    // Fingerprint all sources, comparing them to the previous import of the same sources with the same templates.
+    QStringList fingerprintKeyParts;
 
-        case TableType::Xlsx:
-            dataSource = new XlsxRecordDataSource();
-            break;
+    for (int i = 0; i < importTemplates.count(); ++i)
+    {
+        fingerprintKeyParts << importTemplates[i].name << QFileInfo(contexts[i].toString()).absoluteFilePath();
+    }
 
-        default:
+    const QString fingerprintKey = fingerprintKeyParts.join('\n');
+    const RecordImportFingerprintCacheEntry previousEntry = this->loadFingerprints().entries.value(fingerprintKey);
+    const bool hasPreviousEntry = !importTemplates.isEmpty() && previousEntry.fingerprints.count() == importTemplates.count();
+
+    QList<RecordImportFingerprint> fingerprints;
+    bool skipIfUnchanged = hasPreviousEntry;
+    bool sourcesUnchanged = hasPreviousEntry;
+
+    for (int i = 0; i < importTemplates.count(); ++i)
+    {
+        const RecordImportFingerprint* previousFingerprint = hasPreviousEntry ? &previousEntry.fingerprints[i] : nullptr;
+        const RecordImportFingerprint fingerprint =
+                this->computeFingerprint(importTemplates[i], contexts[i], previousFingerprint);
+
+        skipIfUnchanged = skipIfUnchanged &&
+                !fingerprint.sourcePath.isEmpty() &&
+                fingerprint.templateDigest == previousFingerprint->templateDigest;
+
+        sourcesUnchanged = sourcesUnchanged &&
+                !fingerprint.contentDigest.isEmpty() &&
+                fingerprint.contentDigest == previousFingerprint->contentDigest;
+
+        fingerprints << fingerprint;
+    }
+
+    // Importing the same data into the records it has resulted in before can't change anything.
+    skipIfUnchanged = skipIfUnchanged && previousEntry.recordsDigest == this->computeRecordsDigest();
+
+    if (skipIfUnchanged && sourcesUnchanged)
+    {
+        qInfo("Skipping import, as neither sources nor records have changed since the last import.");
+
+        emit this->importStarted();
+        emit this->importFinished();
+        return;
+    }
+
+    // Create data sources.
+    QList<RecordDataSource*> dataSources;
+
+    for (const RecordTableImportTemplate& importTemplate : importTemplates)
+    {
+        RecordDataSource* dataSource = this->createDataSource(importTemplate.sourceType);
+
+        if (dataSource == nullptr)
+        {
+            qDeleteAll(dataSources);
             emit this->importError(tr("Unknown import type."));
             return;
+        }
+
+        dataSources << dataSource;
+    }
+
+    // Prepare import.
+    this->currentImport.reset(new RecordImport());
+
+    RecordImport& import = *this->currentImport;
+    import.recordSetName = this->recordsController.getRecordSetNames().first();
+    import.fingerprintKey = fingerprintKey;
+    import.previousRecordsDigest = previousEntry.recordsDigest;
+    import.skipIfUnchanged = skipIfUnchanged;
+
+    QStringList importTemplateNames;
+
+    for (int i = 0; i < importTemplates.count(); ++i)
+    {
+        const RecordTableImportTemplate& importTemplate = importTemplates[i];
+
+        qInfo(qUtf8Printable(QString("Importing data from %1 with import template %2.")
+                 .arg(contexts[i].toString(), importTemplate.name)));
+
+        ImportSource source;
+        source.importTemplate = importTemplate;
+        source.stringReplacer = StringReplacer(importTemplate.stringReplacementMap);
+        source.dataSource = dataSources[i];
+        source.fingerprint = fingerprints[i];
+        source.previousContentDigest = hasPreviousEntry ? previousEntry.fingerprints[i].contentDigest : QByteArray();
+
+        import.sources << source;
+        importTemplateNames << importTemplate.name;
+
+        this->dataSourceIndices.insert(dataSources[i], i);
     }
 
-    // Read data from source.
-    connect(dataSource,
-            SIGNAL(dataAvailable(const QString&, const QVariant&, const QMap<QString,RecordFieldValueMap>&)),
-            SLOT(onDataAvailable(const QString&, const QVariant&, const QMap<QString,RecordFieldValueMap>&)));
+    import.name = importTemplateNames.join(", ");
+
+    // Index existing records by id once, instead of searching all records for every row.
+    // Copies are cheap, as field values are implicitly shared.
+    for (const RecordSet& recordSet : this->recordsController.getRecordSets())
+    {
+        for (const Record& record : recordSet.records)
+        {
+            import.recordIndex.insert(record.id.toString(), record);
+        }
+    }
+
+    // Read data from sources.
+    for (RecordDataSource* dataSource : dataSources)
+    {
+        connect(dataSource,
+                SIGNAL(columnsAvailable(const QString&, const QVariant&, const QStringList&)),
+                SLOT(onColumnsAvailable(const QString&, const QVariant&, const QStringList&)));
+
+        connect(dataSource,
+                SIGNAL(contentDigestAvailable(const QString&, const QVariant&, const QByteArray&)),
+                SLOT(onContentDigestAvailable(const QString&, const QVariant&, const QByteArray&)));
+
+        connect(dataSource,
+                SIGNAL(rowsAvailable(const QString&, const QVariant&, const RecordImportRowList&)),
+                SLOT(onRowsAvailable(const QString&, const QVariant&, const RecordImportRowList&)));
+
+        connect(dataSource,
+                SIGNAL(dataComplete(const QString&, const QVariant&)),
+                SLOT(onDataComplete(const QString&, const QVariant&)));
 
-    connect(dataSource,
-            SIGNAL(dataUnavailable(const QString&, const QVariant&, const QString&)),
-            SLOT(onDataUnavailable(const QString&, const QVariant&, const QString&)));
+        connect(dataSource,
+                SIGNAL(dataUnavailable(const QString&, const QVariant&, const QString&)),
+                SLOT(onDataUnavailable(const QString&, const QVariant&, const QString&)));
 
-    connect(dataSource,
-            SIGNAL(progressChanged(const QString, const QString, const int, const int)),
-            SLOT(onProgressChanged(const QString, const QString, const int, const int)));
+        connect(dataSource,
+                SIGNAL(progressChanged(const QString, const QString, const int, const int)),
+                SLOT(onProgressChanged(const QString, const QString, const int, const int)));
+    }
 
     // Notify listeners.
     emit this->importStarted();
 
-    // Start import.
-    dataSource->importData(importTemplate, context);
+    if (importTemplates.isEmpty())
+    {
+        this->finishImport();
+        return;
+    }
+
+    // Start reading all sources at once. File sources are read on worker threads.
+    for (int i = 0; i < dataSources.count() && this->isImporting(); ++i)
+    {
+        dataSources[i]->importData(importTemplates[i], contexts[i]);
+    }
+}
+
+bool ImportController::isImporting() const
+{
+    return !this->currentImport.isNull();
 }
 
 bool ImportController::removeImportTemplate(const QString& name)
@@ -127,190 +325,717 @@ void ImportController::setRecordTableImportTemplates(RecordTableImportTemplateLi
     this->model = &importTemplates;
 }
 
-void ImportController::onDataAvailable(const QString& importTemplateName, const QVariant& context, const QMap<QString, RecordFieldValueMap>& data) const
+void ImportController::setProjectFilePath(const QString& projectFilePath)
+{
+    this->fingerprintFilePath = projectFilePath.isEmpty() ? QString() : projectFilePath + FingerprintFileExtension;
+}
+
+void ImportController::onColumnsAvailable(const QString& importTemplateName, const QVariant& context, const QStringList& columns)
 {
-    // Setup parameters.
-    const RecordTableImportTemplate& importTemplate = this->getRecordTableImportTemplate(importTemplateName);
-    const QStringList& recordSetNames = this->recordsController.getRecordSetNames();
-    const QString& recordSetName = recordSetNames.first();
+    Q_UNUSED(importTemplateName)
+    Q_UNUSED(context)
+
+    if (!this->dataSourceIndices.contains(this->sender()))
+    {
+        return;
+    }
 
-    QString contextName;
+    ImportSource& source = this->currentImport->sources[this->dataSourceIndices[this->sender()]];
+    const RecordTableImportTemplate& importTemplate = source.importTemplate;
 
-    switch (importTemplate.sourceType)
+    // Resolve all columns once, instead of for every row.
+    QStringList unknownFieldIds;
+    source.columns.resize(columns.count());
+
+    for (int i = 0; i < columns.count(); ++i)
     {
-        case TableType::Csv:
-        case TableType::Xlsx:
+        const QString& header = columns[i];
+        ImportColumn& column = source.columns[i];
+
+        if (header == importTemplate.displayNameColumn)
         {
-            QFileInfo sourceFile = QFileInfo(context.toString());
-            contextName = sourceFile.fileName();
-            break;
+            source.displayNameColumnIndex = i;
+        }
+
+        if (header == importTemplate.editorIconFieldIdColumn)
+        {
+            source.editorIconFieldIdColumnIndex = i;
+        }
+
+        if (header == importTemplate.idColumn)
+        {
+            continue;
+        }
+
+        // Check if column is mapped.
+        column.fieldId = importTemplate.columnMap.value(header, header);
+
+        if (!this->fieldDefinitionsController.hasFieldDefinition(column.fieldId))
+        {
+            unknownFieldIds << column.fieldId;
+            ++source.skippedColumnCount;
+            continue;
+        }
+
+        // Check if conversion to list is necessary.
+        const FieldDefinition& field = this->fieldDefinitionsController.getFieldDefinition(column.fieldId);
+        bool isList = this->typesController.isCustomType(field.fieldType) && this->typesController.getCustomType(field.fieldType).isList();
+
+        column.conversion = isList ? ConversionList : ConversionNone;
+        column.replaceStrings = !source.stringReplacer.isEmpty();
+        column.skip = false;
+    }
+
+    // Report unknown columns once.
+    if (!unknownFieldIds.isEmpty())
+    {
+        qWarning(qUtf8Printable(QString("Skipping unknown fields: %1").arg(unknownFieldIds.join(", "))));
+    }
+}
+
+void ImportController::onContentDigestAvailable(const QString& importTemplateName, const QVariant& context, const QByteArray& digest)
+{
+    Q_UNUSED(importTemplateName)
+    Q_UNUSED(context)
+
+    if (!this->dataSourceIndices.contains(this->sender()))
+    {
+        return;
+    }
+
+    RecordImport& import = *this->currentImport;
+    import.sources[this->dataSourceIndices[this->sender()]].fingerprint.contentDigest = digest;
+
+    if (!import.skipIfUnchanged)
+    {
+        return;
+    }
+
+    // Check if all sources are unchanged, waiting for the remaining ones to be hashed.
+    for (const ImportSource& source : import.sources)
+    {
+        if (source.fingerprint.contentDigest.isEmpty())
+        {
+            return;
+        }
+
+        if (source.fingerprint.contentDigest != source.previousContentDigest)
+        {
+            import.skipIfUnchanged = false;
+            return;
+        }
+    }
+
+    // Importing the same data into the records it has resulted in before can't change anything.
+    qInfo("Skipping import, as neither sources nor records have changed since the last import.");
+
+    // Remember new modification times, to not hash the same sources again.
+    RecordImportFingerprintCacheEntry fingerprintEntry;
+    fingerprintEntry.recordsDigest = import.previousRecordsDigest;
+
+    for (const ImportSource& source : import.sources)
+    {
+        fingerprintEntry.fingerprints << source.fingerprint;
+    }
+
+    const QString fingerprintKey = import.fingerprintKey;
+    this->abortImport();
+
+    if (!this->fingerprintFilePath.isEmpty())
+    {
+        RecordImportFingerprintCache fingerprintCache = this->loadFingerprints();
+        fingerprintCache.entries.insert(fingerprintKey, fingerprintEntry);
+        this->saveFingerprints(fingerprintCache);
+    }
+
+    // Hide progress bar.
+    emit this->progressChanged(QString(), QString(), 1, 1);
+    emit this->importFinished();
+}
+
+void ImportController::onDataComplete(const QString& importTemplateName, const QVariant& context)
+{
+    Q_UNUSED(importTemplateName)
+    Q_UNUSED(context)
+
+    if (!this->dataSourceIndices.contains(this->sender()))
+    {
+        return;
+    }
+
+    this->currentImport->sources[this->dataSourceIndices[this->sender()]].complete = true;
+    this->advanceImport();
+}
+
+void ImportController::onDataUnavailable(const QString& importTemplateName, const QVariant& context, const QString& error)
+{
+    Q_UNUSED(importTemplateName)
+    Q_UNUSED(context)
+
+    if (!this->dataSourceIndices.contains(this->sender()))
+    {
+        return;
+    }
+
+    // Discard changes of all sources, as applying only some of them could leave records inconsistent.
+    this->abortImport();
+
+    // Show error message.
+    emit this->importError(error);
+
+    // Hide progress bar.
+    emit this->progressChanged(QString(), QString(), 1, 1);
+    emit this->importFinished();
+}
+
+void ImportController::onProgressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const
+{
+    // Ignore progress of sources that have been cancelled.
+    if (!this->dataSourceIndices.contains(this->sender()))
+    {
+        return;
+    }
+
+    emit this->progressChanged(title, text, currentValue, maximumValue);
+}
+
+void ImportController::onRecordsChanged()
+{
+    // Our own changes are applied after the import has finished.
+    if (!this->isImporting())
+    {
+        return;
+    }
+
+    qWarning("Records have been changed while importing, cancelling import.");
+
+    this->abortImport();
+
+    // Show error message.
+    emit this->importError(tr("Records have been changed while importing. Please import again."));
+
+    // Hide progress bar.
+    emit this->progressChanged(QString(), QString(), 1, 1);
+    emit this->importFinished();
+}
+
+void ImportController::onRowsAvailable(const QString& importTemplateName, const QVariant& context, const RecordImportRowList& rows)
+{
+    Q_UNUSED(importTemplateName)
+    Q_UNUSED(context)
+
+    // Ignore rows of cancelled imports. Their data sources may have been deleted already.
+    RecordDataSource* dataSource = static_cast<RecordDataSource*>(this->sender());
+
+    if (!this->dataSourceIndices.contains(dataSource))
+    {
+        return;
+    }
+
+    RecordImport& import = *this->currentImport;
+    const int sourceIndex = this->dataSourceIndices[dataSource];
+    ImportSource& source = import.sources[sourceIndex];
+
+    if (sourceIndex != import.currentSourceIndex)
+    {
+        // Keep rows until all preceding sources have been read, to compare them in order.
+        // Data source will be allowed to pass further rows after these have been compared.
+        source.waitingRows += rows;
+        ++source.heldBatchCount;
+        return;
+    }
+
+    for (const RecordImportRow& row : rows)
+    {
+        this->diffRow(import, source, row);
+    }
+
+    // Allow data source to pass further rows.
+    dataSource->releaseRows();
+}
+
+void ImportController::abortImport()
+{
+    if (!this->isImporting())
+    {
+        return;
+    }
+
+    // Stop reading all sources, including those blocked while waiting for their rows to be applied.
+    this->deleteDataSources(*this->currentImport);
+
+    this->currentImport.reset();
+    this->dataSourceIndices.clear();
+}
+
+void ImportController::advanceImport()
+{
+    RecordImport& import = *this->currentImport;
+
+    while (import.currentSourceIndex < import.sources.count())
+    {
+        ImportSource& source = import.sources[import.currentSourceIndex];
+
+        // Compare rows read while waiting for preceding sources.
+        for (const RecordImportRow& row : source.waitingRows)
+        {
+            this->diffRow(import, source, row);
+        }
+
+        source.waitingRows.clear();
+
+        // Allow data source to pass further rows.
+        for (; source.heldBatchCount > 0; --source.heldBatchCount)
+        {
+            source.dataSource->releaseRows();
+        }
+
+        if (!source.complete)
+        {
+            return;
+        }
+
+        ++import.currentSourceIndex;
+    }
+
+    this->finishImport();
+}
+
+RecordImportFingerprint ImportController::computeFingerprint(const RecordTableImportTemplate& importTemplate,
+                                                             const QVariant& context,
+                                                             const RecordImportFingerprint* previousFingerprint) const
+{
+    RecordImportFingerprint fingerprint;
+    fingerprint.importTemplateName = importTemplate.name;
+    fingerprint.templateDigest = this->computeTemplateDigest(importTemplate);
+
+    // Only files can be fingerprinted. Other sources are always imported.
+    if (importTemplate.sourceType != TableType::Csv && importTemplate.sourceType != TableType::Xlsx)
+    {
+        return fingerprint;
+    }
+
+    const QFileInfo fileInfo(context.toString());
+
+    if (!fileInfo.isFile())
+    {
+        // Let data source report the error.
+        return fingerprint;
+    }
+
+    fingerprint.sourcePath = fileInfo.absoluteFilePath();
+    fingerprint.size = fileInfo.size();
+    fingerprint.lastModified = fileInfo.lastModified();
+
+    // Don't read files again that seem untouched. Others are hashed by their data source while reading them,
+    // as files may have been touched without changing them (e.g. by exporting them again).
+    if (previousFingerprint != nullptr &&
+            previousFingerprint->sourcePath == fingerprint.sourcePath &&
+            previousFingerprint->size == fingerprint.size &&
+            previousFingerprint->lastModified == fingerprint.lastModified)
+    {
+        fingerprint.contentDigest = previousFingerprint->contentDigest;
+    }
+
+    return fingerprint;
+}
+
+QByteArray ImportController::computeRecordsDigest() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    // Hash everything an import compares and changes.
+    for (const RecordSet& recordSet : this->recordsController.getRecordSets())
+    {
+        hash.addData(recordSet.name.toUtf8());
+
+        for (const Record& record : recordSet.records)
+        {
+            QByteArray buffer;
+            QDataStream stream(&buffer, QIODevice::WriteOnly);
+            stream.setVersion(QDataStream::Qt_5_0);
+
+            stream << record.id.toString()
+                   << record.displayName
+                   << record.editorIconFieldId
+                   << record.parentId.toString()
+                   << record.fieldValues;
+
+            hash.addData(buffer);
         }
+    }
+
+    return hash.result();
+}
+
+QByteArray ImportController::computeTemplateDigest(const RecordTableImportTemplate& importTemplate) const
+{
+    QByteArray buffer;
+    QDataStream stream(&buffer, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Hash everything that affects how rows are imported.
+    stream << APP_VERSION
+           << importTemplate.columnMap
+           << importTemplate.displayNameColumn
+           << importTemplate.editorIconFieldIdColumn
+           << importTemplate.idColumn
+           << importTemplate.ignoredIds
+           << importTemplate.parameters
+           << importTemplate.rootRecordId
+           << static_cast<qint32>(importTemplate.sourceType)
+           << importTemplate.stringReplacementMap;
+
+    // Hash field definitions, which decide which columns are imported, and whether they are converted to lists.
+    for (const FieldDefinition& field : this->fieldDefinitionsController.getFieldDefinitions())
+    {
+        const bool isList = this->typesController.isCustomType(field.fieldType) &&
+                this->typesController.getCustomType(field.fieldType).isList();
+
+        stream << field.id << field.fieldType << isList;
+    }
+
+    return QCryptographicHash::hash(buffer, QCryptographicHash::Sha1);
+}
+
+RecordDataSource* ImportController::createDataSource(TableType::TableType sourceType) const
+{
+    switch (sourceType)
+    {
+        case TableType::Csv:
+            return new CsvRecordDataSource();
 
         case TableType::GoogleSheets:
-            contextName = context.toString();
-            break;
+            return new GoogleSheetsRecordDataSource();
+
+        case TableType::Xlsx:
+            return new XlsxRecordDataSource();
 
         default:
-            contextName = tr("Unknown");
-            break;
+            return nullptr;
+    }
+}
+
+void ImportController::deleteDataSources(const RecordImport& import) const
+{
+    for (const ImportSource& source : import.sources)
+    {
+        // Wait for workers still accessing the data source.
+        source.dataSource->stop();
+
+        // Data sources reading on this thread may still be emitting the signal that caused this.
+        source.dataSource->deleteLater();
     }
+}
 
-    // Update records.
-    int recordsAdded = 0;
-    int fieldsUpdated = 0;
-    int fieldsSkipped = 0;
-    int fieldsUpToDate = 0;
+void ImportController::diffRow(RecordImport& import, const ImportSource& source, const RecordImportRow& row) const
+{
+    const RecordTableImportTemplate& importTemplate = source.importTemplate;
 
-    // Show progress bar.
-    QString progressBarTitle = tr("Importing %1 With %2").arg(contextName, importTemplateName);
-    int index = 0;
+    // Get record.
+    const QString& recordId = row.recordId;
+    const QVariantList& values = row.values;
+
+    if (recordId.isEmpty())
+    {
+        return;
+    }
+
+    // Get record display name and editor icon, if available.
+    QVariant recordDisplayName;
+    QVariant recordEditorIconFieldId;
+
+    if (source.displayNameColumnIndex >= 0 && source.displayNameColumnIndex < values.count())
+    {
+        recordDisplayName = values[source.displayNameColumnIndex];
+    }
+    else
+    {
+        recordDisplayName = recordId;
+    }
 
-    for (QMap<QString, RecordFieldValueMap>::const_iterator itRecords = data.cbegin();
-         itRecords != data.cend();
-         ++itRecords)
+    if (source.editorIconFieldIdColumnIndex >= 0 && source.editorIconFieldIdColumnIndex < values.count())
     {
-        ++index;
+        recordEditorIconFieldId = values[source.editorIconFieldIdColumnIndex];
+    }
 
-        // Get record.
-        const QString& recordId = itRecords.key();
-        const RecordFieldValueMap& newRecordFieldValues = itRecords.value();
+    // Get current state of the record, including changes by previous rows.
+    const Record* currentRecord = this->findRecord(import, recordId);
+    Record record;
+    bool recordChanged = false;
 
-        if (recordId.isEmpty())
+    if (currentRecord == nullptr)
+    {
+        // Make sure the parent record exists.
+        if (this->findRecord(import, importTemplate.rootRecordId) == nullptr)
         {
-            continue;
+            Record rootRecord;
+            rootRecord.id = importTemplate.rootRecordId;
+            rootRecord.displayName = importTemplate.rootRecordId;
+            rootRecord.recordSetName = import.recordSetName;
+
+            import.pendingRecords.insert(importTemplate.rootRecordId, rootRecord);
+            import.addedRecordIds << importTemplate.rootRecordId;
+            ++import.recordsAdded;
         }
 
-        // Update progress bar.
-        emit this->progressChanged(progressBarTitle, recordId, index, data.count());
+        record.id = recordId;
+        record.displayName = recordDisplayName.toString();
+        record.editorIconFieldId = recordEditorIconFieldId.toString();
+        record.parentId = importTemplate.rootRecordId;
+        record.recordSetName = import.recordSetName;
 
-        // Get record display name and editor icon, if available.
-        QVariant recordDisplayName;
-        QVariant recordEditorIconFieldId;
+        import.addedRecordIds << recordId;
+        ++import.recordsAdded;
+    }
+    else
+    {
+        record = *currentRecord;
 
-        if (newRecordFieldValues.contains(importTemplate.displayNameColumn))
+        if (recordDisplayName.isValid() && record.displayName != recordDisplayName.toString())
         {
-            recordDisplayName = newRecordFieldValues[importTemplate.displayNameColumn];
+            record.displayName = recordDisplayName.toString();
+            recordChanged = true;
         }
-        else
+
+        if (recordEditorIconFieldId.isValid() && record.editorIconFieldId != recordEditorIconFieldId.toString())
         {
-            recordDisplayName = recordId;
+            record.editorIconFieldId = recordEditorIconFieldId.toString();
+            recordChanged = true;
         }
+    }
+
+    // Get current record field values.
+    const RecordFieldValueMap inheritedFieldValues = this->getInheritedFieldValues(import, record);
 
-        if (newRecordFieldValues.contains(importTemplate.editorIconFieldIdColumn))
+    const int columnCount = qMin(values.count(), source.columns.count());
+    import.fieldsSkipped += source.skippedColumnCount;
+
+    for (int i = 0; i < columnCount; ++i)
+    {
+        const ImportColumn& column = source.columns[i];
+
+        if (column.skip)
         {
-            recordEditorIconFieldId = newRecordFieldValues[importTemplate.editorIconFieldIdColumn];
+            continue;
         }
 
-        // Check if need to add new record.
-        if (!this->recordsController.hasRecord(recordId))
+        // Get field.
+        const QString& fieldId = column.fieldId;
+        QVariant fieldValue = values[i];
+
+        // Apply string replacement.
+        if (column.replaceStrings)
         {
-            // make sure the parent record exists.
-            if (!this->recordsController.hasRecord(importTemplate.rootRecordId))
+            QString fieldValueString = fieldValue.toString();
+
+            if (source.stringReplacer.replace(fieldValueString))
             {
-                this->recordsController.addRecord(importTemplate.rootRecordId, importTemplate.rootRecordId, QString(), QStringList(), recordSetName);
-                ++recordsAdded;
+                fieldValue = fieldValueString;
             }
-            this->recordsController.addRecord(recordId, recordDisplayName.toString(), recordEditorIconFieldId.toString(), QStringList(), recordSetName);
-            this->recordsController.reparentRecord(recordId, importTemplate.rootRecordId);
-            ++recordsAdded;
         }
-        else
+
+        // Convert to list if necessary.
+        if (column.conversion == ConversionList)
         {
-            qInfo(qUtf8Printable(QString("Updating record %1.").arg(recordId)));
+            fieldValue = fieldValue.toString().split(",");
+        }
 
-            if (recordDisplayName.isValid())
-            {
-                this->recordsController.setRecordDisplayName(recordId, recordDisplayName.toString());
-            }
+        // Check if needs update.
+        const bool hasOwnValue = record.fieldValues.contains(fieldId);
+        const bool hasValue = hasOwnValue || inheritedFieldValues.contains(fieldId);
+        const QVariant oldFieldValue = hasOwnValue ? record.fieldValues[fieldId] : inheritedFieldValues.value(fieldId);
 
-            if (recordEditorIconFieldId.isValid())
-            {
-                this->recordsController.setRecordEditorIconFieldId(recordId, recordEditorIconFieldId.toString());
-            }
+        if (hasValue && oldFieldValue == fieldValue)
+        {
+            ++import.fieldsUpToDate;
+            continue;
         }
 
-        // Get current record field values.
-        const RecordFieldValueMap oldRecordFieldValues = this->recordsController.getRecordFieldValues(recordId);
+        // Don't store values equal to the inherited ones.
+        if (inheritedFieldValues.value(fieldId) == fieldValue)
+        {
+            record.fieldValues.remove(fieldId);
+        }
+        else
+        {
+            record.fieldValues[fieldId] = fieldValue;
+        }
 
-        for (RecordFieldValueMap::const_iterator itFields = newRecordFieldValues.cbegin();
-             itFields != newRecordFieldValues.cend();
-             ++itFields)
+        recordChanged = true;
+        ++import.fieldsUpdated;
+    }
+
+    // Remember changes.
+    if (currentRecord == nullptr || recordChanged)
+    {
+        if (currentRecord != nullptr && !import.pendingRecords.contains(recordId))
         {
-            // Get field.
-            QString fieldId = itFields.key();
-            QVariant fieldValue = itFields.value();
+            import.updatedRecordIds << recordId;
+        }
 
-            // Check if field is mapped.
-            if (importTemplate.columnMap.contains(fieldId))
-            {
-                fieldId = importTemplate.columnMap[fieldId];
-            }
+        import.pendingRecords.insert(recordId, record);
+    }
+}
 
-            if (!this->fieldDefinitionsController.hasFieldDefinition(fieldId))
-            {
-                qWarning(qUtf8Printable(QString("Skipping unknown field: %1").arg(fieldId)));
-                ++fieldsSkipped;
-                continue;
-            }
+const Record* ImportController::findRecord(const RecordImport& import, const QString& recordId) const
+{
+    QHash<QString, Record>::const_iterator it = import.pendingRecords.constFind(recordId);
 
-            // Apply string replacement.
-            for (auto itStringReplacementMap = importTemplate.stringReplacementMap.cbegin();
-                 itStringReplacementMap != importTemplate.stringReplacementMap.cend();
-                 ++itStringReplacementMap)
-            {
-                QString fieldValueString = fieldValue.toString();
+    if (it != import.pendingRecords.cend())
+    {
+        return &it.value();
+    }
 
-                if (fieldValueString.contains(itStringReplacementMap.key()))
-                {
-                    fieldValue = fieldValueString.replace(itStringReplacementMap.key(), itStringReplacementMap.value());
-                }
-            }
+    it = import.recordIndex.constFind(recordId);
+    return it != import.recordIndex.cend() ? &it.value() : nullptr;
+}
 
-            // Convert to list if necessary.
-            const FieldDefinition& field = this->fieldDefinitionsController.getFieldDefinition(fieldId);
-            bool isList = this->typesController.isCustomType(field.fieldType) && this->typesController.getCustomType(field.fieldType).isList();
+void ImportController::finishImport()
+{
+    QScopedPointer<RecordImport> import(this->currentImport.take());
+    this->dataSourceIndices.clear();
+    this->deleteDataSources(*import);
 
-            if (isList)
-            {
-                fieldValue = fieldValue.toString().split(",");
-            }
+    // Collect changes.
+    RecordList addedRecords;
+    RecordList oldRecords;
+    RecordList newRecords;
 
-            // Check if needs update.
-            if (oldRecordFieldValues.contains(fieldId) && oldRecordFieldValues[fieldId] == fieldValue)
-            {
-                ++fieldsUpToDate;
-            }
-            else
-            {
-                this->recordsController.updateRecordFieldValue(recordId, fieldId, fieldValue);
-                ++fieldsUpdated;
-            }
+    for (const QString& recordId : import->addedRecordIds)
+    {
+        addedRecords << import->pendingRecords[recordId];
+    }
+
+    for (const QString& recordId : import->updatedRecordIds)
+    {
+        oldRecords << import->recordIndex.value(recordId);
+        newRecords << import->pendingRecords[recordId];
+    }
+
+    // Apply all changes at once.
+    if (!addedRecords.isEmpty() || !newRecords.isEmpty())
+    {
+        ImportRecordsCommand* command = new ImportRecordsCommand(this->recordsController,
+                                                                 import->name,
+                                                                 addedRecords,
+                                                                 oldRecords,
+                                                                 newRecords);
+        this->undoController.doCommand(command);
+    }
+
+    qInfo(qUtf8Printable(QString("Import finished. %1 new records added, %2 records updated. %3 field values updated, %4 skipped, %5 up-to-date.")
+          .arg(QString::number(import->recordsAdded),
+               QString::number(newRecords.count()),
+               QString::number(import->fieldsUpdated),
+               QString::number(import->fieldsSkipped),
+               QString::number(import->fieldsUpToDate))));
+
+    // Remember sources and resulting records, to skip importing the same data again.
+    RecordImportFingerprintCacheEntry fingerprintEntry;
+
+    for (const ImportSource& source : import->sources)
+    {
+        if (source.fingerprint.contentDigest.isEmpty())
+        {
+            fingerprintEntry.fingerprints.clear();
+            break;
         }
+
+        fingerprintEntry.fingerprints << source.fingerprint;
     }
 
-    qInfo(qUtf8Printable(QString("Import finished. %1 new records added. %2 field values updated, %3 skipped, %4 up-to-date.")
-          .arg(QString::number(recordsAdded),
-               QString::number(fieldsUpdated),
-               QString::number(fieldsSkipped),
-               QString::number(fieldsUpToDate))));
+    if (!fingerprintEntry.fingerprints.isEmpty() && !this->fingerprintFilePath.isEmpty())
+    {
+        fingerprintEntry.recordsDigest = this->computeRecordsDigest();
+
+        RecordImportFingerprintCache fingerprintCache = this->loadFingerprints();
+        fingerprintCache.entries.insert(import->fingerprintKey, fingerprintEntry);
+        this->saveFingerprints(fingerprintCache);
+    }
 
     emit this->importFinished();
 }
 
-void ImportController::onDataUnavailable(const QString& importTemplateName, const QVariant& context, const QString& error) const
+const RecordFieldValueMap ImportController::getInheritedFieldValues(const RecordImport& import, const Record& record) const
 {
-    Q_UNUSED(importTemplateName)
-    Q_UNUSED(context)
+    // Resolve parents.
+    QList<const Record*> ancestors;
+    QVariant parentId = record.parentId;
 
-    // Show error message.
-    emit this->importError(error);
+    while (!parentId.isNull())
+    {
+        const Record* parent = this->findRecord(import, parentId.toString());
 
-    // Hide progress bar.
-    this->onProgressChanged(QString(), QString(), 1, 1);
-    emit this->importFinished();
+        if (parent == nullptr)
+        {
+            break;
+        }
+
+        ancestors << parent;
+        parentId = parent->parentId;
+    }
+
+    // Build field value map, starting at the root.
+    RecordFieldValueMap fieldValues;
+
+    for (int i = ancestors.count() - 1; i >= 0; --i)
+    {
+        const RecordFieldValueMap& ancestorFieldValues = ancestors.at(i)->fieldValues;
+
+        for (RecordFieldValueMap::const_iterator it = ancestorFieldValues.cbegin();
+             it != ancestorFieldValues.cend();
+             ++it)
+        {
+            fieldValues[it.key()] = it.value();
+        }
+    }
+
+    return fieldValues;
 }
 
-void ImportController::onProgressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const
+RecordImportFingerprintCache ImportController::loadFingerprints() const
 {
-    emit this->progressChanged(title, text, currentValue, maximumValue);
+    RecordImportFingerprintCache cache;
+
+    if (this->fingerprintFilePath.isEmpty())
+    {
+        return cache;
+    }
+
+    QFile file(this->fingerprintFilePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        // No previous import.
+        return cache;
+    }
+
+    try
+    {
+        RecordImportFingerprintSerializer serializer;
+        serializer.deserialize(file, cache);
+    }
+    catch (const std::runtime_error& e)
+    {
+        qWarning(qUtf8Printable(QString("Ignoring record import fingerprints %1: %2").arg(this->fingerprintFilePath, e.what())));
+        return RecordImportFingerprintCache();
+    }
+
+    return cache;
+}
+
+void ImportController::saveFingerprints(const RecordImportFingerprintCache& cache) const
+{
+    QFile file(this->fingerprintFilePath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        // Fingerprints are optional - just import all sources again next time.
+        qWarning(qUtf8Printable(QString("Record import fingerprints %1 could not be written.").arg(this->fingerprintFilePath)));
+        return;
+    }
+
+    RecordImportFingerprintSerializer serializer;
+    serializer.serialize(file, cache);
 }
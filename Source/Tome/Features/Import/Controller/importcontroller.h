@@ -1,17 +1,27 @@
 #ifndef IMPORTCONTROLLER_H
 #define IMPORTCONTROLLER_H
 
+#include <QByteArray>
+#include <QHash>
+#include <QScopedPointer>
 #include <QString>
+#include <QStringList>
 #include <QVariant>
+#include <QVector>
 
+#include "../Model/recordimportfingerprintcache.h"
+#include "../Model/recordimportrowlist.h"
 #include "../Model/recordtableimporttemplatelist.h"
-#include "../../Records/Model/recordfieldvaluemap.h"
+#include "../../Records/Model/record.h"
+#include "../../../Util/stringreplacer.h"
 
 namespace Tome
 {
     class FieldDefinitionsController;
+    class RecordDataSource;
     class RecordsController;
     class TypesController;
+    class UndoController;
 
     /**
      * @brief Controller for importing record data.
@@ -26,10 +36,13 @@ namespace Tome
              * @param fieldDefinitionsController Controller for adding, updating and removing field definitions.
              * @param recordsController Controller for adding, updating and removing records.
              * @param typesController Controller for adding, updating and removing custom types.
+             * @param undoController Controller for performing undo-able commands.
              */
             ImportController(FieldDefinitionsController& fieldDefinitionsController,
                              RecordsController& recordsController,
-                             TypesController& typesController);
+                             TypesController& typesController,
+                             UndoController& undoController);
+            ~ImportController();
 
             /**
              * @brief Adds the specified record import template to the project.
@@ -37,6 +50,12 @@ namespace Tome
              */
             void addRecordImportTemplate(const RecordTableImportTemplate& importTemplate);
 
+            /**
+             * @brief Cancels the current import, if any, discarding all changes read so far.
+             * Stops reading all sources as soon as possible, and emits importFinished.
+             */
+            void cancelImport();
+
             /**
              * @brief Gets the record import template with the specified name.
              *
@@ -55,11 +74,40 @@ namespace Tome
 
             /**
              * @brief Begins importing records asynchronously using the specified template.
+             *
+             * Rows are compared to the current records in batches as soon as the data source has read them.
+             * After all rows have been read, all new and changed records are applied at once, as a single undo-able command.
+             *
              * @param importTemplate Template to use for importing the record data.
              * @param context Context to import the data in (e.g. source file name).
              */
             void importRecords(const RecordTableImportTemplate& importTemplate, const QVariant& context);
 
+            /**
+             * @brief Begins importing records asynchronously from multiple sources at once.
+             *
+             * All sources are read in parallel. Their rows are compared to the current records in the passed order,
+             * so later sources win if multiple sources change the same field, no matter which source is read first.
+             * Rows of sources read ahead of their predecessors are kept until all predecessors have been read.
+             * After all sources have been read, all new and changed records are applied at once, as a single undo-able command.
+             * If any source fails, nothing is applied.
+             *
+             * If the same source files have been imported with the same templates before, and neither the files, the templates,
+             * the field definitions nor any records have changed since, the sources are not read again at all.
+             * Files that have been touched since are hashed while reading them, and the import is skipped as soon as
+             * all of them turn out to be unchanged.
+             *
+             * @param importTemplates Templates to use for importing the record data, one for each source.
+             * @param contexts Contexts to import the data in (e.g. source file names), one for each source.
+             */
+            void importRecords(const RecordTableImportTemplateList& importTemplates, const QVariantList& contexts);
+
+            /**
+             * @brief Checks whether an import is currently in progress.
+             * @return true, if an import has been started, but neither finished nor failed yet, and false otherwise.
+             */
+            bool isImporting() const;
+
             /**
              * @brief Removes the record import template with the specified name from the project.
              * @param name Name of the record import template to remove.
@@ -73,6 +121,12 @@ namespace Tome
              */
             void setRecordTableImportTemplates(RecordTableImportTemplateList& importTemplates);
 
+            /**
+             * @brief Sets the project file to keep track of imported source files next to.
+             * @param projectFilePath Absolute path of the project file, or an empty string to not keep track of imported source files.
+             */
+            void setProjectFilePath(const QString& projectFilePath);
+
         signals:
             /**
              * @brief Importing records asynchronously has failed.
@@ -105,16 +159,117 @@ namespace Tome
             void progressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const;
 
         private slots:
-            void onDataAvailable(const QString& importTemplateName, const QVariant& context, const QMap<QString, RecordFieldValueMap>& data) const;
-            void onDataUnavailable(const QString& importTemplateName, const QVariant& context, const QString& error) const;
+            void onColumnsAvailable(const QString& importTemplateName, const QVariant& context, const QStringList& columns);
+            void onContentDigestAvailable(const QString& importTemplateName, const QVariant& context, const QByteArray& digest);
+            void onDataComplete(const QString& importTemplateName, const QVariant& context);
+            void onDataUnavailable(const QString& importTemplateName, const QVariant& context, const QString& error);
             void onProgressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const;
+            void onRecordsChanged();
+            void onRowsAvailable(const QString& importTemplateName, const QVariant& context, const RecordImportRowList& rows);
 
         private:
+            /**
+             * @brief How to convert the values of a column before importing them.
+             */
+            enum ColumnConversion
+            {
+                ConversionNone,
+                ConversionList
+            };
+
+            /**
+             * @brief Handling of a single column of the imported table, resolved once from its header.
+             */
+            struct ImportColumn
+            {
+                QString fieldId;
+                ColumnConversion conversion = ConversionNone;
+                bool replaceStrings = false;
+                bool skip = true;
+            };
+
+            /**
+             * @brief Template, resolved columns and waiting rows of a single source of an import in progress.
+             *
+             * Columns are resolved once from the header row, so rows are imported by column index.
+             * Batches of waiting rows are not released until they have been compared, so sources
+             * read ahead of their predecessors are blocked instead of buffering their whole table.
+             */
+            struct ImportSource
+            {
+                RecordTableImportTemplate importTemplate;
+                RecordDataSource* dataSource = nullptr;
+                StringReplacer stringReplacer;
+
+                QVector<ImportColumn> columns;
+                int displayNameColumnIndex = -1;
+                int editorIconFieldIdColumnIndex = -1;
+                int skippedColumnCount = 0;
+
+                RecordImportFingerprint fingerprint;
+                QByteArray previousContentDigest;
+
+                RecordImportRowList waitingRows;
+                int heldBatchCount = 0;
+                bool complete = false;
+            };
+
+            /**
+             * @brief Sources, pending changes and statistics of an import in progress.
+             *
+             * Existing records are copied and indexed by id once when the import starts, so the import
+             * is not affected by later changes to the project. Records added or changed by previous rows
+             * are kept in pendingRecords until the import has finished.
+             */
+            struct RecordImport
+            {
+                QString name;
+                QString fingerprintKey;
+                QByteArray previousRecordsDigest;
+                bool skipIfUnchanged = false;
+                QString recordSetName;
+
+                QVector<ImportSource> sources;
+                int currentSourceIndex = 0;
+
+                QHash<QString, Record> recordIndex;
+                QHash<QString, Record> pendingRecords;
+                QStringList addedRecordIds;
+                QStringList updatedRecordIds;
+
+                int recordsAdded = 0;
+                int fieldsUpdated = 0;
+                int fieldsSkipped = 0;
+                int fieldsUpToDate = 0;
+            };
+
+            static const QString FingerprintFileExtension;
+
             FieldDefinitionsController& fieldDefinitionsController;
             RecordsController& recordsController;
             TypesController& typesController;
+            UndoController& undoController;
 
             RecordTableImportTemplateList* model;
+            QScopedPointer<RecordImport> currentImport;
+            QHash<const QObject*, int> dataSourceIndices;
+            QString fingerprintFilePath;
+
+            void abortImport();
+            void advanceImport();
+            RecordImportFingerprint computeFingerprint(const RecordTableImportTemplate& importTemplate,
+                                                       const QVariant& context,
+                                                       const RecordImportFingerprint* previousFingerprint) const;
+            QByteArray computeRecordsDigest() const;
+            QByteArray computeTemplateDigest(const RecordTableImportTemplate& importTemplate) const;
+            RecordDataSource* createDataSource(TableType::TableType sourceType) const;
+            void deleteDataSources(const RecordImport& import) const;
+            void diffRow(RecordImport& import, const ImportSource& source, const RecordImportRow& row) const;
+            const Record* findRecord(const RecordImport& import, const QString& recordId) const;
+            void finishImport();
+            const RecordFieldValueMap getInheritedFieldValues(const RecordImport& import, const Record& record) const;
+            RecordImportFingerprintCache loadFingerprints() const;
+            void saveFingerprints(const RecordImportFingerprintCache& cache) const;
     };
 }
 
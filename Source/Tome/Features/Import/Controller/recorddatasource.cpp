@@ -1,11 +1,98 @@
 #include "recorddatasource.h"
 
+#include <QThread>
+#include <QtConcurrent>
+
 using namespace Tome;
 
+
+const int RecordDataSource::BatchSize = 256;
+const int RecordDataSource::MaxPendingBatches = 4;
+
+
 RecordDataSource::RecordDataSource()
+    : pendingBatches(MaxPendingBatches)
 {
+    this->rows.reserve(BatchSize);
 }
 
 RecordDataSource::~RecordDataSource()
 {
 }
+
+void RecordDataSource::cancel()
+{
+    this->cancelled.storeRelease(1);
+
+    // Wake up worker, if it is waiting for listeners to catch up.
+    this->pendingBatches.release();
+}
+
+void RecordDataSource::stop()
+{
+    this->cancel();
+    this->worker.waitForFinished();
+}
+
+void RecordDataSource::releaseRows()
+{
+    this->pendingBatches.release();
+}
+
+void RecordDataSource::addRow(const QString& importTemplateName, const QVariant& context, const RecordImportRow& row)
+{
+    this->rows.append(row);
+
+    if (this->rows.size() >= BatchSize)
+    {
+        this->passRows(importTemplateName, context);
+    }
+}
+
+void RecordDataSource::completeRows(const QString& importTemplateName, const QVariant& context)
+{
+    this->passRows(importTemplateName, context);
+
+    if (this->isCancelled())
+    {
+        return;
+    }
+
+    emit this->dataComplete(importTemplateName, context);
+}
+
+bool RecordDataSource::isCancelled() const
+{
+    return this->cancelled.loadAcquire() != 0;
+}
+
+void RecordDataSource::runWorker(const std::function<void()>& read)
+{
+    this->worker = QtConcurrent::run(read);
+}
+
+void RecordDataSource::passRows(const QString& importTemplateName, const QVariant& context)
+{
+    if (this->rows.isEmpty() || this->isCancelled())
+    {
+        return;
+    }
+
+    // Wait for listeners to catch up. Blocking the thread of the listeners would prevent them from ever doing so.
+    if (QThread::currentThread() != this->thread())
+    {
+        this->pendingBatches.acquire();
+
+        if (this->isCancelled())
+        {
+            // Woken up by cancel.
+            return;
+        }
+    }
+
+    RecordImportRowList batch;
+    batch.swap(this->rows);
+    this->rows.reserve(BatchSize);
+
+    emit this->rowsAvailable(importTemplateName, context, batch);
+}
@@ -1,15 +1,28 @@
 #ifndef RECORDDATASOURCE_H
 #define RECORDDATASOURCE_H
 
-#include <QMap>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QFuture>
+#include <QObject>
+#include <QSemaphore>
+#include <QStringList>
 
+#include <functional>
+
+#include "../Model/recordimportrowlist.h"
 #include "../Model/recordtableimporttemplate.h"
-#include "../../Records/Model/recordfieldvaluemap.h"
 
 namespace Tome
 {
     /**
      * @brief Data source to import records from.
+     *
+     * Rows are passed to listeners in batches while reading, instead of collecting the whole table first.
+     * Data sources may read on a worker thread. In that case, reading blocks while too many batches haven't
+     * been released by listeners yet, so parsing and applying the rows overlap without buffering the whole table.
+     * Data sources reading on their own thread are never blocked.
+     * Reading can be cancelled at any time, which wakes up blocked workers as well.
      */
     class RecordDataSource : public QObject
     {
@@ -22,6 +35,12 @@ namespace Tome
             RecordDataSource();
             virtual ~RecordDataSource();
 
+            /**
+             * @brief Stops reading as soon as possible, without passing any further rows or signaling completion.
+             * Can be called from any thread.
+             */
+            void cancel();
+
             /**
              * @brief Begins importing records asynchronously using the specified template.
              * @param importTemplate Template to use for importing the record data.
@@ -30,12 +49,49 @@ namespace Tome
             virtual void importData(const RecordTableImportTemplate& importTemplate, const QVariant& context) = 0;
 
             /**
-             * @brief Virtual signal emitted as soon as importing records asynchronously has finished.
+             * @brief Cancels reading, and waits for the worker thread reading the data to stop, if any.
+             * Must be called before deleting this data source, as workers access it until they have stopped.
+             */
+            void stop();
+
+            /**
+             * @brief Notifies this data source that a batch of rows passed by rowsAvailable has been applied,
+             * allowing it to pass further batches. Listeners may hold back batches they can't apply yet.
+             */
+            void releaseRows();
+
+            /**
+             * @brief Virtual signal emitted once after the header row has been read, before any rows are passed.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Context the data is imported in (e.g. source file name).
+             * @param columns Headers of all columns, in source order.
+             */
+            virtual void columnsAvailable(const QString& importTemplateName, const QVariant& context, const QStringList& columns) const = 0;
+
+            /**
+             * @brief Virtual signal emitted once after the contents of a source file have been hashed, before the header row is passed.
+             * Not emitted by data sources that don't read files.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Context the data is imported in (e.g. source file name).
+             * @param digest SHA-1 hash of the whole source file.
+             */
+            virtual void contentDigestAvailable(const QString& importTemplateName, const QVariant& context, const QByteArray& digest) const = 0;
+
+            /**
+             * @brief Virtual signal emitted whenever a batch of rows has been read.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Context the data is imported in (e.g. source file name).
+             * @param rows Rows that have been read, in source order.
+             */
+            virtual void rowsAvailable(const QString& importTemplateName, const QVariant& context, const RecordImportRowList& rows) const = 0;
+
+            /**
+             * @brief Virtual signal emitted as soon as importing records asynchronously has finished,
+             * after all rows have been passed by rowsAvailable.
              * @param importTemplateName Name of the template that was used for importing the record data.
              * @param context Context the data was imported in (e.g. source file name).
-             * @param data Imported records and their field values.
              */
-            virtual void dataAvailable(const QString& importTemplateName, const QVariant& context, const QMap<QString, RecordFieldValueMap>& data) const = 0;
+            virtual void dataComplete(const QString& importTemplateName, const QVariant& context) const = 0;
 
             /**
              * @brief Virtual signal emitted if importing records asynchronously has failed.
@@ -53,6 +109,45 @@ namespace Tome
              * @param maximumValue Maximum progress value (e.g. maximum record count).
              */
             virtual void progressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const = 0;
+
+        protected:
+            /**
+             * @brief Checks whether reading has been cancelled, and should be stopped as soon as possible.
+             * @return true, if reading has been cancelled, and false otherwise.
+             */
+            bool isCancelled() const;
+
+            /**
+             * @brief Adds the passed row to the current batch, passing the batch on if it is full.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context Context the data is imported in (e.g. source file name).
+             * @param row Row to add.
+             */
+            void addRow(const QString& importTemplateName, const QVariant& context, const RecordImportRow& row);
+
+            /**
+             * @brief Passes on all rows of the current batch, and emits dataComplete.
+             * @param importTemplateName Name of the template that was used for importing the record data.
+             * @param context Context the data was imported in (e.g. source file name).
+             */
+            void completeRows(const QString& importTemplateName, const QVariant& context);
+
+            /**
+             * @brief Reads data on a worker thread, which is waited for when this data source is stopped.
+             * @param read Function reading the data.
+             */
+            void runWorker(const std::function<void()>& read);
+
+        private:
+            static const int BatchSize;
+            static const int MaxPendingBatches;
+
+            RecordImportRowList rows;
+            QSemaphore pendingBatches;
+            QAtomicInt cancelled;
+            QFuture<void> worker;
+
+            void passRows(const QString& importTemplateName, const QVariant& context);
     };
 }
 
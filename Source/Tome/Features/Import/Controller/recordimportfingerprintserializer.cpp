@@ -0,0 +1,105 @@
+#include "recordimportfingerprintserializer.h"
+
+#include <stdexcept>
+
+#include <QDataStream>
+#include <QObject>
+
+#include "../Model/recordimportfingerprintcache.h"
+
+using namespace Tome;
+
+
+const quint32 RecordImportFingerprintSerializer::Magic = 0x546f6d49;
+const quint32 RecordImportFingerprintSerializer::Version = 1;
+
+
+void RecordImportFingerprintSerializer::serialize(QIODevice& device, const RecordImportFingerprintCache& cache) const
+{
+    QDataStream stream(&device);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Write header.
+    stream << Magic << Version;
+    stream << static_cast<qint32>(cache.entries.size());
+
+    // Write entries.
+    for (QHash<QString, RecordImportFingerprintCacheEntry>::const_iterator it = cache.entries.cbegin();
+         it != cache.entries.cend();
+         ++it)
+    {
+        const RecordImportFingerprintCacheEntry& entry = it.value();
+
+        stream << it.key() << entry.recordsDigest;
+        stream << static_cast<qint32>(entry.fingerprints.size());
+
+        for (const RecordImportFingerprint& fingerprint : entry.fingerprints)
+        {
+            stream << fingerprint.importTemplateName
+                   << fingerprint.sourcePath
+                   << fingerprint.size
+                   << fingerprint.lastModified
+                   << fingerprint.contentDigest
+                   << fingerprint.templateDigest;
+        }
+    }
+}
+
+void RecordImportFingerprintSerializer::deserialize(QIODevice& device, RecordImportFingerprintCache& cache) const
+{
+    QDataStream stream(&device);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    // Read header.
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 entryCount = 0;
+
+    stream >> magic >> version;
+
+    if (magic != Magic || version != Version)
+    {
+        throw std::runtime_error(QObject::tr("Unsupported record import fingerprints.").toStdString());
+    }
+
+    stream >> entryCount;
+
+    if (entryCount < 0)
+    {
+        throw std::runtime_error(QObject::tr("Record import fingerprints are corrupt.").toStdString());
+    }
+
+    // Read entries.
+    cache.entries.reserve(entryCount);
+
+    for (qint32 i = 0; i < entryCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString key;
+        qint32 fingerprintCount = 0;
+        RecordImportFingerprintCacheEntry entry;
+
+        stream >> key >> entry.recordsDigest;
+        stream >> fingerprintCount;
+
+        for (qint32 j = 0; j < fingerprintCount && stream.status() == QDataStream::Ok; ++j)
+        {
+            RecordImportFingerprint fingerprint;
+
+            stream >> fingerprint.importTemplateName
+                   >> fingerprint.sourcePath
+                   >> fingerprint.size
+                   >> fingerprint.lastModified
+                   >> fingerprint.contentDigest
+                   >> fingerprint.templateDigest;
+
+            entry.fingerprints << fingerprint;
+        }
+
+        cache.entries.insert(key, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        throw std::runtime_error(QObject::tr("Record import fingerprints are corrupt.").toStdString());
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef RECORDIMPORTFINGERPRINTSERIALIZER_H
+#define RECORDIMPORTFINGERPRINTSERIALIZER_H
+
+#include <QIODevice>
+
+namespace Tome
+{
+    class RecordImportFingerprintCache;
+
+    /**
+     * @brief Reads and writes fingerprints of imported source files from any device.
+     */
+    class RecordImportFingerprintSerializer
+    {
+        public:
+            /**
+             * @brief Writes the passed fingerprints to the specified device.
+             * @param device Device to write the fingerprints to.
+             * @param cache Fingerprints to write.
+             */
+            void serialize(QIODevice& device, const RecordImportFingerprintCache& cache) const;
+
+            /**
+             * @brief Reads fingerprints from the specified device.
+             *
+             * @exception std::runtime_error if the device doesn't contain valid fingerprints of the current version.
+             *
+             * @param device Device to read the fingerprints from.
+             * @param cache Fingerprint cache to read the data into.
+             */
+            void deserialize(QIODevice& device, RecordImportFingerprintCache& cache) const;
+
+        private:
+            static const quint32 Magic;
+            static const quint32 Version;
+    };
+}
+
+#endif // RECORDIMPORTFINGERPRINTSERIALIZER_H
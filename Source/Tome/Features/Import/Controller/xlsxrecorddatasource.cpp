@@ -1,15 +1,16 @@
 #include "xlsxrecorddatasource.h"
 
+#include <QCryptographicHash>
 #include <QFileInfo>
-#include <QSqlDatabase>
-#include <QSqlError>
-#include <QSqlQuery>
-#include <QSqlRecord>
+
+#include "../../../IO/mappedfile.h"
+#include "../../../IO/xlsxreader.h"
 
 using namespace Tome;
 
 
 const QString XlsxRecordDataSource::ParameterSheet = "Sheet";
+const int XlsxRecordDataSource::ProgressInterval = 1024;
 
 
 XlsxRecordDataSource::XlsxRecordDataSource()
@@ -17,22 +18,25 @@ XlsxRecordDataSource::XlsxRecordDataSource()
 }
 
 void XlsxRecordDataSource::importData(const RecordTableImportTemplate& importTemplate, const QVariant& context)
+{
+    // Read file on a worker thread, applying rows on the model thread while reading.
+    this->runWorker([this, importTemplate, context]()
+    {
+        this->readData(importTemplate, context);
+    });
+}
+
+void XlsxRecordDataSource::readData(const RecordTableImportTemplate& importTemplate, const QVariant& context)
 {
     // Open Excel file.
     const QString filePath = context.toString();
     const QFileInfo fileInfo = QFileInfo(filePath);
+    MappedFile file(filePath);
 
-    QSqlDatabase db = QSqlDatabase::addDatabase("QODBC");
-    db.setDatabaseName("DRIVER={Microsoft Excel Driver (*.xls, *.xlsx, *.xlsm, *.xlsb)};DBQ=" + filePath);
-
-    if (!db.open())
+    if (!file.open())
     {
-        QString errorMessage =
-                QObject::tr("Source file could not be read:\r\n") + filePath
-                + "\r\n\r\n" + db.lastError().text();
-
+        QString errorMessage = QObject::tr("Source file could not be read:\r\n") + filePath;
         qCritical(qUtf8Printable(errorMessage));
-        db.close();
         emit this->dataUnavailable(importTemplate.name, context, errorMessage);
         return;
     }
@@ -41,7 +45,10 @@ void XlsxRecordDataSource::importData(const RecordTableImportTemplate& importTem
     QString progressBarTitle = tr("Importing %1 With %2").arg(fileInfo.fileName(), importTemplate.name);
     emit this->progressChanged(progressBarTitle, tr("Opening File"), 0, 100);
 
-    // Read headers.
+    // Hash contents on this thread, to allow skipping the import if the file hasn't changed since the last import.
+    emit this->contentDigestAvailable(importTemplate.name, context, QCryptographicHash::hash(file.getData(), QCryptographicHash::Sha1));
+
+    // Open sheet.
     if (!importTemplate.parameters.contains(ParameterSheet))
     {
         QString errorMessage =
@@ -49,98 +56,107 @@ void XlsxRecordDataSource::importData(const RecordTableImportTemplate& importTem
                 .arg(ParameterSheet, filePath);
 
         qCritical(qUtf8Printable(errorMessage));
-        db.close();
         emit this->progressChanged(progressBarTitle, tr("Opening File"), 1, 1);
         emit this->dataUnavailable(importTemplate.name, context, errorMessage);
         return;
     }
 
     QString sheet = importTemplate.parameters[ParameterSheet];
-    QSqlQuery sqlQuery(QString("SELECT * FROM [%1$]").arg(sheet));
-    QSqlRecord sqlRecord = sqlQuery.record();
-    int columns = sqlRecord.count();
+    XlsxReader reader(file.getData());
 
-    // Check column count.
-    if (columns <= 0)
+    if (!reader.open(sheet))
     {
         QString errorMessage =
-                QObject::tr("No data found. Sheet %1 empty or missing.").arg(sheet);
+                QObject::tr("Source file could not be read:\r\n") + filePath
+                + "\r\n\r\n" + reader.getErrorString();
 
         qCritical(qUtf8Printable(errorMessage));
-        db.close();
         emit this->progressChanged(progressBarTitle, tr("Opening File"), 1, 1);
         emit this->dataUnavailable(importTemplate.name, context, errorMessage);
         return;
     }
 
-    QStringList headers;
-
-    for (int i = 0; i < columns; ++i)
+    // Read headers.
+    if (!reader.readRow() || reader.getRow().isEmpty())
     {
-        headers << sqlRecord.fieldName(i);
+        QString errorMessage =
+                QObject::tr("No data found. Sheet %1 empty or missing.").arg(sheet);
+
+        qCritical(qUtf8Printable(errorMessage));
+        emit this->progressChanged(progressBarTitle, tr("Opening File"), 1, 1);
+        emit this->dataUnavailable(importTemplate.name, context, errorMessage);
+        return;
     }
 
-    // Find id column.
-    int idColumnIndex = -1;
+    const QStringList headers = reader.getRow();
+    const int columns = headers.count();
 
-    for (int i = 0; i < headers.count(); ++i)
-    {
-        if (headers[i] == importTemplate.idColumn)
-        {
-            idColumnIndex = i;
-            break;
-        }
-    }
+    // Find id column.
+    int idColumnIndex = headers.indexOf(importTemplate.idColumn);
 
     if (idColumnIndex == -1)
     {
         QString errorMessage = QObject::tr("Could not find id column %1 in source file:\r\n%2")
                 .arg(importTemplate.idColumn, filePath);
         qCritical(qUtf8Printable(errorMessage));
-        db.close();
         emit this->progressChanged(progressBarTitle, tr("Opening File"), 1, 1);
         emit this->dataUnavailable(importTemplate.name, context, errorMessage);
         return;
     }
 
+    emit this->columnsAvailable(importTemplate.name, context, headers);
+
     // Read rows.
-    QMap<QString, RecordFieldValueMap> data;
     int rowIndex = 0;
 
-    while (sqlQuery.next())
+    while (!this->isCancelled() && reader.readRow())
     {
         ++rowIndex;
 
-        RecordFieldValueMap map;
-        QString recordId;
+        // Cells after the last one with a value are not stored, and cells without header are ignored.
+        const QStringList& cells = reader.getRow();
+
+        RecordImportRow row;
+        row.values.reserve(columns);
 
         for (int i = 0; i < columns; ++i)
         {
-            QVariant value = sqlQuery.value(i).toString();
-
-            if (i == idColumnIndex)
-            {
-                recordId = value.toString();
-            }
-            else
-            {
-                map[headers[i]] = value;
-            }
+            row.values << (i < cells.count() ? cells[i] : QString());
         }
 
+        row.recordId = row.values[idColumnIndex].toString();
+
         // Update progress bar.
-        emit this->progressChanged(progressBarTitle, recordId, rowIndex, sqlQuery.size());
+        if (rowIndex % ProgressInterval == 0)
+        {
+            emit this->progressChanged(progressBarTitle, row.recordId, reader.getProgress(), 100);
+        }
 
-        if (importTemplate.ignoredIds.contains(recordId))
+        if (importTemplate.ignoredIds.contains(row.recordId))
         {
             continue;
         }
 
-        data[recordId] = map;
+        this->addRow(importTemplate.name, context, row);
+    }
+
+    if (this->isCancelled())
+    {
+        return;
     }
 
-    db.close();
+    if (reader.hasError())
+    {
+        QString errorMessage =
+                QObject::tr("Source file could not be read:\r\n") + filePath
+                + "\r\n\r\n" + reader.getErrorString();
+
+        qCritical(qUtf8Printable(errorMessage));
+        emit this->progressChanged(progressBarTitle, QString(), 1, 1);
+        emit this->dataUnavailable(importTemplate.name, context, errorMessage);
+        return;
+    }
 
     emit this->progressChanged(progressBarTitle, QString(), 1, 1);
-    emit this->dataAvailable(importTemplate.name, context, data);
+    this->completeRows(importTemplate.name, context);
 }
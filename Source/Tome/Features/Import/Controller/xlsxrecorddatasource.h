@@ -7,6 +7,9 @@ namespace Tome
 {
     /**
      * @brief Data source for importing records from an Excel file.
+     *
+     * The sheet is decompressed and parsed on a worker thread while reading, so memory usage
+     * doesn't grow with the size of the workbook.
      */
     class XlsxRecordDataSource : public RecordDataSource
     {
@@ -27,12 +30,35 @@ namespace Tome
 
         signals:
             /**
-             * @brief Importing records asynchronously has finished.
+             * @brief The header row has been read.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context XLSX file name.
+             * @param columns Headers of all columns, in source order.
+             */
+            void columnsAvailable(const QString& importTemplateName, const QVariant& context, const QStringList& columns) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief The contents of the source file have been hashed.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context XLSX file name.
+             * @param digest SHA-1 hash of the whole source file.
+             */
+            void contentDigestAvailable(const QString& importTemplateName, const QVariant& context, const QByteArray& digest) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief A batch of rows has been read.
+             * @param importTemplateName Name of the template that is used for importing the record data.
+             * @param context XLSX file name.
+             * @param rows Rows that have been read, in source order.
+             */
+            void rowsAvailable(const QString& importTemplateName, const QVariant& context, const RecordImportRowList& rows) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief Importing records asynchronously has finished, and all rows have been passed.
              * @param importTemplateName Name of the template that was used for importing the record data.
              * @param context XLSX file name.
-             * @param data Imported records and their field values.
              */
-            void dataAvailable(const QString& importTemplateName, const QVariant& context, const QMap<QString, RecordFieldValueMap>& data) const Q_DECL_OVERRIDE;
+            void dataComplete(const QString& importTemplateName, const QVariant& context) const Q_DECL_OVERRIDE;
 
             /**
              * @brief Importing records asynchronously has failed.
@@ -53,6 +79,9 @@ namespace Tome
 
         private:
             static const QString ParameterSheet;
+            static const int ProgressInterval;
+
+            void readData(const RecordTableImportTemplate& importTemplate, const QVariant& context);
     };
 }
 
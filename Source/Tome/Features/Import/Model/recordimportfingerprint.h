@@ -0,0 +1,48 @@
+#ifndef RECORDIMPORTFINGERPRINT_H
+#define RECORDIMPORTFINGERPRINT_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+
+namespace Tome
+{
+    /**
+     * @brief State of a single source file when it has last been imported with a specific template.
+     */
+    class RecordImportFingerprint
+    {
+        public:
+            /**
+             * @brief Digest of the whole contents of the source file.
+             */
+            QByteArray contentDigest;
+
+            /**
+             * @brief Name of the template the source file has been imported with.
+             */
+            QString importTemplateName;
+
+            /**
+             * @brief Time the source file has last been modified.
+             */
+            QDateTime lastModified;
+
+            /**
+             * @brief Size of the source file, in bytes.
+             */
+            qint64 size = -1;
+
+            /**
+             * @brief Absolute path of the source file.
+             */
+            QString sourcePath;
+
+            /**
+             * @brief Digest of the import template and all field definitions the source file has been imported with.
+             */
+            QByteArray templateDigest;
+    };
+}
+
+#endif // RECORDIMPORTFINGERPRINT_H
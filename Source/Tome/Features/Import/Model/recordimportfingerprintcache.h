@@ -0,0 +1,24 @@
+#ifndef RECORDIMPORTFINGERPRINTCACHE_H
+#define RECORDIMPORTFINGERPRINTCACHE_H
+
+#include <QHash>
+#include <QString>
+
+#include "recordimportfingerprintcacheentry.h"
+
+namespace Tome
+{
+    /**
+     * @brief State of all source files when they have last been imported into a project.
+     */
+    class RecordImportFingerprintCache
+    {
+        public:
+            /**
+             * @brief Fingerprints of previous imports, by names of the import templates and paths of the source files.
+             */
+            QHash<QString, RecordImportFingerprintCacheEntry> entries;
+    };
+}
+
+#endif // RECORDIMPORTFINGERPRINTCACHE_H
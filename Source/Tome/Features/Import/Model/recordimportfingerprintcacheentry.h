@@ -0,0 +1,29 @@
+#ifndef RECORDIMPORTFINGERPRINTCACHEENTRY_H
+#define RECORDIMPORTFINGERPRINTCACHEENTRY_H
+
+#include <QByteArray>
+#include <QList>
+
+#include "recordimportfingerprint.h"
+
+namespace Tome
+{
+    /**
+     * @brief State of all source files of a previous import, and of the records right after it.
+     */
+    class RecordImportFingerprintCacheEntry
+    {
+        public:
+            /**
+             * @brief Fingerprints of all imported source files, in import order.
+             */
+            QList<RecordImportFingerprint> fingerprints;
+
+            /**
+             * @brief Digest of all records of the project right after the import has been applied.
+             */
+            QByteArray recordsDigest;
+    };
+}
+
+#endif // RECORDIMPORTFINGERPRINTCACHEENTRY_H
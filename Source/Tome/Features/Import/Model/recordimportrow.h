@@ -0,0 +1,28 @@
+#ifndef RECORDIMPORTROW_H
+#define RECORDIMPORTROW_H
+
+#include <QString>
+#include <QVariant>
+
+namespace Tome
+{
+    /**
+     * @brief Single row read from a record data source.
+     */
+    class RecordImportRow
+    {
+        public:
+            /**
+             * @brief Id of the record to import the row as.
+             */
+            QString recordId;
+
+            /**
+             * @brief Values of all columns of the row, including the id column,
+             * in the order of the columns passed by RecordDataSource::columnsAvailable.
+             */
+            QVariantList values;
+    };
+}
+
+#endif // RECORDIMPORTROW_H
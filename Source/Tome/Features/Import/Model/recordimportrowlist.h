@@ -0,0 +1,16 @@
+#ifndef RECORDIMPORTROWLIST_H
+#define RECORDIMPORTROWLIST_H
+
+#include <QMetaType>
+#include <QVector>
+
+#include "recordimportrow.h"
+
+namespace Tome
+{
+    typedef QVector<RecordImportRow> RecordImportRowList;
+}
+
+Q_DECLARE_METATYPE(Tome::RecordImportRowList)
+
+#endif // RECORDIMPORTROWLIST_H
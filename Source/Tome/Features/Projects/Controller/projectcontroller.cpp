@@ -1,6 +1,12 @@
 #include "projectcontroller.h"
 
-#include <QTextStream>
+#include <algorithm>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFuture>
+#include <QMap>
+#include <QtConcurrent>
 
 #include "projectserializer.h"
 #include "../Model/project.h"
@@ -8,8 +14,10 @@
 #include "../../Export/Controller/exporttemplateserializer.h"
 #include "../../Fields/Controller/fielddefinitionsetserializer.h"
 #include "../../Import/Controller/importtemplateserializer.h"
-#include "../../Records/Controller/recordsetserializer.h"
+#include "../../Records/Controller/jsonrecordsetserializer.h"
+#include "../../Records/Controller/xmlrecordsetserializer.h"
 #include "../../Types/Controller/customtypesetserializer.h"
+#include "../../../IO/mappedfile.h"
 #include "../../../Util/pathutils.h"
 
 
@@ -36,15 +44,23 @@ const QString ProjectController::RecordExportRecordTemplateExtension = ".texport
 const QString ProjectController::RecordExportRecordDelimiterExtension = ".texportrd";
 const QString ProjectController::RecordExportTemplateFileExtension = ".texport";
 const QString ProjectController::RecordImportTemplateFileExtension = ".timport";
+const QString ProjectController::RecordShardDirectoryExtension = ".tshards";
 const QString ProjectController::TypeFileExtension = ".ttypes";
 
 
 ProjectController::ProjectController() :
-    recordSetSerializer(new RecordSetSerializer())
+    jsonRecordSetSerializer(new JsonRecordSetSerializer()),
+    xmlRecordSetSerializer(new XmlRecordSetSerializer())
 {
     // Connect signals.
     connect(
-                this->recordSetSerializer,
+                this->jsonRecordSetSerializer,
+                SIGNAL(progressChanged(QString, QString, int, int)),
+                SLOT(onProgressChanged(QString, QString, int, int))
+                );
+
+    connect(
+                this->xmlRecordSetSerializer,
                 SIGNAL(progressChanged(QString, QString, int, int)),
                 SLOT(onProgressChanged(QString, QString, int, int))
                 );
@@ -52,7 +68,8 @@ ProjectController::ProjectController() :
 
 ProjectController::~ProjectController()
 {
-    delete this->recordSetSerializer;
+    delete this->jsonRecordSetSerializer;
+    delete this->xmlRecordSetSerializer;
 }
 
 QString ProjectController::buildFullFilePath(QString filePath, QString projectPath, QString desiredExtension) const
@@ -236,15 +253,15 @@ void ProjectController::loadComponentSet(const QString& projectPath, ComponentSe
     QString fullComponentSetPath =
             buildFullFilePath(componentSet.name, projectPath, ComponentFileExtension);
 
-    QFile componentFile(fullComponentSetPath);
+    MappedFile componentFile(fullComponentSetPath);
 
     qInfo(qUtf8Printable(QString("Opening components file %1.").arg(fullComponentSetPath)));
 
-    if (componentFile.open(QIODevice::ReadOnly))
+    if (componentFile.open())
     {
         try
         {
-            componentSerializer.deserialize(componentFile, componentSet);
+            componentSerializer.deserialize(componentFile.getDevice(), componentSet);
             qInfo(qUtf8Printable(QString("Opened components file %1 with %2 components.")
                   .arg(fullComponentSetPath, QString::number(componentSet.components.count()))));
         }
@@ -270,15 +287,15 @@ void ProjectController::loadCustomTypeSet(const QString& projectPath, CustomType
     QString fullTypeSetPath =
             buildFullFilePath(typeSet.name, projectPath, TypeFileExtension);
 
-    QFile typeFile(fullTypeSetPath);
+    MappedFile typeFile(fullTypeSetPath);
 
     qInfo(qUtf8Printable(QString("Opening types file %1.").arg(fullTypeSetPath)));
 
-    if (typeFile.open(QIODevice::ReadOnly))
+    if (typeFile.open())
     {
         try
         {
-            typesSerializer.deserialize(typeFile, typeSet);
+            typesSerializer.deserialize(typeFile.getDevice(), typeSet);
             qInfo(qUtf8Printable(QString("Opened types file %1 with %2 custom types.")
                   .arg(fullTypeSetPath, QString::number(typeSet.types.count()))));
         }
@@ -304,15 +321,15 @@ void ProjectController::loadExportTemplate(const QString& projectPath, RecordExp
     QString fullExportTemplatePath =
             buildFullFilePath(exportTemplate.path, projectPath, RecordExportTemplateFileExtension);
 
-    QFile exportTemplateFile(fullExportTemplatePath);
+    MappedFile exportTemplateFile(fullExportTemplatePath);
 
     qInfo(qUtf8Printable(QString("Opening export template file %1.").arg(fullExportTemplatePath)));
 
-    if (exportTemplateFile.open(QIODevice::ReadOnly))
+    if (exportTemplateFile.open())
     {
         try
         {
-            exportTemplateSerializer.deserialize(exportTemplateFile, exportTemplate);
+            exportTemplateSerializer.deserialize(exportTemplateFile.getDevice(), exportTemplate);
         }
         catch (const std::runtime_error& e)
         {
@@ -327,74 +344,38 @@ void ProjectController::loadExportTemplate(const QString& projectPath, RecordExp
         throw std::runtime_error(errorMessage.toStdString());
     }
 
-    // Read template contents.
-    try
-    {
-        QString templatePath;
+    // Resolve template contents path. Contents are read on first export.
+    QString templatePath;
 
-        // Check if any subpath has been specified.
-        if (!exportTemplate.templateFilesPath.isEmpty())
+    // Check if any subpath has been specified.
+    if (!exportTemplate.templateFilesPath.isEmpty())
+    {
+        if (QDir::isRelativePath(exportTemplate.templateFilesPath))
         {
-            if (QDir::isRelativePath(exportTemplate.templateFilesPath))
-            {
-                templatePath = combinePaths(projectPath, exportTemplate.templateFilesPath);
-            }
-            else
-            {
-                templatePath = exportTemplate.templateFilesPath;
-            }
+            templatePath = combinePaths(projectPath, exportTemplate.templateFilesPath);
         }
         else
         {
-            // Fall back to files with same name at same location at the template itself.
-            templatePath = exportTemplate.path;
-
-            if (QDir::isRelativePath(templatePath))
-            {
-                templatePath = combinePaths(projectPath, templatePath);
-            }
+            templatePath = exportTemplate.templateFilesPath;
+        }
+    }
+    else
+    {
+        // Fall back to files with same name at same location at the template itself.
+        templatePath = exportTemplate.path;
 
-            if (templatePath.endsWith(RecordExportTemplateFileExtension))
-            {
-                templatePath = templatePath.remove(RecordExportTemplateFileExtension);
-            }
+        if (QDir::isRelativePath(templatePath))
+        {
+            templatePath = combinePaths(projectPath, templatePath);
         }
 
-        exportTemplate.fieldValueDelimiter =
-                this->readFile(templatePath + RecordExportFieldValueDelimiterExtension);
-        exportTemplate.fieldValueTemplate =
-                this->readFile(templatePath + RecordExportFieldValueTemplateExtension);
-        exportTemplate.recordDelimiter =
-                this->readFile(templatePath + RecordExportRecordDelimiterExtension);
-        exportTemplate.recordFileTemplate =
-                this->readFile(templatePath + RecordExportRecordFileTemplateExtension);
-        exportTemplate.recordTemplate =
-                this->readFile(templatePath + RecordExportRecordTemplateExtension);
-        exportTemplate.componentDelimiter =
-                this->readFile(templatePath + RecordExportComponentDelimiterExtension);
-        exportTemplate.componentTemplate =
-                this->readFile(templatePath + RecordExportComponentTemplateExtension);
-        exportTemplate.listTemplate =
-                this->readFile(templatePath + RecordExportListTemplateExtension);
-        exportTemplate.listItemTemplate =
-                this->readFile(templatePath + RecordExportListItemTemplateExtension);
-        exportTemplate.listItemDelimiter =
-                this->readFile(templatePath + RecordExportListItemDelimiterExtension);
-        exportTemplate.mapTemplate =
-                this->readFile(templatePath + RecordExportMapTemplateExtension);
-        exportTemplate.mapItemTemplate =
-                this->readFile(templatePath + RecordExportMapItemTemplateExtension);
-        exportTemplate.mapItemDelimiter =
-                this->readFile(templatePath + RecordExportMapItemDelimiterExtension);
-        exportTemplate.localizedFieldValueTemplate =
-                this->readFile(templatePath + RecordExportLocalizedFieldValueTemplateExtension);
-    }
-    catch (const std::runtime_error& e)
-    {
-        QString errorMessage = QObject::tr("Export template %1 is missing a required file: %2")
-                .arg(exportTemplate.name, e.what());
-        qCritical(qUtf8Printable(errorMessage));
+        if (templatePath.endsWith(RecordExportTemplateFileExtension))
+        {
+            templatePath = templatePath.remove(RecordExportTemplateFileExtension);
+        }
     }
+
+    exportTemplate.fullTemplateFilesPath = templatePath;
 }
 
 void ProjectController::loadFieldDefinitionSet(const QString& projectPath, FieldDefinitionSet& fieldDefinitionSet) const
@@ -405,15 +386,15 @@ void ProjectController::loadFieldDefinitionSet(const QString& projectPath, Field
     QString fullFieldDefinitionSetPath =
             buildFullFilePath(fieldDefinitionSet.name, projectPath, FieldDefinitionFileExtension);
 
-    QFile fieldDefinitionFile(fullFieldDefinitionSetPath);
+    MappedFile fieldDefinitionFile(fullFieldDefinitionSetPath);
 
     qInfo(qUtf8Printable(QString("Opening field definitions file %1.").arg(fullFieldDefinitionSetPath)));
 
-    if (fieldDefinitionFile.open(QIODevice::ReadOnly))
+    if (fieldDefinitionFile.open())
     {
         try
         {
-            fieldDefinitionSerializer.deserialize(fieldDefinitionFile, fieldDefinitionSet);
+            fieldDefinitionSerializer.deserialize(fieldDefinitionFile.getDevice(), fieldDefinitionSet);
             qInfo(qUtf8Printable(QString("Opened field definitions file %1 with %2 fields.")
                   .arg(fullFieldDefinitionSetPath, QString::number(fieldDefinitionSet.fieldDefinitions.count()))));
         }
@@ -439,15 +420,15 @@ void ProjectController::loadImportTemplate(const QString& projectPath, RecordTab
     QString fullImportTemplatePath =
             buildFullFilePath(importTemplate.path, projectPath, RecordImportTemplateFileExtension);
 
-    QFile importTemplateFile(fullImportTemplatePath);
+    MappedFile importTemplateFile(fullImportTemplatePath);
 
     qInfo(qUtf8Printable(QString("Opening import template file %1.").arg(fullImportTemplatePath)));
 
-    if (importTemplateFile.open(QIODevice::ReadOnly))
+    if (importTemplateFile.open())
     {
         try
         {
-            importTemplateSerializer.deserialize(importTemplateFile, importTemplate);
+            importTemplateSerializer.deserialize(importTemplateFile.getDevice(), importTemplate);
             qInfo(qUtf8Printable(QString("Opened import template file %1.")
                   .arg(fullImportTemplatePath)));
         }
@@ -467,19 +448,106 @@ void ProjectController::loadImportTemplate(const QString& projectPath, RecordTab
 
 void ProjectController::loadRecordSet(const QString& projectPath, RecordSet& recordSet) const
 {
-    // Open record file.
-    QString fullRecordSetPath =
-            buildFullFilePath(recordSet.name, projectPath, RecordFileExtension);
+    recordSet.dirtyShards.clear();
+
+    const QString fullRecordSetPath = buildFullFilePath(recordSet.name, projectPath, RecordFileExtension);
+
+    // Find shards on disk, no matter how many shards the record set is configured to have now.
+    // The single file is only kept along with shards if it has been written after them.
+    const QMap<int, QString> shardPaths = recordSet.shardCount > 1 && !QFile::exists(fullRecordSetPath)
+            ? this->findRecordSetShardPaths(projectPath, recordSet)
+            : QMap<int, QString>();
 
-    QFile recordFile(fullRecordSetPath);
+    if (shardPaths.isEmpty())
+    {
+        // Load single file, and split it up on next save if necessary.
+        this->loadRecordSetFile(fullRecordSetPath, recordSet);
+
+        if (recordSet.shardCount > 1)
+        {
+            this->markAllShardsDirty(recordSet);
+        }
+
+        return;
+    }
+
+    // Load all shards in parallel.
+    const QList<QString> fullShardPaths = shardPaths.values();
+
+    QVector<RecordSet> shards(fullShardPaths.size());
+    QVector<QString> errors(fullShardPaths.size());
+    QList<QFuture<void>> futures;
+
+    for (int i = 0; i < fullShardPaths.size(); ++i)
+    {
+        RecordSet& shard = shards[i];
+        shard.name = recordSet.name;
+        shard.format = recordSet.format;
+
+        const QString fullShardPath = fullShardPaths[i];
+        QString& error = errors[i];
+
+        futures << QtConcurrent::run([this, fullShardPath, &shard, &error]()
+        {
+            // Exceptions can't cross thread boundaries, so we need to pass them on manually.
+            try
+            {
+                this->loadRecordSetFile(fullShardPath, shard);
+            }
+            catch (const std::runtime_error& e)
+            {
+                error = e.what();
+            }
+        });
+    }
+
+    for (int i = 0; i < futures.size(); ++i)
+    {
+        futures[i].waitForFinished();
+    }
+
+    // Merge shards.
+    for (int i = 0; i < shards.size(); ++i)
+    {
+        if (!errors[i].isEmpty())
+        {
+            throw std::runtime_error(errors[i].toStdString());
+        }
+
+        recordSet.records.append(shards[i].records);
+    }
+
+    // Restore record order, which doesn't depend on shards.
+    std::sort(recordSet.records.begin(), recordSet.records.end(), recordLessThanDisplayName);
+    recordSet.recordIdOrder.clear();
+
+    // Records are assigned to different shards if the shard count has changed, so rewrite all of them on next save.
+    if (shardPaths.size() != recordSet.shardCount || shardPaths.lastKey() != recordSet.shardCount - 1)
+    {
+        this->markAllShardsDirty(recordSet);
+    }
+}
+
+void ProjectController::markAllShardsDirty(RecordSet& recordSet) const
+{
+    for (int i = 0; i < recordSet.shardCount; ++i)
+    {
+        recordSet.dirtyShards.insert(i);
+    }
+}
+
+void ProjectController::loadRecordSetFile(const QString& fullRecordSetPath, RecordSet& recordSet) const
+{
+    // Open record file.
+    MappedFile recordFile(fullRecordSetPath);
 
     qInfo(qUtf8Printable(QString("Opening records file %1.").arg(fullRecordSetPath)));
 
-    if (recordFile.open(QIODevice::ReadOnly))
+    if (recordFile.open())
     {
         try
         {
-            this->recordSetSerializer->deserialize(recordFile, recordSet);
+            this->getRecordSetSerializer(recordSet.format)->deserialize(recordFile.getDevice(), recordSet);
             qInfo(qUtf8Printable(QString("Opened records file %1 with %2 records.")
                   .arg(fullRecordSetPath, QString::number(recordSet.records.count()))));
         }
@@ -505,14 +573,14 @@ void ProjectController::openProject(const QString& projectFileName)
     }
 
     // Open project file.
-    QFile projectFile(projectFileName);
+    MappedFile projectFile(projectFileName);
     QFileInfo projectFileInfo(projectFileName);
 
     const QString projectPath = projectFileInfo.path();
 
     qInfo(qUtf8Printable(QString("Opening project %1.").arg(projectFileName)));
 
-    if (projectFile.open(QIODevice::ReadOnly))
+    if (projectFile.open())
     {
         // Load project from file.
         ProjectSerializer projectSerializer = ProjectSerializer();
@@ -521,7 +589,7 @@ void ProjectController::openProject(const QString& projectFileName)
 
         try
         {
-            projectSerializer.deserialize(projectFile, project);
+            projectSerializer.deserialize(projectFile.getDevice(), project);
         }
         catch (const std::runtime_error& e)
         {
@@ -601,18 +669,52 @@ const QString ProjectController::getFullProjectPath(QSharedPointer<Project> proj
     return combinePaths(project->path, project->name + ProjectFileExtension);
 }
 
-QString ProjectController::readFile(const QString& fullPath) const
+QString ProjectController::getRecordSetShardDirectory(const QString& projectPath, const RecordSet& recordSet) const
+{
+    // Use a directory of its own, so shards can't be confused with the files of any other record set.
+    const QString fullRecordSetPath = buildFullFilePath(recordSet.name, projectPath, RecordFileExtension);
+    return fullRecordSetPath.left(fullRecordSetPath.length() - RecordFileExtension.length()) + RecordShardDirectoryExtension;
+}
+
+QString ProjectController::getRecordSetShardPath(const QString& projectPath, const RecordSet& recordSet, int shardIndex) const
+{
+    return combinePaths(this->getRecordSetShardDirectory(projectPath, recordSet), QString::number(shardIndex) + RecordFileExtension);
+}
+
+QMap<int, QString> ProjectController::findRecordSetShardPaths(const QString& projectPath, const RecordSet& recordSet) const
 {
-    QFile file(fullPath);
+    const QDir shardDir(this->getRecordSetShardDirectory(projectPath, recordSet));
 
-    if (file.open(QIODevice::ReadOnly))
+    // Shard file names consist of shard index and record file extension.
+    const QStringList fileNames = shardDir.entryList(QStringList() << "*" + RecordFileExtension, QDir::Files);
+
+    QMap<int, QString> shardPaths;
+
+    for (const QString& fileName : fileNames)
     {
-        QTextStream textStream(&file);
-        return textStream.readAll();
+        const QString shardIndexString = fileName.left(fileName.length() - RecordFileExtension.length());
+
+        bool ok = false;
+        const int shardIndex = shardIndexString.toInt(&ok);
+
+        if (ok && shardIndex >= 0 && shardIndexString == QString::number(shardIndex))
+        {
+            shardPaths.insert(shardIndex, shardDir.absoluteFilePath(fileName));
+        }
     }
-    else
+
+    return shardPaths;
+}
+
+RecordSetSerializer* ProjectController::getRecordSetSerializer(RecordSetFormat::RecordSetFormat format) const
+{
+    switch (format)
     {
-        throw std::runtime_error(fullPath.toStdString());
+        case RecordSetFormat::Json:
+            return this->jsonRecordSetSerializer;
+
+        default:
+            return this->xmlRecordSetSerializer;
     }
 }
 
@@ -702,20 +804,80 @@ void ProjectController::saveProject(QSharedPointer<Project> project) const
         QString fullRecordSetPath =
                 buildFullFilePath(recordSet.name, projectPath, RecordFileExtension);
 
-        // Write file.
-        QFile recordSetFile(fullRecordSetPath);
-
-        qInfo(qUtf8Printable(QString("Saving records file %1.").arg(fullRecordSetPath)));
+        QStringList obsoleteFilePaths;
 
-        if (recordSetFile.open(QIODevice::ReadWrite | QIODevice::Truncate))
+        if (recordSet.shardCount <= 1)
         {
-            this->recordSetSerializer->serialize(recordSetFile, recordSet);
+            // Any shards left on disk are ignored when loading, as long as the single file exists.
+            this->saveRecordSetFile(fullRecordSetPath, recordSet);
         }
         else
         {
-            QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + fullRecordSetPath;
-            throw std::runtime_error(errorMessage.toStdString());
+            // Find shards written with a different shard count before.
+            const QMap<int, QString> shardPaths = this->findRecordSetShardPaths(projectPath, recordSet);
+            const QString shardDirectory = this->getRecordSetShardDirectory(projectPath, recordSet);
+
+            if (!QDir().mkpath(shardDirectory))
+            {
+                QString errorMessage = QObject::tr("Destination directory could not be created:\r\n") + shardDirectory;
+                throw std::runtime_error(errorMessage.toStdString());
+            }
+
+            // Write changed shards only.
+            for (int shardIndex = 0; shardIndex < recordSet.shardCount; ++shardIndex)
+            {
+                const QString fullShardPath = this->getRecordSetShardPath(projectPath, recordSet, shardIndex);
+
+                if (!recordSet.dirtyShards.contains(shardIndex) && QFile::exists(fullShardPath))
+                {
+                    continue;
+                }
+
+                RecordSet shard = RecordSet();
+                shard.name = recordSet.name;
+                shard.format = recordSet.format;
+
+                for (int j = 0; j < recordSet.records.size(); ++j)
+                {
+                    const Record& record = recordSet.records[j];
+
+                    if (getRecordShardIndex(record.id, recordSet.shardCount) == shardIndex)
+                    {
+                        shard.records.append(record);
+                    }
+                }
+
+                this->saveRecordSetFile(fullShardPath, shard);
+            }
+
+            for (QMap<int, QString>::const_iterator it = shardPaths.cbegin(); it != shardPaths.cend(); ++it)
+            {
+                if (it.key() >= recordSet.shardCount)
+                {
+                    obsoleteFilePaths << it.value();
+                }
+            }
+
+            // Records of the single file have been split up into shards. Remove it last, as it would be loaded instead of them.
+            if (QFile::exists(fullRecordSetPath))
+            {
+                obsoleteFilePaths << fullRecordSetPath;
+            }
         }
+
+        // Remove files that would otherwise be loaded again, along with the records they still contain.
+        for (const QString& obsoleteFilePath : obsoleteFilePaths)
+        {
+            qInfo(qUtf8Printable(QString("Removing obsolete records file %1.").arg(obsoleteFilePath)));
+
+            if (!QFile::remove(obsoleteFilePath))
+            {
+                QString errorMessage = QObject::tr("File could not be removed:\r\n") + obsoleteFilePath;
+                throw std::runtime_error(errorMessage.toStdString());
+            }
+        }
+
+        recordSet.dirtyShards.clear();
     }
 
     // Write export templates.
@@ -804,6 +966,23 @@ void ProjectController::saveProject(QSharedPointer<Project> project) const
     }
 }
 
+void ProjectController::saveRecordSetFile(const QString& fullRecordSetPath, const RecordSet& recordSet) const
+{
+    QFile recordSetFile(fullRecordSetPath);
+
+    qInfo(qUtf8Printable(QString("Saving records file %1.").arg(fullRecordSetPath)));
+
+    if (recordSetFile.open(QIODevice::ReadWrite | QIODevice::Truncate))
+    {
+        this->getRecordSetSerializer(recordSet.format)->serialize(recordSetFile, recordSet);
+    }
+    else
+    {
+        QString errorMessage = QObject::tr("Destination file could not be written:\r\n") + fullRecordSetPath;
+        throw std::runtime_error(errorMessage.toStdString());
+    }
+}
+
 void ProjectController::setProject(QSharedPointer<Project> project)
 {
     this->project = project;
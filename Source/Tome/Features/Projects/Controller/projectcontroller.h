@@ -1,9 +1,11 @@
 #ifndef PROJECTCONTROLLER_H
 #define PROJECTCONTROLLER_H
 
+#include <QMap>
 #include <QSharedPointer>
 
 #include "../Model/recordidtype.h"
+#include "../../Records/Model/recordsetformat.h"
 
 namespace Tome
 {
@@ -124,6 +126,11 @@ namespace Tome
              */
             static const QString RecordImportTemplateFileExtension;
 
+            /**
+             * @brief Extension of directories holding the shard files of a Tome record set, including the dot.
+             */
+            static const QString RecordShardDirectoryExtension;
+
             /**
              * @brief File extension of Tome type files, including the dot.
              */
@@ -251,9 +258,9 @@ namespace Tome
             void loadCustomTypeSet(const QString& projectPath, CustomTypeSet& customTypeSet) const;
 
             /**
-             * @brief Loads the specified export template from disk.
+             * @brief Loads the specified export template from disk. Template contents are read on first export.
              *
-             * @exception std::runtime_error if any of the export template files could not be read.
+             * @exception std::runtime_error if the export template file could not be read.
              *
              * @param projectPath Absolute path to the project, without file name.
              * @param exportTemplate Export template to load from disk.
@@ -281,7 +288,12 @@ namespace Tome
             void loadImportTemplate(const QString& projectPath, RecordTableImportTemplate& importTemplate) const;
 
             /**
-             * @brief Loads the specified record set set from disk.
+             * @brief Loads the specified record set set from disk. Shards of split record sets are loaded in parallel.
+             *
+             * Shards are stored in a directory of their own, next to the single record set file.
+             * All shard files in that directory are loaded, even if the record set is configured to have a different number of shards now.
+             * In that case, all shards are written again on next save. If the single record set file exists as well,
+             * it has been written after the shards, and is loaded instead.
              *
              * @exception std::runtime_error if the record set file could not be read.
              *
@@ -328,11 +340,18 @@ namespace Tome
         private:
             QSharedPointer<Project> project;
 
-            RecordSetSerializer* recordSetSerializer;
+            RecordSetSerializer* jsonRecordSetSerializer;
+            RecordSetSerializer* xmlRecordSetSerializer;
 
+            QMap<int, QString> findRecordSetShardPaths(const QString& projectPath, const RecordSet& recordSet) const;
             const QString getFullProjectPath(QSharedPointer<Project> project) const;
-            QString readFile(const QString& fullPath) const;
+            RecordSetSerializer* getRecordSetSerializer(RecordSetFormat::RecordSetFormat format) const;
+            QString getRecordSetShardDirectory(const QString& projectPath, const RecordSet& recordSet) const;
+            QString getRecordSetShardPath(const QString& projectPath, const RecordSet& recordSet, int shardIndex) const;
+            void loadRecordSetFile(const QString& fullRecordSetPath, RecordSet& recordSet) const;
+            void markAllShardsDirty(RecordSet& recordSet) const;
             void saveProject(QSharedPointer<Project> project) const;
+            void saveRecordSetFile(const QString& fullRecordSetPath, const RecordSet& recordSet) const;
             void setProject(QSharedPointer<Project> project);
     };
 }
@@ -14,9 +14,11 @@ const QString ProjectSerializer::AttributeExportAsTable = "ExportAsTable";
 const QString ProjectSerializer::AttributeExportRoots = "ExportRoots";
 const QString ProjectSerializer::AttributeExportInnerNodes = "ExportInnerNodes";
 const QString ProjectSerializer::AttributeExportLeafs = "ExportLeafs";
+const QString ProjectSerializer::AttributeFormat = "Format";
 const QString ProjectSerializer::AttributeIgnoreReadOnly = "IgnoreReadOnly";
 const QString ProjectSerializer::AttributeKey = "Key";
 const QString ProjectSerializer::AttributeRecordIdType = "RecordIdType";
+const QString ProjectSerializer::AttributeShards = "Shards";
 const QString ProjectSerializer::AttributeTomeType = "TomeType";
 const QString ProjectSerializer::AttributeValue = "Value";
 const QString ProjectSerializer::AttributeVersion = "Version";
@@ -99,7 +101,21 @@ void ProjectSerializer::serialize(QIODevice& device, QSharedPointer<Project> pro
                 for (int i = 0; i < project->recordSets.size(); ++i)
                 {
                     const RecordSet& recordSet = project->recordSets[i];
-                    writer.writeTextElement(ElementPath, recordSet.name);
+
+                    writer.writeStartElement(ElementPath);
+
+                    if (recordSet.format != RecordSetFormat::Xml)
+                    {
+                        writer.writeAttribute(AttributeFormat, RecordSetFormat::toString(recordSet.format));
+                    }
+
+                    if (recordSet.shardCount > 1)
+                    {
+                        writer.writeAttribute(AttributeShards, QString::number(recordSet.shardCount));
+                    }
+
+                    writer.writeCharacters(recordSet.name);
+                    writer.writeEndElement();
                 }
             }
             writer.writeEndElement();
@@ -210,6 +226,15 @@ void ProjectSerializer::deserialize(QIODevice& device, QSharedPointer<Project> p
                 while (reader.isAtElement(ElementPath))
                 {
                     RecordSet recordSet = RecordSet();
+                    recordSet.format = RecordSetFormat::fromString(reader.readAttribute(AttributeFormat));
+
+                    if (recordSet.format == RecordSetFormat::Invalid)
+                    {
+                        recordSet.format = RecordSetFormat::Xml;
+                    }
+
+                    recordSet.shardCount = qMax(1, reader.readAttribute(AttributeShards).toInt());
+
                     recordSet.name = reader.readTextElement(ElementPath);
                     project->recordSets.push_back(recordSet);
                 }
@@ -35,9 +35,11 @@ namespace Tome
             static const QString AttributeExportRoots;
             static const QString AttributeExportInnerNodes;
             static const QString AttributeExportLeafs;
+            static const QString AttributeFormat;
             static const QString AttributeIgnoreReadOnly;
             static const QString AttributeKey;
             static const QString AttributeRecordIdType;
+            static const QString AttributeShards;
             static const QString AttributeTomeType;
             static const QString AttributeValue;
             static const QString AttributeVersion;
@@ -0,0 +1,41 @@
+#include "importrecordscommand.h"
+
+#include "../recordscontroller.h"
+
+using namespace Tome;
+
+
+ImportRecordsCommand::ImportRecordsCommand(RecordsController& recordsController,
+                                           const QString& importTemplateName,
+                                           const RecordList& addedRecords,
+                                           const RecordList& oldRecords,
+                                           const RecordList& newRecords)
+    : recordsController(recordsController),
+      importTemplateName(importTemplateName),
+      addedRecords(addedRecords),
+      oldRecords(oldRecords),
+      newRecords(newRecords)
+{
+    this->setText(tr("Import Records - %1").arg(importTemplateName));
+}
+
+void ImportRecordsCommand::undo()
+{
+    qInfo(qUtf8Printable(QString("Undo import records with import template %1.").arg(this->importTemplateName)));
+
+    // Remove added records.
+    QVariantList addedRecordIds;
+
+    for (const Record& record : this->addedRecords)
+    {
+        addedRecordIds << record.id;
+    }
+
+    // Restore updated records.
+    this->recordsController.updateRecords(RecordList(), this->oldRecords, addedRecordIds);
+}
+
+void ImportRecordsCommand::redo()
+{
+    this->recordsController.updateRecords(this->addedRecords, this->newRecords, QVariantList());
+}
@@ -0,0 +1,52 @@
+#ifndef IMPORTRECORDSCOMMAND_H
+#define IMPORTRECORDSCOMMAND_H
+
+#include <QUndoCommand>
+
+#include "../../Model/recordlist.h"
+
+namespace Tome
+{
+    class RecordsController;
+
+    /**
+     * @brief Adds and updates all records of a finished import at once.
+     */
+    class ImportRecordsCommand : public QUndoCommand, public QObject
+    {
+        public:
+            /**
+             * @brief Constructs a new command for adding and updating all records of a finished import at once.
+             * @param recordsController Controller for adding, updating and removing records.
+             * @param importTemplateName Name of the import template used for importing the records.
+             * @param addedRecords Records to add.
+             * @param oldRecords Records to update, before the import.
+             * @param newRecords Records to update, after the import.
+             */
+            ImportRecordsCommand(RecordsController& recordsController,
+                                 const QString& importTemplateName,
+                                 const RecordList& addedRecords,
+                                 const RecordList& oldRecords,
+                                 const RecordList& newRecords);
+
+            /**
+             * @brief Removes the added records and restores the updated ones.
+             */
+            virtual void undo() Q_DECL_OVERRIDE;
+
+            /**
+             * @brief Adds and updates the imported records.
+             */
+            virtual void redo() Q_DECL_OVERRIDE;
+
+        private:
+            RecordsController& recordsController;
+
+            const QString importTemplateName;
+            const RecordList addedRecords;
+            const RecordList oldRecords;
+            const RecordList newRecords;
+    };
+}
+
+#endif // IMPORTRECORDSCOMMAND_H
@@ -0,0 +1,211 @@
+#include "jsonrecordsetserializer.h"
+
+#include <stdexcept>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "../Model/recordset.h"
+
+using namespace Tome;
+
+
+const QString JsonRecordSetSerializer::KeyDisplayName = "DisplayName";
+const QString JsonRecordSetSerializer::KeyEditorIconFieldId = "EditorIconFieldId";
+const QString JsonRecordSetSerializer::KeyFields = "Fields";
+const QString JsonRecordSetSerializer::KeyId = "Id";
+const QString JsonRecordSetSerializer::KeyParentId = "Parent";
+const QString JsonRecordSetSerializer::KeyReadOnly = "ReadOnly";
+
+
+void JsonRecordSetSerializer::serialize(QIODevice& device, const RecordSet& recordSet) const
+{
+    const int bufferSize = 64 * 1024;
+
+    QByteArray buffer;
+    buffer.reserve(bufferSize);
+
+    // Write records sorted by id, one per line.
+    const RecordList& records = recordSet.records;
+    const QVector<int>& recordIdOrder = this->getRecordIdOrder(recordSet);
+
+    for (int i = 0; i < recordIdOrder.size(); ++i)
+    {
+        const Record& record = records.at(recordIdOrder[i]);
+
+        // Report progress.
+        emit progressChanged(tr("Saving Data"), record.displayName, i, records.size());
+
+        // Write record.
+        QJsonObject recordObject;
+        recordObject.insert(KeyId, record.id.toString());
+        recordObject.insert(KeyDisplayName, record.displayName);
+
+        if (record.readOnly)
+        {
+            recordObject.insert(KeyReadOnly, true);
+        }
+
+        if (!record.parentId.isNull())
+        {
+            recordObject.insert(KeyParentId, record.parentId.toString());
+        }
+
+        if (!record.editorIconFieldId.isEmpty())
+        {
+            recordObject.insert(KeyEditorIconFieldId, record.editorIconFieldId);
+        }
+
+        // Write fields.
+        QJsonObject fieldsObject;
+
+        for (RecordFieldValueMap::const_iterator it = record.fieldValues.cbegin();
+             it != record.fieldValues.cend();
+             ++it)
+        {
+            fieldsObject.insert(it.key(), this->writeFieldValue(it.value()));
+        }
+
+        recordObject.insert(KeyFields, fieldsObject);
+
+        buffer.append(QJsonDocument(recordObject).toJson(QJsonDocument::Compact));
+        buffer.append('\n');
+
+        if (buffer.size() >= bufferSize)
+        {
+            device.write(buffer);
+            buffer.resize(0);
+        }
+    }
+
+    device.write(buffer);
+
+    // Report finish.
+    emit progressChanged(tr("Saving Data"), QString(), 1, 1);
+}
+
+void JsonRecordSetSerializer::deserialize(QIODevice& device, RecordSet& recordSet) const
+{
+    int lineNumber = 0;
+
+    while (!device.atEnd())
+    {
+        const QByteArray line = device.readLine();
+        ++lineNumber;
+
+        if (line.trimmed().isEmpty())
+        {
+            continue;
+        }
+
+        // Parse line.
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+
+        if (error.error != QJsonParseError::NoError || !document.isObject())
+        {
+            const QString errorMessage = QObject::tr("Invalid record in line %1: %2")
+                    .arg(QString::number(lineNumber), error.errorString());
+            throw std::runtime_error(errorMessage.toStdString());
+        }
+
+        const QJsonObject recordObject = document.object();
+
+        // Read record.
+        Record record = Record();
+        record.id = recordObject.value(KeyId).toString();
+        record.displayName = recordObject.value(KeyDisplayName).toString();
+        record.editorIconFieldId = recordObject.value(KeyEditorIconFieldId).toString();
+        record.readOnly = recordObject.value(KeyReadOnly).toBool();
+        record.recordSetName = recordSet.name;
+
+        if (recordObject.contains(KeyParentId))
+        {
+            record.parentId = recordObject.value(KeyParentId).toString();
+        }
+
+        // Report progress.
+        emit progressChanged(tr("Loading Data"), record.displayName, device.pos(), device.size());
+
+        // Read fields.
+        const QJsonObject fieldsObject = recordObject.value(KeyFields).toObject();
+
+        for (QJsonObject::const_iterator it = fieldsObject.constBegin();
+             it != fieldsObject.constEnd();
+             ++it)
+        {
+            record.fieldValues[it.key()] = this->readFieldValue(it.value());
+        }
+
+        recordSet.records.push_back(record);
+    }
+
+    // Report finish.
+    emit progressChanged(tr("Loading Data"), QString(), 1, 1);
+}
+
+QVariant JsonRecordSetSerializer::readFieldValue(const QJsonValue& json) const
+{
+    if (json.isArray())
+    {
+        const QJsonArray array = json.toArray();
+        QVariantList list;
+
+        for (int i = 0; i < array.size(); ++i)
+        {
+            list.append(array.at(i).toString());
+        }
+
+        return list;
+    }
+
+    if (json.isObject())
+    {
+        const QJsonObject object = json.toObject();
+        QVariantMap map;
+
+        for (QJsonObject::const_iterator it = object.constBegin();
+             it != object.constEnd();
+             ++it)
+        {
+            map[it.key()] = it.value().toString();
+        }
+
+        return map;
+    }
+
+    return json.toString();
+}
+
+QJsonValue JsonRecordSetSerializer::writeFieldValue(const QVariant& value) const
+{
+    // Empty lists and maps are read back from XML as empty strings, so write them the same way.
+    if (value.canConvert<QVariantList>() && !value.toList().isEmpty())
+    {
+        const QVariantList list = value.toList();
+        QJsonArray array;
+
+        for (int i = 0; i < list.size(); ++i)
+        {
+            array.append(list[i].toString());
+        }
+
+        return array;
+    }
+
+    if (value.canConvert<QVariantMap>() && !value.toMap().isEmpty())
+    {
+        const QVariantMap map = value.toMap();
+        QJsonObject object;
+
+        for (QVariantMap::const_iterator it = map.cbegin(); it != map.cend(); ++it)
+        {
+            object.insert(it.key(), it.value().toString());
+        }
+
+        return object;
+    }
+
+    return value.toString();
+}
@@ -0,0 +1,52 @@
+#ifndef JSONRECORDSETSERIALIZER_H
+#define JSONRECORDSETSERIALIZER_H
+
+#include <QJsonValue>
+
+#include "recordsetserializer.h"
+
+namespace Tome
+{
+    /**
+     * @brief Reads and writes records from any device, as line-oriented JSON.
+     *
+     * Each line holds one complete record as compact JSON object, ordered by record id.
+     * All field values are stored as strings, lists and maps of strings, just like in the XML format,
+     * which allows converting between both formats without losing any data.
+     */
+    class JsonRecordSetSerializer : public RecordSetSerializer
+    {
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief Writes the passed record set to the specified device.
+             * @param device Device to write the record set to.
+             * @param recordSet Record set to write.
+             */
+            void serialize(QIODevice& device, const RecordSet& recordSet) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief Reads the passed record set from the specified device.
+             *
+             * @exception std::runtime_error if any line doesn't contain a valid record.
+             *
+             * @param device Device to read the record set from.
+             * @param recordSet Record set to fill.
+             */
+            void deserialize(QIODevice& device, RecordSet& recordSet) const Q_DECL_OVERRIDE;
+
+        private:
+            static const QString KeyDisplayName;
+            static const QString KeyEditorIconFieldId;
+            static const QString KeyFields;
+            static const QString KeyId;
+            static const QString KeyParentId;
+            static const QString KeyReadOnly;
+
+            QVariant readFieldValue(const QJsonValue& json) const;
+            QJsonValue writeFieldValue(const QVariant& value) const;
+    };
+}
+
+#endif // JSONRECORDSETSERIALIZER_H
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include <QCryptographicHash>
+#include <QHash>
 #include <QSet>
 #include <QTime>
 #include <QUuid>
@@ -101,6 +102,8 @@ const Record RecordsController::addRecord(const QVariant& id,
             RecordList& records = recordSet.records;
             int index = findInsertionIndex(records, record, recordLessThanDisplayName);
             records.insert(index, record);
+            recordSet.recordIdOrder.clear();
+            recordSet.dirtyShards.insert(getRecordShardIndex(record.id, recordSet.shardCount));
             emit this->recordAdded(record.id, displayName, QString());
             return record;
         }
@@ -115,6 +118,7 @@ void RecordsController::addRecordSet(const RecordSet& recordSet)
 {
     // Update model.
     this->model->push_back(recordSet);
+    this->markRecordSetChanged(this->model->last());
 
     // Notify listeners.
     emit this->recordSetsChanged();
@@ -232,9 +236,12 @@ const Record RecordsController::duplicateRecord(const QVariant& existingRecordId
             break;
         }
     }
-    RecordList& records = (*this->model)[recordSetIndex].records;
+    RecordSet& recordSet = (*this->model)[recordSetIndex];
+    RecordList& records = recordSet.records;
     int index = findInsertionIndex(records, newRecord, recordLessThanDisplayName);
     records.insert(index, newRecord);
+    recordSet.recordIdOrder.clear();
+    recordSet.dirtyShards.insert(getRecordShardIndex(newRecord.id, recordSet.shardCount));
     emit this->recordAdded(newRecord.id, newRecord.displayName, newRecord.parentId);
 
     return newRecord;
@@ -245,14 +252,13 @@ const RecordList RecordsController::getAncestors(const QVariant& id) const
     RecordList ancestors;
 
     // Climb hierarchy.
-    Record* record = this->getRecordById(id);
-    QVariant parentId = record->parentId;
+    QVariant parentId = this->getRecord(id).parentId;
 
     while (!parentId.isNull() && this->hasRecord(parentId))
     {
-        record = this->getRecordById(parentId);
-        ancestors.push_back(*record);
-        parentId = record->parentId;
+        const Record& record = this->getRecord(parentId);
+        ancestors.push_back(record);
+        parentId = record.parentId;
     }
 
     return ancestors;
@@ -363,7 +369,25 @@ const RecordSetList& RecordsController::getRecordSets() const
 
 const Record& RecordsController::getRecord(const QVariant& id) const
 {
-    return *this->getRecordById(id);
+    // Use const access only, so records can be read from multiple threads at once.
+    for (int i = 0; i < this->model->size(); ++i)
+    {
+        const RecordSet& recordSet = this->model->at(i);
+
+        for (int j = 0; j < recordSet.records.size(); ++j)
+        {
+            const Record& record = recordSet.records.at(j);
+
+            if (record.id == id)
+            {
+                return record;
+            }
+        }
+    }
+
+    const QString errorMessage = "Record not found: " + id.toString();
+    qCritical(qUtf8Printable(errorMessage));
+    throw std::out_of_range(errorMessage.toStdString());
 }
 
 const RecordList RecordsController::getRecords() const
@@ -450,14 +474,14 @@ const QStringList RecordsController::getRecordSetNames() const
 
 const RecordFieldValueMap RecordsController::getRecordFieldValues(const QVariant& id) const
 {
-    Record* record = this->getRecordById(id);
+    const Record& record = this->getRecord(id);
 
     // Get inherited values.
     RecordFieldValueMap fieldValues = this->getInheritedFieldValues(id);
 
     // Override inherited values.
-    for (RecordFieldValueMap::iterator it = record->fieldValues.begin();
-         it != record->fieldValues.end();
+    for (RecordFieldValueMap::const_iterator it = record.fieldValues.cbegin();
+         it != record.fieldValues.cend();
          ++it)
     {
         fieldValues[it.key()] = it.value();
@@ -476,11 +500,11 @@ bool RecordsController::hasRecord(const QVariant& id) const
 {
     for (int i = 0; i < this->model->size(); ++i)
     {
-        RecordSet& recordSet = (*this->model)[i];
+        const RecordSet& recordSet = this->model->at(i);
 
         for (int j = 0; j < recordSet.records.size(); ++j)
         {
-            Record& record = recordSet.records[j];
+            const Record& record = recordSet.records.at(j);
 
             if (record.id == id)
             {
@@ -569,7 +593,9 @@ void RecordsController::removeRecord(const QVariant& recordId)
 
             if (record.id == recordId)
             {
+                (*itSets).dirtyShards.insert(getRecordShardIndex(recordId, (*itSets).shardCount));
                 records.erase(it);
+                (*itSets).recordIdOrder.clear();
                 emit this->recordRemoved(recordId);
                 return;
             }
@@ -628,6 +654,7 @@ void RecordsController::reparentRecord(const QVariant& recordId, const QVariant&
     Record& record = *this->getRecordById(recordId);
     QVariant oldParentId = record.parentId;
     record.parentId = newParentId;
+    this->markRecordChanged(record);
     emit this->recordReparented(recordId, oldParentId, newParentId);
 }
 
@@ -635,6 +662,7 @@ void RecordsController::setReadOnly(const QVariant& recordId, const bool readOnl
 {
     Record& record = *this->getRecordById(recordId);
     record.readOnly = readOnly;
+    this->markRecordChanged(record);
 }
 
 void RecordsController::setRecordDisplayName(const QVariant& recordId, const QString& displayName)
@@ -651,6 +679,7 @@ void RecordsController::setRecordDisplayName(const QVariant& recordId, const QSt
           .arg(recordId.toString(), displayName)));
 
     record->displayName = displayName;
+    this->markRecordChanged(*record);
 
     // Notify listeners.
     emit this->recordUpdated(record->id, oldDisplayName, record->editorIconFieldId, record->id, displayName, record->editorIconFieldId);
@@ -665,6 +694,7 @@ void RecordsController::setRecordDisplayName(const QVariant& recordId, const QSt
              ++it)
         {
             std::sort((*it).records.begin(), (*it).records.end(), recordLessThanDisplayName);
+            (*it).recordIdOrder.clear();
         }
     }
 }
@@ -683,16 +713,47 @@ void RecordsController::setRecordEditorIconFieldId(const QVariant& recordId, con
           .arg(recordId.toString(), editorIconFieldId)));
 
     record->editorIconFieldId = editorIconFieldId;
+    this->markRecordChanged(*record);
 
     // Notify listeners.
     emit this->recordUpdated(record->id, record->displayName, oldEditorIconFieldId, record->id, record->displayName, editorIconFieldId);
 }
 
+void RecordsController::setRecordSetFormat(const QString& name, const RecordSetFormat::RecordSetFormat format)
+{
+    for (RecordSetList::iterator it = this->model->begin();
+         it != this->model->end();
+         ++it)
+    {
+        RecordSet& recordSet = *it;
+
+        if (recordSet.name == name)
+        {
+            qInfo(qUtf8Printable(QString("Changing format of record set %1 to %2.")
+                  .arg(name, RecordSetFormat::toString(format))));
+
+            recordSet.format = format;
+            this->markRecordSetChanged(recordSet);
+            return;
+        }
+    }
+
+    const QString errorMessage = "Record set not found: " + name;
+    qCritical(qUtf8Printable(errorMessage));
+    throw std::out_of_range(errorMessage.toStdString());
+}
+
 void RecordsController::setRecordSets(RecordSetList& model)
 {
     this->model = &model;
 
     this->verifyRecordIds();
+
+    // Verifying may have assigned new record ids.
+    for (RecordSet& recordSet : *this->model)
+    {
+        recordSet.recordIdOrder.clear();
+    }
 }
 
 void RecordsController::updateRecord(const QVariant oldId,
@@ -791,10 +852,103 @@ void RecordsController::updateRecordFieldValue(const QVariant& recordId, const Q
         record.fieldValues[fieldId] = fieldValue;
     }
 
+    this->markRecordChanged(record);
+
     // Notify listeners.
     emit recordFieldsChanged(recordId);
 }
 
+void RecordsController::updateRecords(const RecordList& addedRecords,
+                                      const RecordList& updatedRecords,
+                                      const QVariantList& removedRecordIds)
+{
+    qInfo(qUtf8Printable(QString("Updating records: %1 added, %2 updated, %3 removed.")
+          .arg(QString::number(addedRecords.count()),
+               QString::number(updatedRecords.count()),
+               QString::number(removedRecordIds.count()))));
+
+    // Verify record sets before changing anything.
+    const QStringList recordSetNames = this->getRecordSetNames();
+
+    for (const Record& addedRecord : addedRecords)
+    {
+        if (!recordSetNames.contains(addedRecord.recordSetName))
+        {
+            const QString errorMessage = "Record set not found: " + addedRecord.recordSetName;
+            qCritical(qUtf8Printable(errorMessage));
+            throw std::out_of_range(errorMessage.toStdString());
+        }
+    }
+
+    // Index records by id once, instead of searching all records for every change.
+    QHash<QString, Record*> recordIndex;
+
+    for (RecordSet& recordSet : *this->model)
+    {
+        for (Record& record : recordSet.records)
+        {
+            recordIndex.insert(record.id.toString(), &record);
+        }
+    }
+
+    // Replace records.
+    for (const Record& updatedRecord : updatedRecords)
+    {
+        Record* record = recordIndex.value(updatedRecord.id.toString());
+
+        if (record == nullptr)
+        {
+            const QString errorMessage = "Record not found: " + updatedRecord.id.toString();
+            qCritical(qUtf8Printable(errorMessage));
+            throw std::out_of_range(errorMessage.toStdString());
+        }
+
+        *record = updatedRecord;
+        this->markRecordChanged(*record);
+    }
+
+    // Remove and add records.
+    QSet<QString> removedIds;
+
+    for (const QVariant& removedRecordId : removedRecordIds)
+    {
+        removedIds.insert(removedRecordId.toString());
+    }
+
+    for (RecordSet& recordSet : *this->model)
+    {
+        RecordList& records = recordSet.records;
+
+        if (!removedIds.isEmpty())
+        {
+            for (int i = records.count() - 1; i >= 0; --i)
+            {
+                if (removedIds.contains(records[i].id.toString()))
+                {
+                    recordSet.dirtyShards.insert(getRecordShardIndex(records[i].id, recordSet.shardCount));
+                    records.removeAt(i);
+                }
+            }
+        }
+
+        for (const Record& addedRecord : addedRecords)
+        {
+            if (addedRecord.recordSetName == recordSet.name)
+            {
+                records.append(addedRecord);
+                recordSet.dirtyShards.insert(getRecordShardIndex(addedRecord.id, recordSet.shardCount));
+            }
+        }
+
+        // Sort record model once to ensure deterministic serialization.
+        std::sort(records.begin(), records.end(), recordLessThanDisplayName);
+        recordSet.recordIdOrder.clear();
+    }
+
+    // Notify listeners.
+    emit this->recordSetsChanged();
+}
+
 void RecordsController::onFieldAdded(const FieldDefinition& fieldDefinition)
 {
     this->moveFieldToComponent(fieldDefinition.id, QString(), fieldDefinition.component);
@@ -817,6 +971,7 @@ void RecordsController::onFieldRemoved(const FieldDefinition& fieldDefinition)
             Record& record = recordSet.records[j];
             if (record.fieldValues.remove(fieldDefinition.id) > 0)
             {
+                this->markRecordChanged(record);
                 changedRecords << record.id;
             }
         }
@@ -841,6 +996,7 @@ void RecordsController::addRecordField(const QVariant& recordId, const QString&
     const FieldDefinition& field =
             this->fieldDefinitionsController.getFieldDefinition(fieldId);
     record.fieldValues.insert(fieldId, field.defaultValue);
+    this->markRecordChanged(record);
 
     // Notify listeners.
     emit recordFieldsChanged(recordId);
@@ -856,6 +1012,33 @@ const QString RecordsController::generateUuid() const
     return QUuid::createUuid().toString().mid(1, 36);
 }
 
+void RecordsController::markRecordChanged(const Record& record)
+{
+    for (RecordSetList::iterator it = this->model->begin();
+         it != this->model->end();
+         ++it)
+    {
+        RecordSet& recordSet = *it;
+
+        if (recordSet.name == record.recordSetName)
+        {
+            recordSet.dirtyShards.insert(getRecordShardIndex(record.id, recordSet.shardCount));
+            recordSet.recordIdOrder.clear();
+            return;
+        }
+    }
+}
+
+void RecordsController::markRecordSetChanged(RecordSet& recordSet)
+{
+    recordSet.recordIdOrder.clear();
+
+    for (int i = 0; i < recordSet.shardCount; ++i)
+    {
+        recordSet.dirtyShards.insert(i);
+    }
+}
+
 Record* RecordsController::getRecordById(const QVariant& id) const
 {
     for (int i = 0; i < this->model->size(); ++i)
@@ -988,6 +1171,8 @@ void RecordsController::moveRecordToSet(const QVariant& recordId, const QString&
             int index = findInsertionIndex(records, record, recordLessThanDisplayName);
             record.recordSetName = recordSetName;
             records.insert(index, record);
+            recordSet.recordIdOrder.clear();
+            recordSet.dirtyShards.insert(getRecordShardIndex(rid, recordSet.shardCount));
             continue;
         }
         else
@@ -1000,6 +1185,8 @@ void RecordsController::moveRecordToSet(const QVariant& recordId, const QString&
                 if ((*it).id == rid)
                 {
                     records.erase(it);
+                    recordSet.recordIdOrder.clear();
+                    recordSet.dirtyShards.insert(getRecordShardIndex(rid, recordSet.shardCount));
                     break;
                 }
             }
@@ -1014,6 +1201,7 @@ void RecordsController::removeRecordField(const QVariant& recordId, const QStrin
 
     Record& record = *this->getRecordById(recordId);
     record.fieldValues.remove(fieldId);
+    this->markRecordChanged(record);
 
     // Remove inherited fields.
     RecordList descendants = this->getDescendents(recordId);
@@ -1043,6 +1231,8 @@ void RecordsController::renameRecordField(const QString oldFieldId, const QStrin
                 const QVariant fieldValue = record.fieldValues[oldFieldId];
                 record.fieldValues.remove(oldFieldId);
                 record.fieldValues.insert(newFieldId, fieldValue);
+                recordSet.dirtyShards.insert(getRecordShardIndex(record.id, recordSet.shardCount));
+                recordSet.recordIdOrder.clear();
 
                 // Notify listeners.
                 emit recordFieldsChanged(record.id);
@@ -1195,7 +1385,10 @@ void RecordsController::verifyRecordIntegerIds()
         qlonglong oldRecordIntegerId = record->id.toLongLong();
         qlonglong newRecordIntegerId = this->generateIntegerId();
 
+        // Both the old and the new shard of the record need to be rewritten.
+        this->markRecordChanged(*record);
         record->id = newRecordIntegerId;
+        this->markRecordChanged(*record);
 
         qWarning(QString("Record %1 had duplicate integer id, assigned new integer id %3.")
                  .arg(QString::number(oldRecordIntegerId), QString::number(newRecordIntegerId))
@@ -1248,6 +1441,7 @@ void RecordsController::verifyRecordUuids()
             if (record.id.isNull())
             {
                 record.id = this->generateUuid();
+                this->markRecordSetChanged(recordSet);
                 qWarning(qUtf8Printable(QString("Record %1 had no UUID, assigned %2.").arg(record.displayName, record.id.toString())));
             }
         }
@@ -294,6 +294,16 @@ namespace Tome
              */
             void setRecordEditorIconFieldId(const QVariant& recordId, const QString& editorIconFieldId);
 
+            /**
+             * @brief Changes the file format of the record set with the specified name. Takes effect the next time the project is saved.
+             *
+             * @throws std::out_of_range if the record set could not be found.
+             *
+             * @param name Name of the record set to change the format of.
+             * @param format New file format of the record set.
+             */
+            void setRecordSetFormat(const QString& name, const RecordSetFormat::RecordSetFormat format);
+
             /**
              * @brief Uses the specified list of record sets as model for this controller.
              *
@@ -337,6 +347,22 @@ namespace Tome
              */
             void updateRecordFieldValue(const QVariant& recordId, const QString& fieldId, const QVariant& fieldValue);
 
+            /**
+             * @brief Adds, replaces and removes many records at once, notifying listeners only once.
+             *
+             * Records are looked up by id through an index built once for the whole change,
+             * and affected record sets are sorted only once afterwards.
+             *
+             * @throws std::out_of_range if any record to replace could not be found, or if any record to add belongs to an unknown record set.
+             *
+             * @param addedRecords Records to add. Their record sets must exist.
+             * @param updatedRecords Records to replace the records with the same id with.
+             * @param removedRecordIds Ids of the records to remove. Children and references are not updated.
+             */
+            void updateRecords(const RecordList& addedRecords,
+                               const RecordList& updatedRecords,
+                               const QVariantList& removedRecordIds);
+
         signals:
             /**
              * @brief Progress of the current record operation has changed.
@@ -415,6 +441,8 @@ namespace Tome
             int generateIntegerId();
             const QString generateUuid() const;
             Record* getRecordById(const QVariant& id) const;
+            void markRecordChanged(const Record& record);
+            void markRecordSetChanged(RecordSet& recordSet);
             void moveFieldToComponent(const QString& fieldId, const QString& oldComponent, const QString& newComponent);
             void moveRecordToSet(const QVariant& recordId, const QString& recordSetName);
             void removeRecordField(const QVariant& recordId, const QString& fieldId);
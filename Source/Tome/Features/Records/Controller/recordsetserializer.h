@@ -2,32 +2,38 @@
 #define RECORDSETSERIALIZER_H
 
 #include <QIODevice>
+#include <QVector>
 
 namespace Tome
 {
     class RecordSet;
 
     /**
-     * @brief Reads and writes records from any device.
+     * @brief Reads and writes records from any device, in a specific file format.
      */
     class RecordSetSerializer : public QObject
     {
             Q_OBJECT
 
         public:
+            virtual ~RecordSetSerializer();
+
             /**
              * @brief Writes the passed record set to the specified device.
              * @param device Device to write the record set to.
              * @param recordSet Record set to write.
              */
-            void serialize(QIODevice& device, const RecordSet& recordSet) const;
+            virtual void serialize(QIODevice& device, const RecordSet& recordSet) const = 0;
 
             /**
              * @brief Reads the passed record set from the specified device.
+             *
+             * @exception std::runtime_error if the device contents are invalid.
+             *
              * @param device Device to read the record set from.
              * @param recordSet Record set to fill.
              */
-            void deserialize(QIODevice& device, RecordSet& recordSet) const;
+            virtual void deserialize(QIODevice& device, RecordSet& recordSet) const = 0;
 
         signals:
             /**
@@ -39,17 +45,13 @@ namespace Tome
              */
             void progressChanged(const QString title, const QString text, const int currentValue, const int maximumValue) const;
 
-        private:
-            static const QString ElementDisplayName;
-            static const QString ElementEditorIconFieldId;
-            static const QString ElementId;
-            static const QString ElementItem;
-            static const QString ElementKey;
-            static const QString ElementParentId;
-            static const QString ElementReadOnly;
-            static const QString ElementRecord;
-            static const QString ElementRecords;
-            static const QString ElementValue;
+        protected:
+            /**
+             * @brief Gets the indices of all records of the passed set, ordered by id, rebuilding them if necessary.
+             * @param recordSet Record set to get the record order of.
+             * @return Indices of all records of the passed set, ordered by id.
+             */
+            const QVector<int>& getRecordIdOrder(const RecordSet& recordSet) const;
     };
 }
 
@@ -0,0 +1,251 @@
+#include "xmlrecordsetserializer.h"
+
+#include "../Model/recordset.h"
+#include "../../../IO/xmlreader.h"
+#include "../../../IO/xmlwriter.h"
+
+using namespace Tome;
+
+
+const QString XmlRecordSetSerializer::ElementDisplayName = "DisplayName";
+const QString XmlRecordSetSerializer::ElementEditorIconFieldId = "EditorIconFieldId";
+const QString XmlRecordSetSerializer::ElementId = "Id";
+const QString XmlRecordSetSerializer::ElementItem = "Item";
+const QString XmlRecordSetSerializer::ElementKey = "Key";
+const QString XmlRecordSetSerializer::ElementParentId = "Parent";
+const QString XmlRecordSetSerializer::ElementReadOnly = "ReadOnly";
+const QString XmlRecordSetSerializer::ElementRecord = "Record";
+const QString XmlRecordSetSerializer::ElementRecords = "Records";
+const QString XmlRecordSetSerializer::ElementValue = "Value";
+
+
+void XmlRecordSetSerializer::serialize(QIODevice& device, const RecordSet& recordSet) const
+{
+    // Encode element names once.
+    const QByteArray elementDisplayName = ElementDisplayName.toUtf8();
+    const QByteArray elementEditorIconFieldId = ElementEditorIconFieldId.toUtf8();
+    const QByteArray elementId = ElementId.toUtf8();
+    const QByteArray elementItem = ElementItem.toUtf8();
+    const QByteArray elementKey = ElementKey.toUtf8();
+    const QByteArray elementParentId = ElementParentId.toUtf8();
+    const QByteArray elementReadOnly = ElementReadOnly.toUtf8();
+    const QByteArray elementRecord = ElementRecord.toUtf8();
+    const QByteArray elementRecords = ElementRecords.toUtf8();
+    const QByteArray elementValue = ElementValue.toUtf8();
+
+    // Open device stream.
+    XmlWriter writer(&device);
+
+    // Begin document.
+    writer.writeStartDocument();
+    {
+        // Begin records.
+        writer.writeStartElement(elementRecords);
+        {
+            // Write records sorted by id, without copying them.
+            const RecordList& records = recordSet.records;
+            const QVector<int>& recordIdOrder = this->getRecordIdOrder(recordSet);
+
+            for (int i = 0; i < recordIdOrder.size(); ++i)
+            {
+                const Record& record = records.at(recordIdOrder[i]);
+
+                // Report progress.
+                emit progressChanged(tr("Saving Data"), record.displayName, i, records.size());
+
+                // Begin record.
+                writer.writeStartElement(elementRecord);
+                {
+                    // Write record.
+                    writer.writeAttribute(elementId, record.id.toString());
+                    writer.writeAttribute(elementDisplayName, record.displayName);
+
+                    if (record.readOnly)
+                    {
+                        writer.writeAttribute(elementReadOnly, "true");
+                    }
+
+                    if (!record.parentId.isNull())
+                    {
+                        writer.writeAttribute(elementParentId, record.parentId.toString());
+                    }
+
+                    if (!record.editorIconFieldId.isEmpty())
+                    {
+                        writer.writeAttribute(elementEditorIconFieldId, record.editorIconFieldId);
+                    }
+
+                    for (RecordFieldValueMap::const_iterator it = record.fieldValues.cbegin();
+                         it != record.fieldValues.cend();
+                         ++it)
+                    {
+                        const QVariant& value = it.value();
+
+                        // Write key.
+                        writer.writeStartElement(it.key());
+
+                        // Write value.
+                        {
+                            if (value.userType() == QMetaType::QVariantList)
+                            {
+                                const QVariantList& list = *reinterpret_cast<const QVariantList*>(value.constData());
+                                this->writeListItems(writer, elementItem, elementValue, list);
+                            }
+                            else if (value.userType() == QMetaType::QVariantMap)
+                            {
+                                const QVariantMap& map = *reinterpret_cast<const QVariantMap*>(value.constData());
+                                this->writeMapItems(writer, elementItem, elementKey, elementValue, map);
+                            }
+                            else if (value.canConvert<QVariantList>())
+                            {
+                                this->writeListItems(writer, elementItem, elementValue, value.toList());
+                            }
+                            else if (value.canConvert<QVariantMap>())
+                            {
+                                this->writeMapItems(writer, elementItem, elementKey, elementValue, value.toMap());
+                            }
+                            else
+                            {
+                                writer.writeAttribute(elementValue, value.toString());
+                            }
+                        }
+
+                        writer.writeEndElement();
+                    }
+                }
+                // End record.
+                writer.writeEndElement();
+            }
+        }
+        // End records.
+        writer.writeEndElement();
+    }
+    // End document.
+    writer.writeEndDocument();
+
+    // Report finish.
+    emit progressChanged(tr("Saving Data"), QString(), 1, 1);
+}
+
+void XmlRecordSetSerializer::deserialize(QIODevice& device, RecordSet& recordSet) const
+{
+    // Open device stream.
+    XmlReader reader(&device);
+
+    // Begin document.
+    reader.readStartDocument();
+    {
+        // Begin records.
+        reader.readStartElement(ElementRecords);
+        {
+            // Read records.
+            while (reader.isAtElement(ElementRecord))
+            {
+                // Add new record.
+                Record record = Record();
+
+                // Read record.
+                record.id = reader.readAttribute(ElementId);
+                record.displayName = reader.readAttribute(ElementDisplayName);
+                record.editorIconFieldId = reader.readAttribute(ElementEditorIconFieldId);
+                record.parentId = reader.readAttribute(ElementParentId);
+                record.readOnly = reader.readAttribute(ElementReadOnly) == "true";
+                record.recordSetName = recordSet.name;
+
+                // Report progress. Device position doesn't change when reading in-memory data directly.
+                emit progressChanged(tr("Loading Data"), record.displayName, reader.getCharacterOffset(), reader.getCharacterCount());
+
+                reader.readStartElement(ElementRecord);
+
+                while (!reader.isAtElement(ElementRecord))
+                {
+                    QString key = reader.getElementName();
+                    QVariant value = reader.readAttribute(ElementValue);
+
+                    if (value.toString().isEmpty())
+                    {
+                        reader.readStartElement(key);
+                        {
+                            // Begin list or map.
+                            QVariantList list;
+                            QVariantMap map;
+
+                            while (reader.isAtElement(ElementItem))
+                            {
+                                // Read item.
+                                QString key = reader.readAttribute(ElementKey);
+                                QVariant value = reader.readAttribute(ElementValue);
+
+                                if (!key.isEmpty())
+                                {
+                                    map[key] = value;
+                                }
+                                else
+                                {
+                                    list.append(value);
+                                }
+
+                                reader.readEmptyElement(ElementItem);
+                            }
+
+                            if (!map.isEmpty())
+                            {
+                                value = map;
+                            }
+                            else if (!list.isEmpty())
+                            {
+                                value = list;
+                            }
+                        }
+                        reader.readEndElement();
+                    }
+                    else
+                    {
+                        reader.readEmptyElement(key);
+                    }
+
+                    record.fieldValues[key] = value;
+                }
+
+                recordSet.records.push_back(record);
+
+                reader.readEndElement();
+            }
+        }
+        // End records.
+        reader.readEndElement();
+    }
+    // End document.
+    reader.readEndDocument();
+
+    // Report finish.
+    emit progressChanged(tr("Loading Data"), QString(), 1, 1);
+}
+
+void XmlRecordSetSerializer::writeListItems(XmlWriter& writer,
+                                            const QByteArray& elementItem,
+                                            const QByteArray& elementValue,
+                                            const QVariantList& list) const
+{
+    for (int i = 0; i < list.size(); ++i)
+    {
+        writer.writeStartElement(elementItem);
+        writer.writeAttribute(elementValue, list[i].toString());
+        writer.writeEndElement();
+    }
+}
+
+void XmlRecordSetSerializer::writeMapItems(XmlWriter& writer,
+                                           const QByteArray& elementItem,
+                                           const QByteArray& elementKey,
+                                           const QByteArray& elementValue,
+                                           const QVariantMap& map) const
+{
+    for (QVariantMap::const_iterator it = map.cbegin(); it != map.cend(); ++it)
+    {
+        writer.writeStartElement(elementItem);
+        writer.writeAttribute(elementKey, it.key());
+        writer.writeAttribute(elementValue, it.value().toString());
+        writer.writeEndElement();
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef XMLRECORDSETSERIALIZER_H
+#define XMLRECORDSETSERIALIZER_H
+
+#include <QVariantList>
+#include <QVariantMap>
+
+#include "recordsetserializer.h"
+
+class XmlWriter;
+
+namespace Tome
+{
+    /**
+     * @brief Reads and writes records from any device, as XML.
+     */
+    class XmlRecordSetSerializer : public RecordSetSerializer
+    {
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief Writes the passed record set to the specified device.
+             * @param device Device to write the record set to.
+             * @param recordSet Record set to write.
+             */
+            void serialize(QIODevice& device, const RecordSet& recordSet) const Q_DECL_OVERRIDE;
+
+            /**
+             * @brief Reads the passed record set from the specified device.
+             * @param device Device to read the record set from.
+             * @param recordSet Record set to fill.
+             */
+            void deserialize(QIODevice& device, RecordSet& recordSet) const Q_DECL_OVERRIDE;
+
+        private:
+            static const QString ElementDisplayName;
+            static const QString ElementEditorIconFieldId;
+            static const QString ElementId;
+            static const QString ElementItem;
+            static const QString ElementKey;
+            static const QString ElementParentId;
+            static const QString ElementReadOnly;
+            static const QString ElementRecord;
+            static const QString ElementRecords;
+            static const QString ElementValue;
+
+            void writeListItems(XmlWriter& writer,
+                                const QByteArray& elementItem,
+                                const QByteArray& elementValue,
+                                const QVariantList& list) const;
+            void writeMapItems(XmlWriter& writer,
+                               const QByteArray& elementItem,
+                               const QByteArray& elementKey,
+                               const QByteArray& elementValue,
+                               const QVariantMap& map) const;
+    };
+}
+
+#endif // XMLRECORDSETSERIALIZER_H
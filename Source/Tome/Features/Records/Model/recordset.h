@@ -1,7 +1,11 @@
 #ifndef RECORDSET_H
 #define RECORDSET_H
 
+#include <QSet>
+#include <QVector>
+
 #include "recordlist.h"
+#include "recordsetformat.h"
 
 namespace Tome
 {
@@ -20,7 +24,55 @@ namespace Tome
              * @brief Records of this record set.
              */
             RecordList records;
+
+            /**
+             * @brief Format of the file this record set is stored in.
+             */
+            RecordSetFormat::RecordSetFormat format = RecordSetFormat::Xml;
+
+            /**
+             * @brief Number of files this record set is split into, assigning records by id hash. 1 for a single file.
+             */
+            int shardCount = 1;
+
+            /**
+             * @brief Indices of all shards of this record set with changes that haven't been saved yet.
+             */
+            mutable QSet<int> dirtyShards;
+
+            /**
+             * @brief Indices of all records of this set, ordered by id.
+             *
+             * Cleared whenever any record of this set is changed, and rebuilt on demand by the serializer.
+             */
+            mutable QVector<int> recordIdOrder;
     };
+
+    /**
+     * @brief Gets the index of the shard the record with the specified id is stored in.
+     * @param recordId Id of the record to get the shard of.
+     * @param shardCount Number of shards of the record set the record belongs to.
+     * @return Index of the shard the record with the specified id is stored in.
+     */
+    inline int getRecordShardIndex(const QVariant& recordId, int shardCount)
+    {
+        if (shardCount <= 1)
+        {
+            return 0;
+        }
+
+        // FNV-1a, to get the same shards on all platforms and Qt versions.
+        const QByteArray bytes = recordId.toString().toUtf8();
+        quint32 hash = 2166136261u;
+
+        for (int i = 0; i < bytes.size(); ++i)
+        {
+            hash ^= static_cast<quint8>(bytes[i]);
+            hash *= 16777619u;
+        }
+
+        return static_cast<int>(hash % static_cast<quint32>(shardCount));
+    }
 }
 
 #endif // RECORDSET_H
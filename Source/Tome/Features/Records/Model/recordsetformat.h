@@ -0,0 +1,50 @@
+#ifndef RECORDSETFORMAT_H
+#define RECORDSETFORMAT_H
+
+#include <QString>
+
+namespace Tome
+{
+    namespace RecordSetFormat
+    {
+        enum RecordSetFormat
+        {
+            Invalid,
+            Xml,
+            Json
+        };
+
+        inline const QString toString(RecordSetFormat recordSetFormat)
+        {
+            switch (recordSetFormat)
+            {
+                case RecordSetFormat::Invalid:
+                    return "Invalid";
+
+                case RecordSetFormat::Xml:
+                    return "Xml";
+
+                case RecordSetFormat::Json:
+                    return "Json";
+            }
+
+            return QString();
+        }
+
+        inline RecordSetFormat fromString(QString recordSetFormat)
+        {
+            if (recordSetFormat == "Xml")
+            {
+                return RecordSetFormat::Xml;
+            }
+            else if (recordSetFormat == "Json")
+            {
+                return RecordSetFormat::Json;
+            }
+
+            return RecordSetFormat::Invalid;
+        }
+    }
+}
+
+#endif // RECORDSETFORMAT_H
@@ -13,6 +13,10 @@ const QString SettingsController::SettingShowComponentNamesInRecordTable = "show
 const QString SettingsController::SettingShowDescriptionColumnInsteadOfFieldTooltips = "showDetailsColumnInsteadOfFieldTooltips";
 const QString SettingsController::SettingExpandRecordTreeOnRefresh = "expandRecordTreeOnRefresh";
 const QString SettingsController::SettingLastProjectPath = "lastProjectPath";
+const QString SettingsController::SettingParallelExport = "parallelExport";
+const QString SettingsController::SettingIncrementalExport = "incrementalExport";
+const QString SettingsController::SettingStreamingExportHash = "streamingExportHash";
+const QString SettingsController::SettingCompressedExport = "compressedExport";
 
 
 SettingsController::SettingsController()
@@ -87,6 +91,26 @@ const QString SettingsController::getLastProjectPath() const
     return this->settings->value(SettingLastProjectPath).toString();
 }
 
+bool SettingsController::getParallelExport() const
+{
+    return this->settings->value(SettingParallelExport).toBool();
+}
+
+bool SettingsController::getIncrementalExport() const
+{
+    return this->settings->value(SettingIncrementalExport).toBool();
+}
+
+bool SettingsController::getStreamingExportHash() const
+{
+    return this->settings->value(SettingStreamingExportHash).toBool();
+}
+
+bool SettingsController::getCompressedExport() const
+{
+    return this->settings->value(SettingCompressedExport).toBool();
+}
+
 void SettingsController::removeRecentProject(const QString& path)
 {
     qInfo(qUtf8Printable(QString("Removing %1 from recent projects list.").arg(path)));
@@ -142,6 +166,34 @@ void SettingsController::setExpandRecordTreeOnRefresh(bool expandRecordTreeOnRef
     this->settings->setValue(SettingExpandRecordTreeOnRefresh, expandRecordTreeOnRefresh);
 }
 
+void SettingsController::setParallelExport(bool parallelExport)
+{
+    qInfo(qUtf8Printable(QString("Setting parallel export to %1.")
+          .arg(parallelExport ? "true" : "false")));
+    this->settings->setValue(SettingParallelExport, parallelExport);
+}
+
+void SettingsController::setIncrementalExport(bool incrementalExport)
+{
+    qInfo(qUtf8Printable(QString("Setting incremental export to %1.")
+          .arg(incrementalExport ? "true" : "false")));
+    this->settings->setValue(SettingIncrementalExport, incrementalExport);
+}
+
+void SettingsController::setStreamingExportHash(bool streamingExportHash)
+{
+    qInfo(qUtf8Printable(QString("Setting streaming export hash to %1.")
+          .arg(streamingExportHash ? "true" : "false")));
+    this->settings->setValue(SettingStreamingExportHash, streamingExportHash);
+}
+
+void SettingsController::setCompressedExport(bool compressedExport)
+{
+    qInfo(qUtf8Printable(QString("Setting compressed export to %1.")
+          .arg(compressedExport ? "true" : "false")));
+    this->settings->setValue(SettingCompressedExport, compressedExport);
+}
+
 void SettingsController::setLastProjectPath( const QString &path )
 
 {
@@ -66,6 +66,30 @@ namespace Tome
              */
             const QString getLastProjectPath() const;
 
+            /**
+             * @brief Gets whether to render records on multiple threads when exporting.
+             * @return Whether to render records on multiple threads when exporting, or not.
+             */
+            bool getParallelExport() const;
+
+            /**
+             * @brief Gets whether to re-render only records that have changed since the previous export.
+             * @return Whether to re-render only records that have changed since the previous export, or not.
+             */
+            bool getIncrementalExport() const;
+
+            /**
+             * @brief Gets whether to compute export hashes while writing the output, instead of hashing all records up front.
+             * @return Whether to compute export hashes while writing the output, or not.
+             */
+            bool getStreamingExportHash() const;
+
+            /**
+             * @brief Gets whether to gzip-compress exported files.
+             * @return Whether to gzip-compress exported files, or not.
+             */
+            bool getCompressedExport() const;
+
             /**
              * @brief Removes the specified full project path from the list of recent projects.
              * @param path Path of the project to remove.
@@ -108,6 +132,30 @@ namespace Tome
              */
             void setExpandRecordTreeOnRefresh(bool expandRecordTreeOnRefresh);
 
+            /**
+             * @brief Sets whether to render records on multiple threads when exporting, or not.
+             * @param parallelExport Whether to render records on multiple threads when exporting.
+             */
+            void setParallelExport(bool parallelExport);
+
+            /**
+             * @brief Sets whether to re-render only records that have changed since the previous export, or not.
+             * @param incrementalExport Whether to re-render only records that have changed since the previous export.
+             */
+            void setIncrementalExport(bool incrementalExport);
+
+            /**
+             * @brief Sets whether to compute export hashes while writing the output, instead of hashing all records up front.
+             * @param streamingExportHash Whether to compute export hashes while writing the output.
+             */
+            void setStreamingExportHash(bool streamingExportHash);
+
+            /**
+             * @brief Sets whether to gzip-compress exported files, or not.
+             * @param compressedExport Whether to gzip-compress exported files.
+             */
+            void setCompressedExport(bool compressedExport);
+
             /**
              * @brief Sets the full path to the most recently opened project.
              * @param path Full path to the most recently opened project.
@@ -123,6 +171,10 @@ namespace Tome
             static const QString SettingShowDescriptionColumnInsteadOfFieldTooltips;
             static const QString SettingExpandRecordTreeOnRefresh;
             static const QString SettingLastProjectPath;
+            static const QString SettingParallelExport;
+            static const QString SettingIncrementalExport;
+            static const QString SettingStreamingExportHash;
+            static const QString SettingCompressedExport;
 
             QSettings* settings;
     };
@@ -45,6 +45,26 @@ bool UserSettingsWindow::getExpandRecordTreeOnRefresh()
     return this->ui->checkBoxExpandRecordTreeOnRefresh->isChecked();
 }
 
+bool UserSettingsWindow::getParallelExport()
+{
+    return this->ui->checkBoxParallelExport->isChecked();
+}
+
+bool UserSettingsWindow::getIncrementalExport()
+{
+    return this->ui->checkBoxIncrementalExport->isChecked();
+}
+
+bool UserSettingsWindow::getStreamingExportHash()
+{
+    return this->ui->checkBoxStreamingExportHash->isChecked();
+}
+
+bool UserSettingsWindow::getCompressedExport()
+{
+    return this->ui->checkBoxCompressedExport->isChecked();
+}
+
 void UserSettingsWindow::showEvent(QShowEvent* event)
 {
     Q_UNUSED(event)
@@ -64,4 +84,16 @@ void UserSettingsWindow::showEvent(QShowEvent* event)
 
     bool expandRecordTreeOnRefresh = this->settingsController.getExpandRecordTreeOnRefresh();
     this->ui->checkBoxExpandRecordTreeOnRefresh->setChecked(expandRecordTreeOnRefresh);
+
+    bool parallelExport = this->settingsController.getParallelExport();
+    this->ui->checkBoxParallelExport->setChecked(parallelExport);
+
+    bool incrementalExport = this->settingsController.getIncrementalExport();
+    this->ui->checkBoxIncrementalExport->setChecked(incrementalExport);
+
+    bool streamingExportHash = this->settingsController.getStreamingExportHash();
+    this->ui->checkBoxStreamingExportHash->setChecked(streamingExportHash);
+
+    bool compressedExport = this->settingsController.getCompressedExport();
+    this->ui->checkBoxCompressedExport->setChecked(compressedExport);
 }
@@ -60,6 +60,30 @@ class UserSettingsWindow : public QDialog
          */
         bool getExpandRecordTreeOnRefresh();
 
+        /**
+         * @brief Gets whether to render records on multiple threads when exporting.
+         * @return Whether to render records on multiple threads when exporting, or not.
+         */
+        bool getParallelExport();
+
+        /**
+         * @brief Gets whether to re-render only records that have changed since the previous export.
+         * @return Whether to re-render only records that have changed since the previous export, or not.
+         */
+        bool getIncrementalExport();
+
+        /**
+         * @brief Gets whether to compute export hashes while writing the output, instead of hashing all records up front.
+         * @return Whether to compute export hashes while writing the output, or not.
+         */
+        bool getStreamingExportHash();
+
+        /**
+         * @brief Gets whether to gzip-compress exported files.
+         * @return Whether to gzip-compress exported files, or not.
+         */
+        bool getCompressedExport();
+
     protected:
         /**
          * @brief Sets up this window, updating the view with the stored settings.
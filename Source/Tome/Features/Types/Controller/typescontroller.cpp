@@ -88,7 +88,25 @@ const QStringList TypesController::getBuiltInTypes() const
 
 const CustomType& TypesController::getCustomType(const QString& name) const
 {
-    return *this->getCustomTypeByName(name);
+    // Use const access only, so types can be read from multiple threads at once.
+    for (int i = 0; i < this->model->size(); ++i)
+    {
+        const CustomTypeSet& typeSet = this->model->at(i);
+
+        for (int j = 0; j < typeSet.types.size(); ++j)
+        {
+            const CustomType& type = typeSet.types.at(j);
+
+            if (type.name == name)
+            {
+                return type;
+            }
+        }
+    }
+
+    const QString errorMessage = "Type not found: " + name;
+    qCritical(qUtf8Printable(errorMessage));
+    throw std::out_of_range(errorMessage.toStdString());
 }
 
 const CustomTypeList TypesController::getCustomTypes() const
@@ -0,0 +1,216 @@
+#include "csvreader.h"
+
+#include <cstring>
+#include <limits>
+
+
+CsvReader::CsvReader(const QByteArray& data, char delimiter)
+    : CsvReader(data.constData(), data.size(), QByteArray(1, delimiter))
+{
+}
+
+CsvReader::CsvReader(const char* data, qint64 size, const QByteArray& delimiter)
+    : data(data),
+      size(size),
+      delimiter(delimiter)
+{
+    // Skip byte order mark.
+    if (this->size >= 3 && !memcmp(this->data, "\xEF\xBB\xBF", 3))
+    {
+        this->position = 3;
+    }
+
+    // Reserve memory once, so it's kept when clearing rows.
+    this->fields.reserve(64);
+    this->unescapedData.reserve(256);
+}
+
+qint64 CsvReader::findFieldEnd(qint64 from) const
+{
+    const char delimiterStart = this->delimiter[0];
+
+    while (from < this->size)
+    {
+        const char c = this->data[from];
+
+        if ((c == delimiterStart && this->isDelimiterAt(from)) || c == '\n' || c == '\r')
+        {
+            break;
+        }
+
+        ++from;
+    }
+
+    return from;
+}
+
+int CsvReader::getFieldCount() const
+{
+    return this->fields.size();
+}
+
+const char* CsvReader::getFieldData(int index) const
+{
+    const CsvField& field = this->fields.at(index);
+
+    return field.unescaped
+            ? this->unescapedData.constData() + field.offset
+            : this->data + field.offset;
+}
+
+qint64 CsvReader::getFieldSize(int index) const
+{
+    return this->fields.at(index).size;
+}
+
+QString CsvReader::getField(int index) const
+{
+    // Strings can't hold more than 2 GB anyway.
+    const qint64 size = qMin<qint64>(this->getFieldSize(index), std::numeric_limits<int>::max());
+    return QString::fromUtf8(this->getFieldData(index), static_cast<int>(size));
+}
+
+qint64 CsvReader::getPosition() const
+{
+    return this->position;
+}
+
+int CsvReader::getRowCount() const
+{
+    return this->rowCount;
+}
+
+bool CsvReader::hasUnterminatedQuote() const
+{
+    return this->unterminatedQuote;
+}
+
+bool CsvReader::isDelimiterAt(qint64 position) const
+{
+    return this->size - position >= this->delimiter.size() &&
+            !memcmp(this->data + position, this->delimiter.constData(), this->delimiter.size());
+}
+
+bool CsvReader::readRow()
+{
+    // Skip empty lines.
+    while (this->position < this->size &&
+           (this->data[this->position] == '\n' || this->data[this->position] == '\r'))
+    {
+        ++this->position;
+    }
+
+    if (this->position >= this->size)
+    {
+        return false;
+    }
+
+    this->fields.resize(0);
+    this->unescapedData.resize(0);
+    this->unterminatedQuote = false;
+
+    for (;;)
+    {
+        if (this->position < this->size && this->data[this->position] == '"')
+        {
+            this->readQuotedField();
+        }
+        else
+        {
+            this->readUnquotedField();
+        }
+
+        // Check for next field.
+        if (this->isDelimiterAt(this->position))
+        {
+            this->position += this->delimiter.size();
+            continue;
+        }
+
+        // Skip line break.
+        if (this->position < this->size && this->data[this->position] == '\r')
+        {
+            ++this->position;
+        }
+
+        if (this->position < this->size && this->data[this->position] == '\n')
+        {
+            ++this->position;
+        }
+
+        break;
+    }
+
+    ++this->rowCount;
+    return true;
+}
+
+void CsvReader::readQuotedField()
+{
+    // Skip opening quote.
+    ++this->position;
+
+    const qint64 fieldStart = this->position;
+    const int unescapedStart = this->unescapedData.size();
+
+    qint64 segmentStart = this->position;
+    qint64 segmentEnd;
+    bool unescaped = false;
+
+    for (;;)
+    {
+        const char* quote = static_cast<const char*>(
+                    memchr(this->data + this->position, '"', this->size - this->position));
+
+        if (!quote)
+        {
+            // Missing closing quote. Field contains all remaining data.
+            this->unterminatedQuote = true;
+            segmentEnd = this->size;
+            this->position = this->size;
+            break;
+        }
+
+        const qint64 quotePosition = quote - this->data;
+
+        if (quotePosition + 1 < this->size && this->data[quotePosition + 1] == '"')
+        {
+            // Escaped quote. Copy everything up to and including the first quote.
+            this->unescapedData.append(this->data + segmentStart, static_cast<int>(quotePosition + 1 - segmentStart));
+            unescaped = true;
+
+            this->position = quotePosition + 2;
+            segmentStart = this->position;
+            continue;
+        }
+
+        // Closing quote.
+        segmentEnd = quotePosition;
+        this->position = quotePosition + 1;
+        break;
+    }
+
+    // Keep any text between closing quote and next delimiter, as most spreadsheet applications do.
+    const qint64 trailingStart = this->position;
+    this->position = this->findFieldEnd(trailingStart);
+
+    if (!unescaped && this->position == trailingStart)
+    {
+        // Field can be viewed in place.
+        this->fields.append({ fieldStart, segmentEnd - fieldStart, false });
+        return;
+    }
+
+    this->unescapedData.append(this->data + segmentStart, static_cast<int>(segmentEnd - segmentStart));
+    this->unescapedData.append(this->data + trailingStart, static_cast<int>(this->position - trailingStart));
+
+    this->fields.append({ unescapedStart, this->unescapedData.size() - unescapedStart, true });
+}
+
+void CsvReader::readUnquotedField()
+{
+    const qint64 fieldStart = this->position;
+    this->position = this->findFieldEnd(fieldStart);
+
+    this->fields.append({ fieldStart, this->position - fieldStart, false });
+}
@@ -0,0 +1,119 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Reads UTF-8 CSV data as specified by RFC 4180 forward-only, row by row.
+ *
+ * Fields may be enclosed in double quotes, in which case they may contain delimiters, line breaks and
+ * double quotes escaped by doubling them. Rows may end with CRLF, LF or CR. Empty lines are skipped.
+ *
+ * Fields are provided as views into the passed data, so rows can be read without allocating memory.
+ * Only fields containing escaped double quotes are copied to an internal buffer, which is reused for every row.
+ * The passed data must stay valid and unchanged while reading, which makes this a good fit for MappedFile.
+ */
+class CsvReader
+{
+    public:
+        /**
+         * @brief Constructs a new CSV reader for the passed data.
+         * @param data UTF-8 CSV data to read. A leading byte order mark is skipped.
+         * @param delimiter ASCII character separating the fields of a row.
+         */
+        CsvReader(const QByteArray& data, char delimiter = ',');
+
+        /**
+         * @brief Constructs a new CSV reader for the passed data, which may exceed the size of a QByteArray.
+         * @param data UTF-8 CSV data to read. A leading byte order mark is skipped.
+         * @param size Size of the data to read, in bytes.
+         * @param delimiter Non-empty UTF-8 string separating the fields of a row. Must not contain quotes or line breaks.
+         */
+        CsvReader(const char* data, qint64 size, const QByteArray& delimiter);
+
+        /**
+         * @brief Gets the number of fields of the current row.
+         * @return Number of fields of the current row.
+         */
+        int getFieldCount() const;
+
+        /**
+         * @brief Gets the UTF-8 data of the field with the specified index in the current row, without enclosing quotes.
+         * Only valid until the next row is read.
+         * @param index Index of the field to get the data of.
+         * @return UTF-8 data of the field. Not null-terminated.
+         */
+        const char* getFieldData(int index) const;
+
+        /**
+         * @brief Gets the size of the field with the specified index in the current row, in bytes.
+         * @param index Index of the field to get the size of.
+         * @return Size of the field, in bytes.
+         */
+        qint64 getFieldSize(int index) const;
+
+        /**
+         * @brief Decodes the field with the specified index in the current row.
+         * @param index Index of the field to decode.
+         * @return Decoded field.
+         */
+        QString getField(int index) const;
+
+        /**
+         * @brief Gets the number of bytes read so far.
+         * @return Number of bytes read so far.
+         */
+        qint64 getPosition() const;
+
+        /**
+         * @brief Gets the number of rows read so far, including the current one.
+         * @return Number of rows read so far.
+         */
+        int getRowCount() const;
+
+        /**
+         * @brief Checks whether the last field of the current row has an opening quote without a closing one.
+         *
+         * In that case, the field contains all remaining data.
+         *
+         * @return true, if the current row ends with an unterminated quoted field, and false otherwise.
+         */
+        bool hasUnterminatedQuote() const;
+
+        /**
+         * @brief Reads the next row.
+         * @return true, if another row has been read, and false if the end of the data has been reached.
+         */
+        bool readRow();
+
+    private:
+        /**
+         * @brief Location of a field of the current row, either in the source data or in the buffer of unescaped fields.
+         */
+        struct CsvField
+        {
+            qint64 offset;
+            qint64 size;
+            bool unescaped;
+        };
+
+        const char* const data;
+        const qint64 size;
+        const QByteArray delimiter;
+
+        qint64 position = 0;
+        int rowCount = 0;
+        bool unterminatedQuote = false;
+
+        QVector<CsvField> fields;
+        QByteArray unescapedData;
+
+        qint64 findFieldEnd(qint64 from) const;
+        bool isDelimiterAt(qint64 position) const;
+        void readQuotedField();
+        void readUnquotedField();
+};
+
+#endif // CSVREADER_H
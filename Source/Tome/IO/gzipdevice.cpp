@@ -0,0 +1,145 @@
+#include "gzipdevice.h"
+
+#include <QObject>
+
+
+const int GzipDevice::BufferSize = 64 * 1024;
+
+
+GzipDevice::GzipDevice(QIODevice& device, int compressionLevel)
+    : device(device),
+      compressionLevel(compressionLevel),
+      buffer(BufferSize, '\0')
+{
+}
+
+GzipDevice::~GzipDevice()
+{
+    this->close();
+}
+
+void GzipDevice::close()
+{
+    this->finish();
+}
+
+bool GzipDevice::finish()
+{
+    if (!this->isOpen())
+    {
+        return true;
+    }
+
+    // Flush remaining data and write gzip trailer.
+    QString errorString;
+
+    if (!this->compress(Z_FINISH))
+    {
+        errorString = this->errorString();
+    }
+
+    if (deflateEnd(&this->stream) != Z_OK && errorString.isEmpty())
+    {
+        errorString = QObject::tr("Data could not be compressed.");
+    }
+
+    // Closing resets the error string.
+    QIODevice::close();
+
+    if (!errorString.isEmpty())
+    {
+        this->setErrorString(errorString);
+        return false;
+    }
+
+    return true;
+}
+
+bool GzipDevice::isSequential() const
+{
+    return true;
+}
+
+bool GzipDevice::open(OpenMode mode)
+{
+    if ((mode & ReadOnly) != 0)
+    {
+        this->setErrorString(QObject::tr("Gzip devices can't be read."));
+        return false;
+    }
+
+    this->stream.zalloc = Z_NULL;
+    this->stream.zfree = Z_NULL;
+    this->stream.opaque = Z_NULL;
+
+    // Adding 16 to the window bits writes a gzip header and trailer instead of a zlib wrapper.
+    if (deflateInit2(&this->stream, this->compressionLevel, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        this->setErrorString(QObject::tr("Gzip stream could not be initialized."));
+        return false;
+    }
+
+    return QIODevice::open(mode | Unbuffered);
+}
+
+qint64 GzipDevice::readData(char* data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+
+    return -1;
+}
+
+qint64 GzipDevice::writeData(const char* data, qint64 maxSize)
+{
+    qint64 written = 0;
+
+    // Compress in chunks, as zlib takes at most 4 GB at once.
+    while (written < maxSize)
+    {
+        const uInt size = static_cast<uInt>(qMin<qint64>(maxSize - written, BufferSize));
+
+        this->stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + written));
+        this->stream.avail_in = size;
+
+        if (!this->compress(Z_NO_FLUSH))
+        {
+            return -1;
+        }
+
+        written += size;
+    }
+
+    return written;
+}
+
+bool GzipDevice::compress(int flush)
+{
+    int result;
+
+    do
+    {
+        this->stream.next_out = reinterpret_cast<Bytef*>(this->buffer.data());
+        this->stream.avail_out = BufferSize;
+
+        result = deflate(&this->stream, flush);
+
+        if (result == Z_STREAM_ERROR)
+        {
+            this->setErrorString(QObject::tr("Data could not be compressed."));
+            return false;
+        }
+
+        // Forward compressed data.
+        const qint64 size = BufferSize - this->stream.avail_out;
+
+        if (size > 0 && this->device.write(this->buffer.constData(), size) != size)
+        {
+            this->setErrorString(this->device.errorString());
+            return false;
+        }
+    }
+    while (this->stream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+
+    return true;
+}
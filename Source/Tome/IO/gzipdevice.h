@@ -0,0 +1,67 @@
+#ifndef GZIPDEVICE_H
+#define GZIPDEVICE_H
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include <QtZlib/zlib.h>
+
+/**
+ * @brief Write-only device that compresses all data in gzip format, and forwards it to another device.
+ *
+ * Data is compressed while it is written, so the uncompressed output never has to be held in memory or on disk.
+ * The gzip stream is finished when the device is closed.
+ */
+class GzipDevice : public QIODevice
+{
+    public:
+        /**
+         * @brief Constructs a new device compressing all data written to it, without opening it yet.
+         * @param device Device to forward the compressed data to. Must be open for writing.
+         * @param compressionLevel zlib compression level, from 1 (fastest) to 9 (smallest).
+         */
+        GzipDevice(QIODevice& device, int compressionLevel = Z_DEFAULT_COMPRESSION);
+        ~GzipDevice();
+
+        /**
+         * @brief Finishes the gzip stream, and closes this device. Doesn't close the device the data is forwarded to.
+         *
+         * Errors are ignored. Call finish instead to check whether the stream could be finished.
+         */
+        void close();
+
+        /**
+         * @brief Finishes the gzip stream, and closes this device. Doesn't close the device the data is forwarded to.
+         * @return true, if the stream could be finished or the device wasn't open, and false otherwise.
+         */
+        bool finish();
+
+        /**
+         * @brief Checks whether this device is sequential, which it always is.
+         * @return true
+         */
+        bool isSequential() const;
+
+        /**
+         * @brief Opens this device for writing and starts a new gzip stream.
+         * @param mode Mode to open the device with. Must be write-only.
+         * @return true, if the device could be opened, and false otherwise.
+         */
+        bool open(OpenMode mode);
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize);
+        qint64 writeData(const char* data, qint64 maxSize);
+
+    private:
+        static const int BufferSize;
+
+        QIODevice& device;
+        int compressionLevel;
+        z_stream stream;
+        QByteArray buffer;
+
+        bool compress(int flush);
+};
+
+#endif // GZIPDEVICE_H
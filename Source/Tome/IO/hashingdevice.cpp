@@ -0,0 +1,48 @@
+#include "hashingdevice.h"
+
+
+HashingDevice::HashingDevice(QIODevice& device, QCryptographicHash::Algorithm algorithm)
+    : device(device),
+      hash(algorithm)
+{
+}
+
+qint64 HashingDevice::getBytesWritten() const
+{
+    return this->bytesWritten;
+}
+
+QByteArray HashingDevice::getHash() const
+{
+    return this->hash.result();
+}
+
+bool HashingDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 HashingDevice::readData(char* data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+
+    return -1;
+}
+
+qint64 HashingDevice::writeData(const char* data, qint64 maxSize)
+{
+    const qint64 written = this->device.write(data, maxSize);
+
+    if (written > 0)
+    {
+        this->hash.addData(data, static_cast<int>(written));
+        this->bytesWritten += written;
+    }
+    else if (written < 0)
+    {
+        this->setErrorString(this->device.errorString());
+    }
+
+    return written;
+}
@@ -0,0 +1,51 @@
+#ifndef HASHINGDEVICE_H
+#define HASHINGDEVICE_H
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QIODevice>
+
+/**
+ * @brief Write-only device that forwards all data to another device, hashing it on the way.
+ *
+ * Allows computing the hash of any output while it is being streamed, without reading it again afterwards.
+ */
+class HashingDevice : public QIODevice
+{
+    public:
+        /**
+         * @brief Constructs a new device forwarding all data to the specified device, without opening it yet.
+         * @param device Device to forward all written data to. Must be open for writing.
+         * @param algorithm Algorithm to hash written data with.
+         */
+        HashingDevice(QIODevice& device, QCryptographicHash::Algorithm algorithm = QCryptographicHash::Sha1);
+
+        /**
+         * @brief Gets the number of bytes written to this device so far.
+         * @return Number of bytes written to this device so far.
+         */
+        qint64 getBytesWritten() const;
+
+        /**
+         * @brief Gets the hash of all data written to this device so far.
+         * @return Hash of all data written to this device so far.
+         */
+        QByteArray getHash() const;
+
+        /**
+         * @brief Checks whether this device is sequential, which it always is.
+         * @return true
+         */
+        bool isSequential() const;
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize);
+        qint64 writeData(const char* data, qint64 maxSize);
+
+    private:
+        QIODevice& device;
+        QCryptographicHash hash;
+        qint64 bytesWritten = 0;
+};
+
+#endif // HASHINGDEVICE_H
@@ -0,0 +1,70 @@
+#include "mappedfile.h"
+
+#include <limits>
+
+
+MappedFile::MappedFile(const QString& fileName)
+    : file(fileName)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    this->buffer.close();
+
+    if (this->mappedData)
+    {
+        this->file.unmap(this->mappedData);
+    }
+}
+
+const QByteArray& MappedFile::getData() const
+{
+    return this->data;
+}
+
+const char* MappedFile::getBytes() const
+{
+    return this->mappedData ? reinterpret_cast<const char*>(this->mappedData) : this->data.constData();
+}
+
+QIODevice& MappedFile::getDevice()
+{
+    return this->buffer;
+}
+
+qint64 MappedFile::getSize() const
+{
+    return this->mappedData ? this->mappedSize : this->data.size();
+}
+
+bool MappedFile::open()
+{
+    if (!this->file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    const qint64 size = this->file.size();
+
+    // Map file, if possible. Empty files can't be mapped.
+    if (size > 0)
+    {
+        this->mappedData = this->file.map(0, size);
+    }
+
+    if (this->mappedData)
+    {
+        this->mappedSize = size;
+        this->data = QByteArray::fromRawData(reinterpret_cast<const char*>(this->mappedData),
+                                             static_cast<int>(qMin<qint64>(size, std::numeric_limits<int>::max())));
+    }
+    else
+    {
+        // Fall back to reading the file.
+        this->data = this->file.readAll();
+    }
+
+    this->buffer.setBuffer(&this->data);
+    return this->buffer.open(QIODevice::ReadOnly);
+}
@@ -0,0 +1,66 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QFile>
+
+/**
+ * @brief Provides read-only access to the contents of a file mapped into memory.
+ *
+ * Exposes the mapped bytes through a buffer device, so readers can work on them directly
+ * without copying them from the file first. Falls back to reading the whole file if it can't be mapped.
+ */
+class MappedFile
+{
+    public:
+        /**
+         * @brief Constructs a new mapped file for the file with the specified name, without opening it yet.
+         * @param fileName Name of the file to map.
+         */
+        MappedFile(const QString& fileName);
+        ~MappedFile();
+
+        /**
+         * @brief Gets the contents of the file. Only valid while the file is open.
+         *
+         * Byte arrays can't hold more than 2 GB, so larger files are truncated. Use getBytes and getSize instead
+         * to access all of their contents.
+         *
+         * @return Contents of the file.
+         */
+        const QByteArray& getData() const;
+
+        /**
+         * @brief Gets the raw contents of the file. Only valid while the file is open.
+         * @return Contents of the file.
+         */
+        const char* getBytes() const;
+
+        /**
+         * @brief Gets a read-only device providing the contents of the file. Only valid while the file is open.
+         * @return Device providing the contents of the file.
+         */
+        QIODevice& getDevice();
+
+        /**
+         * @brief Gets the size of the contents of the file, in bytes. Only valid while the file is open.
+         * @return Size of the contents of the file, in bytes.
+         */
+        qint64 getSize() const;
+
+        /**
+         * @brief Opens the file and maps its contents into memory.
+         * @return true, if the file could be opened, and false otherwise.
+         */
+        bool open();
+
+    private:
+        QFile file;
+        QBuffer buffer;
+        QByteArray data;
+        uchar* mappedData = nullptr;
+        qint64 mappedSize = 0;
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,414 @@
+#include "xlsxreader.h"
+
+#include <QObject>
+
+#include "zipentrydevice.h"
+
+
+const int XlsxReader::MaxColumnCount = 16384;
+const int XlsxReader::MaxReservedSharedStrings = 65536;
+const QString XlsxReader::RelationshipsNamespace = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+const QString XlsxReader::SharedStringsPath = "xl/sharedStrings.xml";
+const QString XlsxReader::WorkbookPath = "xl/workbook.xml";
+const QString XlsxReader::WorkbookRelationshipsPath = "xl/_rels/workbook.xml.rels";
+
+
+XlsxReader::XlsxReader(const QByteArray& data)
+    : data(data)
+{
+}
+
+XlsxReader::~XlsxReader()
+{
+}
+
+QString XlsxReader::getErrorString() const
+{
+    return this->errorString;
+}
+
+int XlsxReader::getProgress() const
+{
+    if (this->sheetDevice.isNull() || this->sheetDevice->getUncompressedSize() <= 0)
+    {
+        return 100;
+    }
+
+    const qint64 size = this->sheetDevice->getUncompressedSize();
+    const qint64 position = size - this->sheetDevice->bytesAvailable();
+    return static_cast<int>(position * 100 / size);
+}
+
+const QStringList& XlsxReader::getRow() const
+{
+    return this->row;
+}
+
+bool XlsxReader::hasError() const
+{
+    return !this->errorString.isEmpty();
+}
+
+bool XlsxReader::open(const QString& sheetName)
+{
+    this->errorString.clear();
+    this->sharedStrings.clear();
+
+    this->sheetPath = this->findSheetPath(sheetName);
+
+    if (this->sheetPath.isEmpty())
+    {
+        return false;
+    }
+
+    if (!this->readSharedStrings())
+    {
+        return false;
+    }
+
+    // Prepare reading sheet.
+    this->sheetDevice.reset(new ZipEntryDevice(this->data, this->sheetPath));
+
+    if (!this->sheetDevice->open(QIODevice::ReadOnly))
+    {
+        this->errorString = this->sheetDevice->errorString();
+        this->sheetDevice.reset();
+        return false;
+    }
+
+    this->sheetReader.setDevice(this->sheetDevice.data());
+    return true;
+}
+
+bool XlsxReader::readRow()
+{
+    if (this->sheetDevice.isNull() || this->hasError())
+    {
+        return false;
+    }
+
+    this->row.clear();
+
+    // Find next row.
+    while (!this->sheetReader.atEnd())
+    {
+        this->sheetReader.readNext();
+
+        if (this->sheetReader.isStartElement() && this->sheetReader.name() == "row")
+        {
+            break;
+        }
+    }
+
+    if (this->sheetReader.atEnd())
+    {
+        if (this->sheetReader.hasError())
+        {
+            this->setXmlError(this->sheetReader, this->sheetPath);
+        }
+
+        return false;
+    }
+
+    // Read cells.
+    int nextColumnIndex = 0;
+
+    while (!this->sheetReader.atEnd())
+    {
+        this->sheetReader.readNext();
+
+        if (this->sheetReader.isEndElement() && this->sheetReader.name() == "row")
+        {
+            return true;
+        }
+
+        if (!this->sheetReader.isStartElement() || this->sheetReader.name() != "c")
+        {
+            continue;
+        }
+
+        // Cells without reference follow the previous one.
+        const QXmlStreamAttributes attributes = this->sheetReader.attributes();
+        int columnIndex = this->getColumnIndex(attributes.value("r"));
+
+        if (columnIndex < 0)
+        {
+            columnIndex = nextColumnIndex;
+        }
+
+        // Spreadsheets end at column XFD.
+        if (columnIndex >= MaxColumnCount)
+        {
+            this->errorString = QObject::tr("Cell %1 is out of range in %2.")
+                    .arg(attributes.value("r").toString(), this->sheetPath);
+            return false;
+        }
+
+        const QString value = this->readCellValue(attributes.value("t").toString());
+
+        if (this->hasError())
+        {
+            return false;
+        }
+
+        // Fill missing cells.
+        while (this->row.size() < columnIndex)
+        {
+            this->row << QString();
+        }
+
+        if (columnIndex < this->row.size())
+        {
+            this->row[columnIndex] = value;
+        }
+        else
+        {
+            this->row << value;
+        }
+
+        nextColumnIndex = columnIndex + 1;
+    }
+
+    this->setXmlError(this->sheetReader, this->sheetPath);
+    return false;
+}
+
+int XlsxReader::getColumnIndex(const QStringRef& cellReference) const
+{
+    // Convert column letters of references like AB12 to zero-based index.
+    int columnNumber = 0;
+
+    for (const QChar c : cellReference)
+    {
+        if (c.unicode() < 'A' || c.unicode() > 'Z')
+        {
+            break;
+        }
+
+        columnNumber = columnNumber * 26 + (c.unicode() - 'A' + 1);
+
+        // Stop before overflowing. Caller rejects all columns beyond XFD.
+        if (columnNumber > MaxColumnCount)
+        {
+            break;
+        }
+    }
+
+    return columnNumber - 1;
+}
+
+QString XlsxReader::findSheetPath(const QString& sheetName)
+{
+    // Find relationship id of sheet.
+    ZipEntryDevice workbookDevice(this->data, WorkbookPath);
+
+    if (!workbookDevice.open(QIODevice::ReadOnly))
+    {
+        this->errorString = workbookDevice.errorString();
+        return QString();
+    }
+
+    QXmlStreamReader workbookReader(&workbookDevice);
+    QString relationshipId;
+
+    while (!workbookReader.atEnd())
+    {
+        workbookReader.readNext();
+
+        if (workbookReader.isStartElement() &&
+                workbookReader.name() == "sheet" &&
+                workbookReader.attributes().value("name") == sheetName)
+        {
+            relationshipId = workbookReader.attributes().value(RelationshipsNamespace, "id").toString();
+            break;
+        }
+    }
+
+    if (workbookReader.hasError())
+    {
+        this->setXmlError(workbookReader, WorkbookPath);
+        return QString();
+    }
+
+    if (relationshipId.isEmpty())
+    {
+        this->errorString = QObject::tr("Sheet %1 not found.").arg(sheetName);
+        return QString();
+    }
+
+    // Find sheet path.
+    ZipEntryDevice relationshipsDevice(this->data, WorkbookRelationshipsPath);
+
+    if (!relationshipsDevice.open(QIODevice::ReadOnly))
+    {
+        this->errorString = relationshipsDevice.errorString();
+        return QString();
+    }
+
+    QXmlStreamReader relationshipsReader(&relationshipsDevice);
+
+    while (!relationshipsReader.atEnd())
+    {
+        relationshipsReader.readNext();
+
+        if (relationshipsReader.isStartElement() &&
+                relationshipsReader.name() == "Relationship" &&
+                relationshipsReader.attributes().value("Id") == relationshipId)
+        {
+            // Targets are relative to the workbook, unless they are absolute.
+            const QString target = relationshipsReader.attributes().value("Target").toString();
+            return target.startsWith('/') ? target.mid(1) : "xl/" + target;
+        }
+    }
+
+    if (relationshipsReader.hasError())
+    {
+        this->setXmlError(relationshipsReader, WorkbookRelationshipsPath);
+        return QString();
+    }
+
+    this->errorString = QObject::tr("Sheet %1 not found.").arg(sheetName);
+    return QString();
+}
+
+QString XlsxReader::readCellValue(const QString& cellType)
+{
+    QString value;
+
+    while (!this->sheetReader.atEnd())
+    {
+        this->sheetReader.readNext();
+
+        if (this->sheetReader.isEndElement() && this->sheetReader.name() == "c")
+        {
+            break;
+        }
+
+        if (!this->sheetReader.isStartElement())
+        {
+            continue;
+        }
+
+        if (this->sheetReader.name() == "v")
+        {
+            value = this->sheetReader.readElementText();
+        }
+        else if (this->sheetReader.name() == "is")
+        {
+            value = this->readText(this->sheetReader, "is");
+        }
+        else
+        {
+            // Skip formulas.
+            this->sheetReader.skipCurrentElement();
+        }
+    }
+
+    if (this->sheetReader.hasError())
+    {
+        this->setXmlError(this->sheetReader, this->sheetPath);
+        return QString();
+    }
+
+    // Resolve shared strings.
+    if (cellType == "s")
+    {
+        bool ok;
+        const int index = value.toInt(&ok);
+
+        if (!ok || index < 0 || index >= this->sharedStrings.size())
+        {
+            this->errorString = QObject::tr("Shared string %1 not found.").arg(value);
+            return QString();
+        }
+
+        return this->sharedStrings[index];
+    }
+
+    if (cellType == "b")
+    {
+        return value == "1" ? "true" : "false";
+    }
+
+    return value;
+}
+
+bool XlsxReader::readSharedStrings()
+{
+    ZipEntryDevice sharedStringsDevice(this->data, SharedStringsPath);
+
+    if (!sharedStringsDevice.open(QIODevice::ReadOnly))
+    {
+        // Workbooks without any text cells don't have shared strings.
+        return true;
+    }
+
+    QXmlStreamReader sharedStringsReader(&sharedStringsDevice);
+
+    while (!sharedStringsReader.atEnd())
+    {
+        sharedStringsReader.readNext();
+
+        if (!sharedStringsReader.isStartElement())
+        {
+            continue;
+        }
+
+        if (sharedStringsReader.name() == "sst")
+        {
+            // Don't trust the count of the file for reserving memory beyond a reasonable limit.
+            const int uniqueCount = sharedStringsReader.attributes().value("uniqueCount").toInt();
+            this->sharedStrings.reserve(qBound(0, uniqueCount, MaxReservedSharedStrings));
+        }
+        else if (sharedStringsReader.name() == "si")
+        {
+            this->sharedStrings << this->readText(sharedStringsReader, "si");
+        }
+    }
+
+    if (sharedStringsReader.hasError())
+    {
+        return this->setXmlError(sharedStringsReader, SharedStringsPath);
+    }
+
+    return true;
+}
+
+QString XlsxReader::readText(QXmlStreamReader& reader, const QString& endElementName) const
+{
+    // Concatenate all runs of rich text, skipping phonetic hints.
+    QString text;
+
+    while (!reader.atEnd())
+    {
+        reader.readNext();
+
+        if (reader.isEndElement() && reader.name() == endElementName)
+        {
+            break;
+        }
+
+        if (!reader.isStartElement())
+        {
+            continue;
+        }
+
+        if (reader.name() == "t")
+        {
+            text += reader.readElementText();
+        }
+        else if (reader.name() == "rPh")
+        {
+            reader.skipCurrentElement();
+        }
+    }
+
+    return text;
+}
+
+bool XlsxReader::setXmlError(const QXmlStreamReader& reader, const QString& entryName)
+{
+    this->errorString = QObject::tr("%1 could not be read: %2 (line %3)")
+            .arg(entryName, reader.errorString(), QString::number(reader.lineNumber()));
+    return false;
+}
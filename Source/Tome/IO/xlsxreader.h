@@ -0,0 +1,94 @@
+#ifndef XLSXREADER_H
+#define XLSXREADER_H
+
+#include <QByteArray>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QXmlStreamReader>
+
+class ZipEntryDevice;
+
+/**
+ * @brief Reads the cell values of a single sheet of an Excel workbook (XLSX) forward-only, row by row.
+ *
+ * The sheet is decompressed and parsed while reading, so only the current row and the shared string table
+ * are held in memory, no matter how large the sheet is. Cell values are provided as stored in the workbook,
+ * i.e. numbers and dates are not formatted. Formulas are not evaluated, but their cached results are read.
+ * The passed data must stay valid and unchanged while reading, which makes this a good fit for MappedFile.
+ */
+class XlsxReader
+{
+    public:
+        /**
+         * @brief Constructs a new XLSX reader for the passed workbook data, without opening any sheet yet.
+         * @param data XLSX workbook to read.
+         */
+        XlsxReader(const QByteArray& data);
+        ~XlsxReader();
+
+        /**
+         * @brief Gets a description of the last error that occurred.
+         * @return Localized description of the last error that occurred.
+         */
+        QString getErrorString() const;
+
+        /**
+         * @brief Gets how much of the sheet has been read so far.
+         * @return Percentage of the sheet read so far, from 0 to 100.
+         */
+        int getProgress() const;
+
+        /**
+         * @brief Gets the values of all cells of the current row, by column index.
+         * Missing cells are returned as empty strings. Only valid until the next row is read.
+         * @return Values of all cells of the current row.
+         */
+        const QStringList& getRow() const;
+
+        /**
+         * @brief Checks whether reading the sheet has failed.
+         * @return true, if an error has occurred while reading, and false otherwise.
+         */
+        bool hasError() const;
+
+        /**
+         * @brief Reads the shared string table of the workbook, and prepares reading the sheet with the specified name.
+         * @param sheetName Name of the sheet to read, as shown in Excel.
+         * @return true, if the sheet could be found and opened, and false otherwise.
+         */
+        bool open(const QString& sheetName);
+
+        /**
+         * @brief Reads the next row. Empty rows that are not stored in the sheet are skipped.
+         * @return true, if another row has been read, and false if the end of the sheet has been reached or an error has occurred.
+         */
+        bool readRow();
+
+    private:
+        static const int MaxColumnCount;
+        static const int MaxReservedSharedStrings;
+        static const QString RelationshipsNamespace;
+        static const QString SharedStringsPath;
+        static const QString WorkbookPath;
+        static const QString WorkbookRelationshipsPath;
+
+        const QByteArray& data;
+
+        QStringList sharedStrings;
+        QStringList row;
+
+        QString sheetPath;
+        QScopedPointer<ZipEntryDevice> sheetDevice;
+        QXmlStreamReader sheetReader;
+        QString errorString;
+
+        int getColumnIndex(const QStringRef& cellReference) const;
+        QString findSheetPath(const QString& sheetName);
+        QString readCellValue(const QString& cellType);
+        bool readSharedStrings();
+        QString readText(QXmlStreamReader& reader, const QString& endElementName) const;
+        bool setXmlError(const QXmlStreamReader& reader, const QString& entryName);
+};
+
+#endif // XLSXREADER_H
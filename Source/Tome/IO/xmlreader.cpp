@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include <QBuffer>
 #include <QFile>
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
@@ -22,6 +23,16 @@ XmlReader::~XmlReader()
     }
 }
 
+qint64 XmlReader::getCharacterCount() const
+{
+    return this->characterCount >= 0 ? this->characterCount : this->device->size();
+}
+
+qint64 XmlReader::getCharacterOffset() const
+{
+    return this->reader->characterOffset();
+}
+
 QString XmlReader::getElementName() const
 {
     return this->reader->name().toString();
@@ -55,7 +66,35 @@ void XmlReader::readEndElement()
 
 void XmlReader::readStartDocument()
 {
-    this->reader = new QXmlStreamReader(device);
+    // Parse in-memory data directly, if available, instead of copying it from the device chunk by chunk.
+    const QBuffer* buffer = qobject_cast<const QBuffer*>(this->device);
+
+    if (buffer && buffer->pos() == 0)
+    {
+        const QByteArray& data = buffer->data();
+        this->reader = new QXmlStreamReader(data);
+
+        // Count UTF-16 characters of UTF-8 data, skipping continuation bytes. Four-byte sequences become surrogate pairs.
+        const char* bytes = data.constData();
+        const int size = data.size();
+
+        this->characterCount = 0;
+
+        for (int i = 0; i < size; ++i)
+        {
+            const uchar byte = static_cast<uchar>(bytes[i]);
+
+            if ((byte & 0xC0) != 0x80)
+            {
+                this->characterCount += byte >= 0xF0 ? 2 : 1;
+            }
+        }
+    }
+    else
+    {
+        this->reader = new QXmlStreamReader(this->device);
+    }
+
     this->reader->readNext();
 
     this->readToken(QXmlStreamReader::StartDocument);
@@ -128,8 +167,9 @@ void XmlReader::validate(const QString& schemaFileName,
         throw std::runtime_error(errorMessage.toStdString());
     }
 
-    // Validate data.
-    const QByteArray xmlData = this->device->readAll();
+    // Validate data. Avoid copying in-memory data.
+    const QBuffer* buffer = qobject_cast<const QBuffer*>(this->device);
+    const QByteArray xmlData = buffer ? buffer->data() : this->device->readAll();
 
     QXmlSchemaValidator validator(schema);
 
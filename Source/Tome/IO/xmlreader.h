@@ -5,6 +5,8 @@
 
 /**
  * @brief Reads XML from any device forward-only.
+ *
+ * In-memory devices such as QBuffer or MappedFile are parsed directly, without copying their data.
  */
 class XmlReader
 {
@@ -16,6 +18,20 @@ class XmlReader
         XmlReader(QIODevice *device);
         ~XmlReader();
 
+        /**
+         * @brief Gets how much of the document has been read so far.
+         * Works for devices that are parsed directly as well, whose position never changes while reading.
+         * @return Number of characters read so far.
+         */
+        qint64 getCharacterOffset() const;
+
+        /**
+         * @brief Gets the total number of characters of the document, to compare getCharacterOffset against.
+         * Counted once when starting to read in-memory UTF-8 data. Devices that are read chunk by chunk report their size in bytes instead.
+         * @return Total number of characters of the document.
+         */
+        qint64 getCharacterCount() const;
+
         /**
          * @brief Gets the name of the current element.
          * @return Name of the current element.
@@ -99,6 +115,7 @@ class XmlReader
     private:
         QIODevice* device = nullptr;
         QXmlStreamReader* reader = nullptr;
+        qint64 characterCount = -1;
 
         void moveToNextToken();
         void readToken(const QXmlStreamReader::TokenType& expectedTokenType);
@@ -0,0 +1,161 @@
+#include "xmlwriter.h"
+
+
+const int XmlWriter::BufferSize = 64 * 1024;
+
+
+XmlWriter::XmlWriter(QIODevice* device)
+    : device(device)
+{
+    this->buffer.reserve(BufferSize + 1024);
+}
+
+XmlWriter::~XmlWriter()
+{
+    this->flush();
+}
+
+void XmlWriter::flush()
+{
+    if (this->buffer.isEmpty())
+    {
+        return;
+    }
+
+    this->device->write(this->buffer);
+    this->buffer.resize(0);
+}
+
+void XmlWriter::writeAttribute(const QByteArray& name, const QString& value)
+{
+    this->buffer.append(' ');
+    this->buffer.append(name);
+    this->buffer.append("=\"");
+    this->writeEscaped(value);
+    this->buffer.append('"');
+}
+
+void XmlWriter::writeEndDocument()
+{
+    while (!this->openElements.isEmpty())
+    {
+        this->writeEndElement();
+    }
+
+    this->buffer.append('\n');
+    this->flush();
+}
+
+void XmlWriter::writeEndElement()
+{
+    if (this->openElements.isEmpty())
+    {
+        return;
+    }
+
+    const QByteArray name = this->openElements.takeLast();
+
+    if (this->inStartElement)
+    {
+        // Element has no content - close it right away.
+        this->buffer.append("/>");
+        this->inStartElement = false;
+    }
+    else
+    {
+        this->writeIndentation(this->openElements.size());
+        this->buffer.append("</");
+        this->buffer.append(name);
+        this->buffer.append('>');
+    }
+
+    if (this->buffer.size() >= BufferSize)
+    {
+        this->flush();
+    }
+}
+
+void XmlWriter::writeStartDocument()
+{
+    this->buffer.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+}
+
+void XmlWriter::writeStartElement(const QByteArray& name)
+{
+    this->closeStartElement();
+    this->writeIndentation(this->openElements.size());
+
+    this->buffer.append('<');
+    this->buffer.append(name);
+
+    this->openElements.append(name);
+    this->inStartElement = true;
+}
+
+void XmlWriter::writeStartElement(const QString& name)
+{
+    this->writeStartElement(name.toUtf8());
+}
+
+void XmlWriter::closeStartElement()
+{
+    if (this->inStartElement)
+    {
+        this->buffer.append('>');
+        this->inStartElement = false;
+    }
+}
+
+void XmlWriter::writeEscaped(const QString& s)
+{
+    const QChar* data = s.constData();
+    const int length = s.length();
+
+    // Copy runs of characters that need no escaping as a whole.
+    int start = 0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        const char* replacement = nullptr;
+
+        switch (data[i].unicode())
+        {
+            case '<': replacement = "&lt;"; break;
+            case '>': replacement = "&gt;"; break;
+            case '&': replacement = "&amp;"; break;
+            case '"': replacement = "&quot;"; break;
+            case '\t': replacement = "&#9;"; break;
+            case '\n': replacement = "&#10;"; break;
+            case '\r': replacement = "&#13;"; break;
+            default: continue;
+        }
+
+        // Append unescaped run, followed by the replacement.
+        if (i > start)
+        {
+            this->buffer.append(QString::fromRawData(data + start, i - start).toUtf8());
+        }
+
+        this->buffer.append(replacement);
+        start = i + 1;
+    }
+
+    if (start == 0)
+    {
+        this->buffer.append(s.toUtf8());
+    }
+    else if (start < length)
+    {
+        this->buffer.append(QString::fromRawData(data + start, length - start).toUtf8());
+    }
+}
+
+void XmlWriter::writeIndentation(int depth)
+{
+    this->buffer.append('\n');
+
+    for (int i = 0; i < depth; ++i)
+    {
+        this->buffer.append("    ");
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef XMLWRITER_H
+#define XMLWRITER_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QVector>
+
+/**
+ * @brief Writes indented XML to any device forward-only.
+ *
+ * Buffers UTF-8 output and writes it to the device in large blocks.
+ * Element and attribute names can be passed pre-encoded, so writing
+ * the same names over and over doesn't require any conversions.
+ * Produces the same output as QXmlStreamWriter with auto-formatting enabled.
+ */
+class XmlWriter
+{
+    public:
+        /**
+         * @brief Constructs a new XML writer for the passed device.
+         * @param device Device to write XML to.
+         */
+        XmlWriter(QIODevice* device);
+        ~XmlWriter();
+
+        /**
+         * @brief Writes all buffered output to the device.
+         */
+        void flush();
+
+        /**
+         * @brief Writes an attribute for the current start element.
+         * @param name Name of the attribute to write, as UTF-8.
+         * @param value Value of the attribute to write.
+         */
+        void writeAttribute(const QByteArray& name, const QString& value);
+
+        /**
+         * @brief Closes all open elements and flushes the buffered output.
+         */
+        void writeEndDocument();
+
+        /**
+         * @brief Closes the current element.
+         */
+        void writeEndElement();
+
+        /**
+         * @brief Writes the XML declaration.
+         */
+        void writeStartDocument();
+
+        /**
+         * @brief Opens a new element with the specified name.
+         * @param name Name of the element to open, as UTF-8.
+         */
+        void writeStartElement(const QByteArray& name);
+
+        /**
+         * @brief Opens a new element with the specified name.
+         * @param name Name of the element to open.
+         */
+        void writeStartElement(const QString& name);
+
+    private:
+        static const int BufferSize;
+
+        QIODevice* device;
+        QByteArray buffer;
+        QVector<QByteArray> openElements;
+        bool inStartElement = false;
+
+        void closeStartElement();
+        void writeEscaped(const QString& s);
+        void writeIndentation(int depth);
+};
+
+#endif // XMLWRITER_H
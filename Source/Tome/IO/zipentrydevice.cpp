@@ -0,0 +1,286 @@
+#include "zipentrydevice.h"
+
+#include <cstring>
+
+#include <QObject>
+#include <QtEndian>
+
+
+const quint32 ZipEntryDevice::CentralDirectoryHeaderSignature = 0x02014b50;
+const quint32 ZipEntryDevice::EndOfCentralDirectorySignature = 0x06054b50;
+const quint32 ZipEntryDevice::LocalFileHeaderSignature = 0x04034b50;
+
+const int ZipEntryDevice::CentralDirectoryHeaderSize = 46;
+const int ZipEntryDevice::EndOfCentralDirectorySize = 22;
+const int ZipEntryDevice::LocalFileHeaderSize = 30;
+
+const int ZipEntryDevice::CompressionMethodStored = 0;
+const int ZipEntryDevice::CompressionMethodDeflated = 8;
+
+
+ZipEntryDevice::ZipEntryDevice(const QByteArray& archive, const QString& entryName)
+    : archive(archive),
+      entryName(entryName),
+      compressionMethod(CompressionMethodStored),
+      expectedCrc(0),
+      compressedData(nullptr),
+      compressedSize(0),
+      uncompressedSize(0),
+      uncompressedRead(0),
+      crc(0)
+{
+}
+
+ZipEntryDevice::~ZipEntryDevice()
+{
+    this->close();
+}
+
+qint64 ZipEntryDevice::bytesAvailable() const
+{
+    return this->uncompressedSize - this->uncompressedRead + QIODevice::bytesAvailable();
+}
+
+void ZipEntryDevice::close()
+{
+    if (!this->isOpen())
+    {
+        return;
+    }
+
+    if (this->compressionMethod == CompressionMethodDeflated)
+    {
+        inflateEnd(&this->stream);
+    }
+
+    QIODevice::close();
+}
+
+qint64 ZipEntryDevice::getUncompressedSize() const
+{
+    return this->uncompressedSize;
+}
+
+bool ZipEntryDevice::isSequential() const
+{
+    return true;
+}
+
+bool ZipEntryDevice::open(OpenMode mode)
+{
+    if ((mode & WriteOnly) != 0)
+    {
+        this->setErrorString(QObject::tr("Zip entries can't be written."));
+        return false;
+    }
+
+    if (!this->findEntry())
+    {
+        return false;
+    }
+
+    this->uncompressedRead = 0;
+    this->crc = crc32(0, Z_NULL, 0);
+
+    if (this->compressionMethod == CompressionMethodDeflated)
+    {
+        this->stream.zalloc = Z_NULL;
+        this->stream.zfree = Z_NULL;
+        this->stream.opaque = Z_NULL;
+
+        // The whole compressed entry is available in memory, so pass it at once.
+        this->stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(this->compressedData));
+        this->stream.avail_in = static_cast<uInt>(this->compressedSize);
+
+        // Negative window bits read raw deflate data, as zip entries have neither zlib nor gzip wrapper.
+        if (inflateInit2(&this->stream, -MAX_WBITS) != Z_OK)
+        {
+            this->setErrorString(QObject::tr("Zip entry %1 could not be decompressed.").arg(this->entryName));
+            return false;
+        }
+    }
+    else if (this->compressionMethod != CompressionMethodStored)
+    {
+        this->setErrorString(QObject::tr("Zip entry %1 uses unsupported compression method %2.")
+                             .arg(this->entryName, QString::number(this->compressionMethod)));
+        return false;
+    }
+
+    return QIODevice::open(mode | Unbuffered);
+}
+
+qint64 ZipEntryDevice::readData(char* data, qint64 maxSize)
+{
+    qint64 size = qMin(maxSize, this->uncompressedSize - this->uncompressedRead);
+
+    if (size <= 0)
+    {
+        return 0;
+    }
+
+    if (this->compressionMethod == CompressionMethodStored)
+    {
+        memcpy(data, this->compressedData + this->uncompressedRead, size);
+    }
+    else
+    {
+        this->stream.next_out = reinterpret_cast<Bytef*>(data);
+        this->stream.avail_out = static_cast<uInt>(size);
+
+        while (this->stream.avail_out > 0)
+        {
+            const int result = inflate(&this->stream, Z_NO_FLUSH);
+
+            if (result == Z_STREAM_END)
+            {
+                break;
+            }
+
+            if (result != Z_OK)
+            {
+                this->setErrorString(QObject::tr("Zip entry %1 could not be decompressed.").arg(this->entryName));
+                return -1;
+            }
+        }
+
+        size -= this->stream.avail_out;
+
+        if (size == 0)
+        {
+            this->setErrorString(QObject::tr("Zip entry %1 is truncated.").arg(this->entryName));
+            return -1;
+        }
+    }
+
+    // Verify checksum after the whole entry has been read.
+    this->crc = crc32(this->crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size));
+    this->uncompressedRead += size;
+
+    if (this->uncompressedRead == this->uncompressedSize && this->crc != this->expectedCrc)
+    {
+        this->setErrorString(QObject::tr("Zip entry %1 is corrupt.").arg(this->entryName));
+        return -1;
+    }
+
+    return size;
+}
+
+qint64 ZipEntryDevice::writeData(const char* data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+
+    return -1;
+}
+
+bool ZipEntryDevice::findEntry()
+{
+    const qint64 size = this->archive.size();
+
+    // Find end of central directory record, which may be followed by a comment of up to 64 KB.
+    qint64 endOfCentralDirectory = -1;
+
+    for (qint64 offset = size - EndOfCentralDirectorySize;
+         offset >= 0 && offset >= size - EndOfCentralDirectorySize - 0xFFFF;
+         --offset)
+    {
+        if (this->readUInt32(offset) == EndOfCentralDirectorySignature)
+        {
+            endOfCentralDirectory = offset;
+            break;
+        }
+    }
+
+    if (endOfCentralDirectory < 0)
+    {
+        this->setErrorString(QObject::tr("Data is not a zip archive."));
+        return false;
+    }
+
+    // Find entry in central directory.
+    const QByteArray name = this->entryName.toUtf8();
+    const int entryCount = this->readUInt16(endOfCentralDirectory + 10);
+    qint64 offset = this->readUInt32(endOfCentralDirectory + 16);
+
+    for (int i = 0; i < entryCount; ++i)
+    {
+        if (offset + CentralDirectoryHeaderSize > size ||
+                this->readUInt32(offset) != CentralDirectoryHeaderSignature)
+        {
+            this->setErrorString(QObject::tr("Zip archive is corrupt."));
+            return false;
+        }
+
+        const int nameLength = this->readUInt16(offset + 28);
+        const int extraLength = this->readUInt16(offset + 30);
+        const int commentLength = this->readUInt16(offset + 32);
+
+        if (offset + CentralDirectoryHeaderSize + nameLength > size)
+        {
+            this->setErrorString(QObject::tr("Zip archive is corrupt."));
+            return false;
+        }
+
+        if (nameLength == name.size() &&
+                !memcmp(this->archive.constData() + offset + CentralDirectoryHeaderSize, name.constData(), nameLength))
+        {
+            const int flags = this->readUInt16(offset + 8);
+            const qint64 localHeaderOffset = this->readUInt32(offset + 42);
+
+            this->compressionMethod = this->readUInt16(offset + 10);
+            this->expectedCrc = this->readUInt32(offset + 16);
+            this->compressedSize = this->readUInt32(offset + 20);
+            this->uncompressedSize = this->readUInt32(offset + 24);
+
+            if ((flags & 1) != 0)
+            {
+                this->setErrorString(QObject::tr("Zip entry %1 is encrypted.").arg(this->entryName));
+                return false;
+            }
+
+            if (this->compressedSize == 0xFFFFFFFF ||
+                    this->uncompressedSize == 0xFFFFFFFF ||
+                    localHeaderOffset == 0xFFFFFFFF)
+            {
+                this->setErrorString(QObject::tr("Zip entry %1 requires ZIP64, which is not supported.").arg(this->entryName));
+                return false;
+            }
+
+            // Skip local header. Its extra field may differ from the one in the central directory.
+            if (localHeaderOffset + LocalFileHeaderSize > size ||
+                    this->readUInt32(localHeaderOffset) != LocalFileHeaderSignature)
+            {
+                this->setErrorString(QObject::tr("Zip archive is corrupt."));
+                return false;
+            }
+
+            const qint64 dataOffset = localHeaderOffset + LocalFileHeaderSize
+                    + this->readUInt16(localHeaderOffset + 26)
+                    + this->readUInt16(localHeaderOffset + 28);
+
+            if (dataOffset + this->compressedSize > size)
+            {
+                this->setErrorString(QObject::tr("Zip archive is corrupt."));
+                return false;
+            }
+
+            this->compressedData = this->archive.constData() + dataOffset;
+            return true;
+        }
+
+        offset += CentralDirectoryHeaderSize + nameLength + extraLength + commentLength;
+    }
+
+    this->setErrorString(QObject::tr("Zip entry not found: %1").arg(this->entryName));
+    return false;
+}
+
+quint16 ZipEntryDevice::readUInt16(qint64 offset) const
+{
+    return qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(this->archive.constData() + offset));
+}
+
+quint32 ZipEntryDevice::readUInt32(qint64 offset) const
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(this->archive.constData() + offset));
+}
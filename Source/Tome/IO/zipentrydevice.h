@@ -0,0 +1,91 @@
+#ifndef ZIPENTRYDEVICE_H
+#define ZIPENTRYDEVICE_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+
+#include <QtZlib/zlib.h>
+
+/**
+ * @brief Read-only device that provides the uncompressed contents of a single entry of a zip archive.
+ *
+ * Data is decompressed while it is read, so the uncompressed entry never has to be held in memory.
+ * Supports stored and deflated entries, but neither ZIP64 nor encryption.
+ * The archive data must stay valid and unchanged while reading, which makes this a good fit for MappedFile.
+ */
+class ZipEntryDevice : public QIODevice
+{
+    public:
+        /**
+         * @brief Constructs a new device for reading the specified entry of the passed zip archive, without opening it yet.
+         * @param archive Data of the whole zip archive.
+         * @param entryName Full path of the entry to read, relative to the root of the archive.
+         */
+        ZipEntryDevice(const QByteArray& archive, const QString& entryName);
+        ~ZipEntryDevice();
+
+        /**
+         * @brief Gets the number of uncompressed bytes that can still be read.
+         * @return Number of uncompressed bytes that can still be read.
+         */
+        qint64 bytesAvailable() const;
+
+        /**
+         * @brief Closes this device.
+         */
+        void close();
+
+        /**
+         * @brief Gets the uncompressed size of the entry. Only valid while the device is open.
+         * @return Uncompressed size of the entry, in bytes.
+         */
+        qint64 getUncompressedSize() const;
+
+        /**
+         * @brief Checks whether this device is sequential, which it always is.
+         * @return true
+         */
+        bool isSequential() const;
+
+        /**
+         * @brief Locates the entry in the archive and opens this device for reading.
+         * @param mode Mode to open the device with. Must be read-only.
+         * @return true, if the entry could be found and opened, and false otherwise.
+         */
+        bool open(OpenMode mode);
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize);
+        qint64 writeData(const char* data, qint64 maxSize);
+
+    private:
+        static const quint32 CentralDirectoryHeaderSignature;
+        static const quint32 EndOfCentralDirectorySignature;
+        static const quint32 LocalFileHeaderSignature;
+
+        static const int CentralDirectoryHeaderSize;
+        static const int EndOfCentralDirectorySize;
+        static const int LocalFileHeaderSize;
+
+        static const int CompressionMethodStored;
+        static const int CompressionMethodDeflated;
+
+        const QByteArray& archive;
+        const QString entryName;
+
+        int compressionMethod;
+        quint32 expectedCrc;
+        const char* compressedData;
+        qint64 compressedSize;
+        qint64 uncompressedSize;
+        qint64 uncompressedRead;
+        quint32 crc;
+        z_stream stream;
+
+        bool findEntry();
+        quint16 readUInt16(qint64 offset) const;
+        quint32 readUInt32(qint64 offset) const;
+};
+
+#endif // ZIPENTRYDEVICE_H
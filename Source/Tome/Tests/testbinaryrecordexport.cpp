@@ -0,0 +1,356 @@
+#include "testbinaryrecordexport.h"
+
+#include <QBuffer>
+#include <QColor>
+
+#include "../Features/Components/Controller/componentscontroller.h"
+#include "../Features/Export/Controller/exportcontroller.h"
+#include "../Features/Facets/Controller/facetscontroller.h"
+#include "../Features/Fields/Controller/fielddefinitionscontroller.h"
+#include "../Features/Projects/Controller/projectcontroller.h"
+#include "../Features/Records/Controller/recordscontroller.h"
+#include "../Features/Types/Controller/typescontroller.h"
+#include "../Features/Types/Model/builtintype.h"
+#include "../Features/Types/Model/vector.h"
+#include "../../TomeBinaryReader/tomebinaryreader.h"
+
+using namespace Tome;
+
+
+void TestBinaryRecordExport::readHeader()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+
+    // ACT.
+    const bool opened = reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    // ASSERT.
+    QCOMPARE(opened, true);
+    QCOMPARE(reader.getRecordCount(), 3u);
+    QCOMPARE(reader.getColumnCount(), 8u);
+}
+
+void TestBinaryRecordExport::readRecords()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+    reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    // ACT.
+    uint32_t parentRow = 0;
+    uint32_t childRow = 0;
+    uint32_t missingRow = 0;
+
+    const bool parentFound = reader.findRecord("Parent", 6, parentRow);
+    const bool childFound = reader.findRecord("Child", 5, childRow);
+    const bool missingFound = reader.findRecord("Child2", 6, missingRow);
+    const uint32_t noParent = Binary::Reader::NoParent;
+
+    // ASSERT.
+    QCOMPARE(parentFound, true);
+    QCOMPARE(childFound, true);
+    QCOMPARE(missingFound, false);
+    QCOMPARE(reader.getRecordId(childRow).equals("Child", 5), true);
+    QCOMPARE(reader.getRecordDisplayName(childRow).equals("Child Record", 12), true);
+    QCOMPARE(reader.getRecordParent(childRow), parentRow);
+    QCOMPARE(reader.getRecordParent(parentRow), noParent);
+}
+
+void TestBinaryRecordExport::readInheritedValues()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+    reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    uint32_t childRow = 0;
+    uint32_t otherRow = 0;
+    uint32_t healthColumn = 0;
+    uint32_t nameColumn = 0;
+
+    reader.findRecord("Child", 5, childRow);
+    reader.findRecord("Other", 5, otherRow);
+    reader.findColumn("Health", 6, healthColumn);
+    reader.findColumn("Name", 4, nameColumn);
+
+    // ACT.
+    const int32_t childHealth = reader.getInteger(healthColumn, childRow);
+    const Binary::String childName = reader.getString(nameColumn, childRow);
+
+    // ASSERT.
+    QCOMPARE(reader.hasValue(healthColumn, childRow), true);
+    QCOMPARE(reader.hasValue(healthColumn, otherRow), false);
+    QCOMPARE(childHealth, 100);
+    QCOMPARE(QString::fromUtf8(childName.data, static_cast<int>(childName.size)), QString("Child Name"));
+}
+
+void TestBinaryRecordExport::readScalarValues()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+    reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    uint32_t row = 0;
+    uint32_t enabledColumn = 0;
+    uint32_t speedColumn = 0;
+    uint32_t tintColumn = 0;
+
+    reader.findRecord("Parent", 6, row);
+    reader.findColumn("Enabled", 7, enabledColumn);
+    reader.findColumn("Speed", 5, speedColumn);
+    reader.findColumn("Tint", 4, tintColumn);
+
+    // ACT.
+    const bool enabled = reader.getBoolean(enabledColumn, row);
+    const double speed = reader.getReal(speedColumn, row);
+    const uint32_t tint = reader.getColor(tintColumn, row);
+
+    // ASSERT.
+    QVERIFY(reader.getColumn(speedColumn).valueType == Binary::ValueType::Real);
+    QCOMPARE(enabled, true);
+    QCOMPARE(speed, 2.5);
+    QCOMPARE(tint, 0xFFFF0000u);
+}
+
+void TestBinaryRecordExport::readVectorValues()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+    reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    uint32_t row = 0;
+    uint32_t positionColumn = 0;
+
+    reader.findRecord("Parent", 6, row);
+    reader.findColumn("Position", 8, positionColumn);
+
+    // ACT.
+    const int32_t x = reader.getVectorInteger(positionColumn, row, 0);
+    const int32_t y = reader.getVectorInteger(positionColumn, row, 1);
+
+    // ASSERT.
+    QVERIFY(reader.getColumn(positionColumn).valueType == Binary::ValueType::Vector2I);
+    QCOMPARE(x, -3);
+    QCOMPARE(y, 7);
+}
+
+void TestBinaryRecordExport::readListValues()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+    reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    uint32_t row = 0;
+    uint32_t levelsColumn = 0;
+
+    reader.findRecord("Parent", 6, row);
+    reader.findColumn("Levels", 6, levelsColumn);
+
+    // ACT.
+    const uint32_t itemCount = reader.getItemCount(levelsColumn, row);
+    const int32_t first = reader.getItemInteger(reader.getItem(levelsColumn, row, 0));
+    const int32_t second = reader.getItemInteger(reader.getItem(levelsColumn, row, 1));
+
+    // ASSERT.
+    QVERIFY(reader.getColumn(levelsColumn).itemType == Binary::ValueType::Integer);
+    QCOMPARE(itemCount, 2u);
+    QCOMPARE(first, 1);
+    QCOMPARE(second, 2);
+    QCOMPARE(reader.getItem(levelsColumn, row, 2), 0xFFFFFFFFu);
+}
+
+void TestBinaryRecordExport::readMapValues()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    Binary::Reader reader;
+    reader.open(bytes.constData(), static_cast<size_t>(bytes.size()));
+
+    uint32_t row = 0;
+    uint32_t weightsColumn = 0;
+
+    reader.findRecord("Parent", 6, row);
+    reader.findColumn("Weights", 7, weightsColumn);
+
+    // ACT.
+    const uint32_t itemCount = reader.getItemCount(weightsColumn, row);
+    const uint32_t item = reader.getItem(weightsColumn, row, 0);
+
+    // ASSERT.
+    QVERIFY(reader.getColumn(weightsColumn).itemType == Binary::ValueType::Real);
+    QCOMPARE(itemCount, 1u);
+    QCOMPARE(reader.getItemKey(item).equals("Gold", 4), true);
+    QCOMPARE(reader.getItemReal(item), 0.75);
+}
+
+void TestBinaryRecordExport::rejectInvalidData()
+{
+    // ARRANGE.
+    QByteArray bytes = this->exportRecords();
+    QByteArray truncated = bytes.left(bytes.size() - 1);
+    QByteArray corrupt = bytes;
+    corrupt[0] = 'X';
+
+    Binary::Reader reader;
+
+    // ACT.
+    const bool truncatedOpened = reader.open(truncated.constData(), static_cast<size_t>(truncated.size()));
+    const bool corruptOpened = reader.open(corrupt.constData(), static_cast<size_t>(corrupt.size()));
+
+    // ASSERT.
+    QCOMPARE(truncatedOpened, false);
+    QCOMPARE(corruptOpened, false);
+    QCOMPARE(reader.getRecordCount(), 0u);
+}
+
+void TestBinaryRecordExport::rejectInvalidRows()
+{
+    // ARRANGE.
+    const QByteArray bytes = this->exportRecords();
+    const int recordsOffset = static_cast<int>(this->readUInt32(bytes, 36));
+    const int recordIndexOffset = static_cast<int>(this->readUInt32(bytes, 40));
+
+    QByteArray invalidIndex = bytes;
+    this->writeUInt32(invalidIndex, recordIndexOffset + 4, 3);
+
+    QByteArray invalidParent = bytes;
+    this->writeUInt32(invalidParent, recordsOffset + 8, 0x7FFFFFFF);
+
+    Binary::Reader reader;
+
+    // ACT.
+    const bool invalidIndexOpened = reader.open(invalidIndex.constData(), static_cast<size_t>(invalidIndex.size()));
+    const bool invalidParentOpened = reader.open(invalidParent.constData(), static_cast<size_t>(invalidParent.size()));
+
+    // ASSERT.
+    QCOMPARE(invalidIndexOpened, false);
+    QCOMPARE(invalidParentOpened, false);
+}
+
+QByteArray TestBinaryRecordExport::exportRecords() const
+{
+    // Set up types.
+    CustomType levelsType;
+    levelsType.name = "LevelList";
+    levelsType.setItemType(BuiltInType::Integer);
+
+    CustomType weightsType;
+    weightsType.name = "WeightMap";
+    weightsType.setKeyType(BuiltInType::String);
+    weightsType.setValueType(BuiltInType::Real);
+
+    CustomTypeSet customTypeSet;
+    customTypeSet.name = "Types";
+    customTypeSet.types << levelsType << weightsType;
+
+    CustomTypeSetList customTypeSets;
+    customTypeSets << customTypeSet;
+
+    // Set up fields.
+    const QStringList fieldIds = QStringList() << "Enabled" << "Health" << "Levels" << "Name"
+                                               << "Position" << "Speed" << "Tint" << "Weights";
+    const QStringList fieldTypes = QStringList() << BuiltInType::Boolean << BuiltInType::Integer << "LevelList"
+                                                 << BuiltInType::String << BuiltInType::Vector2I << BuiltInType::Real
+                                                 << BuiltInType::Color << "WeightMap";
+
+    FieldDefinitionSet fieldDefinitionSet;
+    fieldDefinitionSet.name = "Fields";
+
+    for (int i = 0; i < fieldIds.size(); ++i)
+    {
+        FieldDefinition fieldDefinition;
+        fieldDefinition.id = fieldIds[i];
+        fieldDefinition.fieldType = fieldTypes[i];
+        fieldDefinition.fieldDefinitionSetName = fieldDefinitionSet.name;
+        fieldDefinitionSet.fieldDefinitions << fieldDefinition;
+    }
+
+    FieldDefinitionSetList fieldDefinitionSets;
+    fieldDefinitionSets << fieldDefinitionSet;
+
+    // Set up records.
+    QVariantMap position;
+    position[BuiltInType::Vector::X] = -3;
+    position[BuiltInType::Vector::Y] = 7;
+
+    QVariantMap weights;
+    weights["Gold"] = 0.75;
+
+    Record parent;
+    parent.id = "Parent";
+    parent.displayName = "Parent Record";
+    parent.fieldValues["Enabled"] = true;
+    parent.fieldValues["Health"] = 100;
+    parent.fieldValues["Levels"] = QVariantList() << 1 << 2;
+    parent.fieldValues["Name"] = "Parent Name";
+    parent.fieldValues["Position"] = position;
+    parent.fieldValues["Speed"] = 2.5;
+    parent.fieldValues["Tint"] = QColor(255, 0, 0);
+    parent.fieldValues["Weights"] = weights;
+
+    Record child;
+    child.id = "Child";
+    child.displayName = "Child Record";
+    child.parentId = "Parent";
+    child.fieldValues["Name"] = "Child Name";
+
+    Record other;
+    other.id = "Other";
+    other.displayName = "Other Record";
+
+    RecordSet recordSet;
+    recordSet.name = "Records";
+    recordSet.records << parent << child << other;
+
+    RecordSetList recordSets;
+    recordSets << recordSet;
+
+    ComponentSetList componentSets;
+
+    // Set up controllers.
+    ComponentsController componentsController;
+    componentsController.setComponents(componentSets);
+
+    TypesController typesController;
+    typesController.setCustomTypes(customTypeSets);
+
+    FieldDefinitionsController fieldDefinitionsController(componentsController, typesController);
+    fieldDefinitionsController.setFieldDefinitionSets(fieldDefinitionSets);
+
+    ProjectController projectController;
+
+    RecordsController recordsController(fieldDefinitionsController, projectController, typesController);
+    recordsController.setRecordSets(recordSets);
+
+    FacetsController facetsController(recordsController, typesController);
+
+    ExportController exportController(facetsController, fieldDefinitionsController, recordsController, typesController);
+
+    // Export records.
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    exportController.exportRecordsBinary(buffer);
+    return buffer.data();
+}
+
+quint32 TestBinaryRecordExport::readUInt32(const QByteArray& bytes, int offset) const
+{
+    return quint32(quint8(bytes[offset])) |
+            (quint32(quint8(bytes[offset + 1])) << 8) |
+            (quint32(quint8(bytes[offset + 2])) << 16) |
+            (quint32(quint8(bytes[offset + 3])) << 24);
+}
+
+void TestBinaryRecordExport::writeUInt32(QByteArray& bytes, int offset, quint32 value) const
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        bytes[offset + i] = char((value >> (i * 8)) & 0xFF);
+    }
+}
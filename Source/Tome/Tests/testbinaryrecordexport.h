@@ -0,0 +1,31 @@
+#ifndef TESTBINARYRECORDEXPORT_H
+#define TESTBINARYRECORDEXPORT_H
+
+#include <QtTest/QtTest>
+
+
+/**
+ * @brief Unit tests for exporting records to typed binary files, and reading them back.
+ */
+class TestBinaryRecordExport : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void readHeader();
+        void readRecords();
+        void readInheritedValues();
+        void readScalarValues();
+        void readVectorValues();
+        void readListValues();
+        void readMapValues();
+        void rejectInvalidData();
+        void rejectInvalidRows();
+
+    private:
+        QByteArray exportRecords() const;
+        quint32 readUInt32(const QByteArray& bytes, int offset) const;
+        void writeUInt32(QByteArray& bytes, int offset, quint32 value) const;
+};
+
+#endif // TESTBINARYRECORDEXPORT_H
@@ -0,0 +1,232 @@
+#include "testcppheaderwriter.h"
+
+#include <QBuffer>
+
+#include "../Features/Components/Controller/componentscontroller.h"
+#include "../Features/Export/Controller/cppheaderwriter.h"
+#include "../Features/Export/Model/recordexportdata.h"
+#include "../Features/Fields/Controller/fielddefinitionscontroller.h"
+#include "../Features/Types/Controller/typescontroller.h"
+#include "../Features/Types/Model/builtintype.h"
+
+using namespace Tome;
+
+
+void TestCppHeaderWriter::writeRecords()
+{
+    // ARRANGE.
+    Record sword;
+    sword.id = "sword-1";
+    sword.displayName = "Sword";
+
+    Record otherSword;
+    otherSword.id = "sword_1";
+    otherSword.displayName = "Sword?";
+
+    Record shield;
+    shield.id = "Shield";
+    shield.displayName = QString::fromUtf8("Schild \xC3\xA4");
+
+    RecordFieldValueMap swordFieldValues;
+    swordFieldValues.insert("Health", 10);
+    swordFieldValues.insert("2nd Name", "A \"q\"");
+    swordFieldValues.insert("Levels", QVariantList() << 1 << 2);
+    swordFieldValues.insert("Speed", 1.5);
+    swordFieldValues.insert("Element", "ice cold");
+
+    RecordFieldValueMap otherSwordFieldValues;
+    otherSwordFieldValues.insert("Health", 20);
+
+    const RecordList records = RecordList() << sword << otherSword << shield;
+    const QVector<RecordFieldValueMap> fieldValues =
+            QVector<RecordFieldValueMap>() << swordFieldValues << otherSwordFieldValues << RecordFieldValueMap();
+
+    // ACT.
+    const QString header = this->writeHeader(records, fieldValues);
+
+    // ASSERT.
+    QString expected = this->getExpectedPreamble();
+    expected += "    namespace RecordIds\n";
+    expected += "    {\n";
+    expected += "        constexpr const char* sword_1 = \"sword-1\";\n";
+    expected += "        constexpr const char* sword_1_2 = \"sword_1\";\n";
+    expected += "        constexpr const char* Shield = \"Shield\";\n";
+    expected += "    }\n\n";
+    expected += "    struct Record_2\n";
+    expected += "    {\n";
+    expected += "        const char* id;\n";
+    expected += "        double Speed;\n";
+    expected += "        Damage_Type Element;\n";
+    expected += "    };\n\n";
+    expected += "    constexpr Record_2 Record_2Records[] =\n";
+    expected += "    {\n";
+    expected += "        { RecordIds::sword_1, 1.5, Damage_Type::ice_cold_2 },\n";
+    expected += "    };\n\n";
+    expected += "    struct Record\n";
+    expected += "    {\n";
+    expected += "        const char* id;\n";
+    expected += "        const char* displayName;\n";
+    expected += "        std::int32_t Health;\n";
+    expected += "        const char* _2nd_Name;\n";
+    expected += "        Span<std::int32_t> Levels;\n";
+    expected += "    };\n\n";
+    expected += "    namespace Detail\n";
+    expected += "    {\n";
+    expected += "        constexpr std::int32_t Items0[] = { 1, 2 };\n";
+    expected += "    }\n\n";
+    expected += "    constexpr Record Records[] =\n";
+    expected += "    {\n";
+    expected += "        { RecordIds::sword_1, \"Sword\", 10, \"A \\\"q\\\"\", { Detail::Items0, 2 } },\n";
+    expected += "        { RecordIds::sword_1_2, \"Sword\\?\", 20, \"\", { nullptr, 0 } },\n";
+    expected += "        { RecordIds::Shield, \"Schild \\303\\244\", 100, \"\", { nullptr, 0 } },\n";
+    expected += "    };\n\n";
+    expected += "}\n";
+
+    QCOMPARE(header, expected);
+}
+
+void TestCppHeaderWriter::writeWithoutRecords()
+{
+    // ARRANGE.
+    const RecordList records;
+    const QVector<RecordFieldValueMap> fieldValues;
+
+    // ACT.
+    const QString header = this->writeHeader(records, fieldValues);
+
+    // ASSERT.
+    QString expected = this->getExpectedPreamble();
+    expected += "    namespace RecordIds\n";
+    expected += "    {\n";
+    expected += "    }\n\n";
+    expected += "    struct Record_2\n";
+    expected += "    {\n";
+    expected += "        const char* id;\n";
+    expected += "        double Speed;\n";
+    expected += "        Damage_Type Element;\n";
+    expected += "    };\n\n";
+    expected += "    // No records with component Record_2.\n\n";
+    expected += "    struct Record\n";
+    expected += "    {\n";
+    expected += "        const char* id;\n";
+    expected += "        const char* displayName;\n";
+    expected += "        std::int32_t Health;\n";
+    expected += "        const char* _2nd_Name;\n";
+    expected += "        Span<std::int32_t> Levels;\n";
+    expected += "    };\n\n";
+    expected += "    // No records with component Record.\n\n";
+    expected += "}\n";
+
+    QCOMPARE(header, expected);
+}
+
+QString TestCppHeaderWriter::getExpectedPreamble() const
+{
+    QString preamble;
+    preamble += QString("// Generated by Tome %1. Do not edit.\n\n").arg(APP_VERSION);
+    preamble += "#pragma once\n\n";
+    preamble += "#include <cstddef>\n";
+    preamble += "#include <cstdint>\n\n";
+    preamble += "namespace Game_Data\n";
+    preamble += "{\n";
+    preamble += "    template<typename T>\n";
+    preamble += "    struct Span\n";
+    preamble += "    {\n";
+    preamble += "        const T* data;\n";
+    preamble += "        std::size_t size;\n\n";
+    preamble += "        constexpr const T* begin() const { return data; }\n";
+    preamble += "        constexpr const T* end() const { return data + size; }\n";
+    preamble += "        constexpr const T& operator[](std::size_t index) const { return data[index]; }\n";
+    preamble += "    };\n\n";
+    preamble += "    template<typename K, typename V>\n";
+    preamble += "    struct MapEntry\n";
+    preamble += "    {\n";
+    preamble += "        K key;\n";
+    preamble += "        V value;\n";
+    preamble += "    };\n\n";
+    preamble += "    struct Vector2I { std::int32_t x; std::int32_t y; };\n";
+    preamble += "    struct Vector2R { double x; double y; };\n";
+    preamble += "    struct Vector3I { std::int32_t x; std::int32_t y; std::int32_t z; };\n";
+    preamble += "    struct Vector3R { double x; double y; double z; };\n\n";
+    preamble += "    enum class Damage_Type\n";
+    preamble += "    {\n";
+    preamble += "        Fire,\n";
+    preamble += "        ice_cold,\n";
+    preamble += "        ice_cold_2,\n";
+    preamble += "        class_\n";
+    preamble += "    };\n\n";
+    return preamble;
+}
+
+QString TestCppHeaderWriter::writeHeader(const RecordList& records, const QVector<RecordFieldValueMap>& fieldValues) const
+{
+    // Set up types. Member names clash with keywords and with each other after sanitizing.
+    CustomType damageType;
+    damageType.name = "Damage Type";
+    damageType.setEnumeration(QStringList() << "Fire" << "ice-cold" << "ice cold" << "class");
+
+    CustomType levelsType;
+    levelsType.name = "LevelList";
+    levelsType.setItemType(BuiltInType::Integer);
+
+    CustomTypeSet customTypeSet;
+    customTypeSet.name = "Types";
+    customTypeSet.types << damageType << levelsType;
+
+    CustomTypeSetList customTypeSets;
+    customTypeSets << customTypeSet;
+
+    // Set up fields. The component name clashes with the generated struct of all records.
+    const QStringList fieldIds = QStringList() << "Health" << "2nd Name" << "Levels" << "Speed" << "Element";
+    const QStringList fieldTypes = QStringList() << BuiltInType::Integer << BuiltInType::String << "LevelList"
+                                                 << BuiltInType::Real << "Damage Type";
+    const QStringList fieldComponents = QStringList() << QString() << QString() << QString() << "Record" << "Record";
+    const QVariantList fieldDefaultValues = QVariantList() << 100 << QString() << QVariantList() << 1.0 << "Fire";
+
+    FieldDefinitionSet fieldDefinitionSet;
+    fieldDefinitionSet.name = "Fields";
+
+    for (int i = 0; i < fieldIds.size(); ++i)
+    {
+        FieldDefinition fieldDefinition;
+        fieldDefinition.id = fieldIds[i];
+        fieldDefinition.fieldType = fieldTypes[i];
+        fieldDefinition.component = fieldComponents[i];
+        fieldDefinition.defaultValue = fieldDefaultValues[i];
+        fieldDefinition.fieldDefinitionSetName = fieldDefinitionSet.name;
+        fieldDefinitionSet.fieldDefinitions << fieldDefinition;
+    }
+
+    FieldDefinitionSetList fieldDefinitionSets;
+    fieldDefinitionSets << fieldDefinitionSet;
+
+    ComponentSetList componentSets;
+
+    // Set up controllers.
+    ComponentsController componentsController;
+    componentsController.setComponents(componentSets);
+
+    TypesController typesController;
+    typesController.setCustomTypes(customTypeSets);
+
+    FieldDefinitionsController fieldDefinitionsController(componentsController, typesController);
+    fieldDefinitionsController.setFieldDefinitionSets(fieldDefinitionSets);
+
+    // Set up records.
+    RecordExportData data;
+    data.fieldValues = fieldValues;
+
+    for (const Record& record : records)
+    {
+        data.records << &record;
+    }
+
+    // Write header.
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    CppHeaderWriter writer(fieldDefinitionsController, typesController);
+    writer.write(buffer, data, "Game Data");
+
+    return QString::fromUtf8(buffer.data());
+}
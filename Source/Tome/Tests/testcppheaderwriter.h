@@ -0,0 +1,25 @@
+#ifndef TESTCPPHEADERWRITER_H
+#define TESTCPPHEADERWRITER_H
+
+#include <QtTest/QtTest>
+
+#include "../Features/Records/Model/recordlist.h"
+
+
+/**
+ * @brief Unit tests for exporting records to C++ headers.
+ */
+class TestCppHeaderWriter : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void writeRecords();
+        void writeWithoutRecords();
+
+    private:
+        QString getExpectedPreamble() const;
+        QString writeHeader(const Tome::RecordList& records, const QVector<Tome::RecordFieldValueMap>& fieldValues) const;
+};
+
+#endif // TESTCPPHEADERWRITER_H
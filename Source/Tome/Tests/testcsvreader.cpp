@@ -0,0 +1,182 @@
+#include "testcsvreader.h"
+
+#include "../IO/csvreader.h"
+
+
+void TestCsvReader::readUnquotedFields()
+{
+    // ARRANGE.
+    QByteArray data = "id;name\r\na;b\r\n";
+
+    // ACT.
+    QList<QStringList> rows = this->readRows(data, ';');
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 2);
+    QCOMPARE(rows[0], QStringList() << "id" << "name");
+    QCOMPARE(rows[1], QStringList() << "a" << "b");
+}
+
+void TestCsvReader::readQuotedDelimiters()
+{
+    // ARRANGE.
+    QByteArray data = "a,\"b,c\",d\n";
+
+    // ACT.
+    QList<QStringList> rows = this->readRows(data);
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 1);
+    QCOMPARE(rows[0], QStringList() << "a" << "b,c" << "d");
+}
+
+void TestCsvReader::readQuotedLineBreaks()
+{
+    // ARRANGE.
+    QByteArray data = "a,\"b\r\nc\"\nd,e";
+
+    // ACT.
+    QList<QStringList> rows = this->readRows(data);
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 2);
+    QCOMPARE(rows[0], QStringList() << "a" << "b\r\nc");
+    QCOMPARE(rows[1], QStringList() << "d" << "e");
+}
+
+void TestCsvReader::readEscapedQuotes()
+{
+    // ARRANGE.
+    QByteArray data = "\"say \"\"hi\"\"\",\"\"\"\"\n";
+
+    // ACT.
+    QList<QStringList> rows = this->readRows(data);
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 1);
+    QCOMPARE(rows[0], QStringList() << "say \"hi\"" << "\"");
+}
+
+void TestCsvReader::readEmptyFields()
+{
+    // ARRANGE.
+    QByteArray data = ",\"\",\n";
+
+    // ACT.
+    QList<QStringList> rows = this->readRows(data);
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 1);
+    QCOMPARE(rows[0], QStringList() << "" << "" << "");
+}
+
+void TestCsvReader::readMultiCharacterDelimiters()
+{
+    // ARRANGE.
+    QByteArray data = "a||\"b||c\"||d|e\nf||g|\n";
+    CsvReader reader(data.constData(), data.size(), "||");
+
+    // ACT.
+    QList<QStringList> rows;
+
+    while (reader.readRow())
+    {
+        QStringList row;
+
+        for (int i = 0; i < reader.getFieldCount(); ++i)
+        {
+            row << reader.getField(i);
+        }
+
+        rows << row;
+    }
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 2);
+    QCOMPARE(rows[0], QStringList() << "a" << "b||c" << "d|e");
+    QCOMPARE(rows[1], QStringList() << "f" << "g|");
+}
+
+void TestCsvReader::skipEmptyLinesAndByteOrderMark()
+{
+    // ARRANGE.
+    QByteArray data = "\xEF\xBB\xBFid\n\n\r\nb\n\n";
+
+    // ACT.
+    QList<QStringList> rows = this->readRows(data);
+
+    // ASSERT.
+    QCOMPARE(rows.size(), 2);
+    QCOMPARE(rows[0], QStringList() << "id");
+    QCOMPARE(rows[1], QStringList() << "b");
+}
+
+void TestCsvReader::reportUnterminatedQuote()
+{
+    // ARRANGE.
+    QByteArray data = "a,b\n\"c,d\n";
+    CsvReader reader(data);
+
+    // ACT.
+    reader.readRow();
+    bool firstRowUnterminated = reader.hasUnterminatedQuote();
+
+    reader.readRow();
+    bool secondRowUnterminated = reader.hasUnterminatedQuote();
+
+    // ASSERT.
+    QCOMPARE(firstRowUnterminated, false);
+    QCOMPARE(secondRowUnterminated, true);
+    QCOMPARE(reader.getField(0), QString("c,d\n"));
+    QCOMPARE(reader.readRow(), false);
+}
+
+void TestCsvReader::benchmarkRead()
+{
+    // ARRANGE.
+    const int rowCount = 500000;
+    QByteArray data;
+
+    for (int i = 0; i < rowCount; ++i)
+    {
+        const QByteArray index = QByteArray::number(i);
+        data.append("Record" + index + ";\"Name " + index + "\";12.5;\"a;b\";\"say \"\"hi\"\"\";true\r\n");
+    }
+
+    int rows = 0;
+
+    // ACT.
+    QBENCHMARK
+    {
+        CsvReader reader(data, ';');
+        rows = 0;
+
+        while (reader.readRow())
+        {
+            ++rows;
+        }
+    }
+
+    // ASSERT.
+    QCOMPARE(rows, rowCount);
+}
+
+QList<QStringList> TestCsvReader::readRows(const QByteArray& data, char delimiter) const
+{
+    QList<QStringList> rows;
+    CsvReader reader(data, delimiter);
+
+    while (reader.readRow())
+    {
+        QStringList row;
+
+        for (int i = 0; i < reader.getFieldCount(); ++i)
+        {
+            row << reader.getField(i);
+        }
+
+        rows << row;
+    }
+
+    return rows;
+}
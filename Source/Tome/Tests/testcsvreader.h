@@ -0,0 +1,29 @@
+#ifndef TESTCSVREADER_H
+#define TESTCSVREADER_H
+
+#include <QtTest/QtTest>
+
+
+/**
+ * @brief Unit tests and benchmark for reading RFC 4180 CSV data.
+ */
+class TestCsvReader : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void readUnquotedFields();
+        void readQuotedDelimiters();
+        void readQuotedLineBreaks();
+        void readEscapedQuotes();
+        void readEmptyFields();
+        void readMultiCharacterDelimiters();
+        void skipEmptyLinesAndByteOrderMark();
+        void reportUnterminatedQuote();
+        void benchmarkRead();
+
+    private:
+        QList<QStringList> readRows(const QByteArray& data, char delimiter = ',') const;
+};
+
+#endif // TESTCSVREADER_H
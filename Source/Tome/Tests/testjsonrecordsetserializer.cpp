@@ -0,0 +1,234 @@
+#include "testjsonrecordsetserializer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "../Features/Records/Controller/jsonrecordsetserializer.h"
+#include "../Features/Records/Controller/xmlrecordsetserializer.h"
+
+using namespace Tome;
+
+
+void TestJsonRecordSetSerializer::roundTripRecords()
+{
+    // ARRANGE.
+    const RecordSet recordSet = this->createRecordSet();
+
+    // ACT.
+    const RecordSet jsonRecordSet = this->readJson(this->writeJson(recordSet));
+    const RecordSet xmlRecordSet = this->readXml(this->writeXml(recordSet));
+
+    // ASSERT.
+    this->compareRecordSets(jsonRecordSet, xmlRecordSet);
+    this->compareRecordSets(jsonRecordSet, recordSet);
+}
+
+void TestJsonRecordSetSerializer::roundTripEmptyValues()
+{
+    // ARRANGE.
+    Record record;
+    record.id = "Empty";
+    record.displayName = "Empty";
+    record.fieldValues.insert("EmptyString", QString());
+    record.fieldValues.insert("EmptyList", QVariantList());
+    record.fieldValues.insert("EmptyMap", QVariantMap());
+
+    RecordSet recordSet;
+    recordSet.name = "Items";
+    recordSet.records << record;
+
+    // ACT.
+    const RecordSet jsonRecordSet = this->readJson(this->writeJson(recordSet));
+    const RecordSet xmlRecordSet = this->readXml(this->writeXml(recordSet));
+
+    // ASSERT.
+    this->compareRecordSets(jsonRecordSet, xmlRecordSet);
+}
+
+void TestJsonRecordSetSerializer::writeRecordsSortedById()
+{
+    // ARRANGE.
+    const RecordSet recordSet = this->createRecordSet();
+
+    // ACT.
+    const QList<QByteArray> lines = this->writeJson(recordSet).split('\n');
+
+    // ASSERT.
+    QCOMPARE(lines.size(), recordSet.records.size() + 1);
+    QCOMPARE(lines.last(), QByteArray());
+
+    for (int i = 1; i < lines.size() - 1; ++i)
+    {
+        const QString previousId = QJsonDocument::fromJson(lines[i - 1]).object().value("Id").toString();
+        const QString id = QJsonDocument::fromJson(lines[i]).object().value("Id").toString();
+
+        QVERIFY(previousId.toLower() < id.toLower());
+    }
+}
+
+void TestJsonRecordSetSerializer::convertXmlToJsonAndBack()
+{
+    // ARRANGE.
+    const QByteArray xml = this->writeXml(this->createRecordSet());
+
+    // ACT.
+    const QByteArray json = this->writeJson(this->readXml(xml));
+    const QByteArray convertedXml = this->writeXml(this->readJson(json));
+
+    // ASSERT.
+    QCOMPARE(convertedXml, xml);
+}
+
+void TestJsonRecordSetSerializer::rejectInvalidRecord()
+{
+    // ARRANGE.
+    const QByteArray json = "{\"Id\":\"A\",\"DisplayName\":\"A\",\"Fields\":{}}\n{\"Id\":\"B\",";
+
+    // ACT.
+    bool rejected = false;
+
+    try
+    {
+        this->readJson(json);
+    }
+    catch (const std::runtime_error&)
+    {
+        rejected = true;
+    }
+
+    // ASSERT.
+    QCOMPARE(rejected, true);
+}
+
+RecordSet TestJsonRecordSetSerializer::createRecordSet() const
+{
+    Record parent;
+    parent.id = "Weapon";
+    parent.displayName = "Weapon";
+    parent.editorIconFieldId = "Icon";
+    parent.readOnly = true;
+    parent.fieldValues.insert("Damage", "10");
+    parent.fieldValues.insert("Icon", "weapon.png");
+
+    QVariantMap modifiers;
+    modifiers.insert("Fire", "2");
+    modifiers.insert("Ice", "-1");
+
+    Record child;
+    child.id = "Sword";
+    child.displayName = QString::fromUtf8("Schwert \"Größe\" <1> & 2");
+    child.parentId = "Weapon";
+    child.fieldValues.insert("Damage", "15");
+    child.fieldValues.insert("Description", "Line one\nLine two\ttabbed");
+    child.fieldValues.insert("Tags", QVariantList() << "Melee" << "Sharp" << "Melee");
+    child.fieldValues.insert("Modifiers", modifiers);
+
+    Record grandChild;
+    grandChild.id = "sword_of_fire";
+    grandChild.displayName = "Sword of Fire";
+    grandChild.parentId = "Sword";
+    grandChild.fieldValues.insert("Tags", QVariantList() << "Magic");
+
+    RecordSet recordSet;
+    recordSet.name = "Items";
+    recordSet.records << parent << child << grandChild;
+
+    for (Record& record : recordSet.records)
+    {
+        record.recordSetName = recordSet.name;
+    }
+
+    return recordSet;
+}
+
+void TestJsonRecordSetSerializer::compareRecordSets(const RecordSet& actual, const RecordSet& expected) const
+{
+    QCOMPARE(actual.records.size(), expected.records.size());
+
+    // Records are written sorted by id.
+    RecordList actualRecords = actual.records;
+    RecordList expectedRecords = expected.records;
+
+    std::stable_sort(actualRecords.begin(), actualRecords.end(), recordLessThanId);
+    std::stable_sort(expectedRecords.begin(), expectedRecords.end(), recordLessThanId);
+
+    for (int i = 0; i < actualRecords.size(); ++i)
+    {
+        const Record& actualRecord = actualRecords[i];
+        const Record& expectedRecord = expectedRecords[i];
+
+        QCOMPARE(actualRecord.id.toString(), expectedRecord.id.toString());
+        QCOMPARE(actualRecord.displayName, expectedRecord.displayName);
+        QCOMPARE(actualRecord.editorIconFieldId, expectedRecord.editorIconFieldId);
+        QCOMPARE(actualRecord.parentId.toString(), expectedRecord.parentId.toString());
+        QCOMPARE(actualRecord.readOnly, expectedRecord.readOnly);
+        QCOMPARE(actualRecord.fieldValues.keys(), expectedRecord.fieldValues.keys());
+
+        for (RecordFieldValueMap::const_iterator it = expectedRecord.fieldValues.cbegin();
+             it != expectedRecord.fieldValues.cend();
+             ++it)
+        {
+            const QVariant actualValue = actualRecord.fieldValues[it.key()];
+            const QVariant& expectedValue = it.value();
+
+            QCOMPARE(actualValue.userType(), expectedValue.userType());
+            QCOMPARE(actualValue, expectedValue);
+        }
+    }
+}
+
+QByteArray TestJsonRecordSetSerializer::writeJson(const RecordSet& recordSet) const
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    JsonRecordSetSerializer serializer;
+    serializer.serialize(buffer, recordSet);
+
+    return buffer.data();
+}
+
+QByteArray TestJsonRecordSetSerializer::writeXml(const RecordSet& recordSet) const
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    XmlRecordSetSerializer serializer;
+    serializer.serialize(buffer, recordSet);
+
+    return buffer.data();
+}
+
+RecordSet TestJsonRecordSetSerializer::readJson(const QByteArray& data) const
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    RecordSet recordSet;
+    recordSet.name = "Items";
+
+    JsonRecordSetSerializer serializer;
+    serializer.deserialize(buffer, recordSet);
+
+    return recordSet;
+}
+
+RecordSet TestJsonRecordSetSerializer::readXml(const QByteArray& data) const
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    RecordSet recordSet;
+    recordSet.name = "Items";
+
+    XmlRecordSetSerializer serializer;
+    serializer.deserialize(buffer, recordSet);
+
+    return recordSet;
+}
@@ -0,0 +1,34 @@
+#ifndef TESTJSONRECORDSETSERIALIZER_H
+#define TESTJSONRECORDSETSERIALIZER_H
+
+#include <QtTest/QtTest>
+
+#include "../Features/Records/Model/recordset.h"
+
+
+/**
+ * @brief Unit tests for reading and writing record sets as line-oriented JSON, without losing any data compared to XML.
+ */
+class TestJsonRecordSetSerializer : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void roundTripRecords();
+        void roundTripEmptyValues();
+        void writeRecordsSortedById();
+        void convertXmlToJsonAndBack();
+        void rejectInvalidRecord();
+
+    private:
+        Tome::RecordSet createRecordSet() const;
+
+        void compareRecordSets(const Tome::RecordSet& actual, const Tome::RecordSet& expected) const;
+
+        QByteArray writeJson(const Tome::RecordSet& recordSet) const;
+        QByteArray writeXml(const Tome::RecordSet& recordSet) const;
+        Tome::RecordSet readJson(const QByteArray& data) const;
+        Tome::RecordSet readXml(const QByteArray& data) const;
+};
+
+#endif // TESTJSONRECORDSETSERIALIZER_H
@@ -0,0 +1,125 @@
+#include "teststringreplacer.h"
+
+#include "../Util/stringreplacer.h"
+
+using namespace Tome;
+
+
+void TestStringReplacer::replaceNone()
+{
+    // ARRANGE.
+    StringReplacer stringReplacer;
+    QString string = "ab";
+
+    // ACT.
+    bool replaced = stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(replaced, false);
+    QCOMPARE(string, QString("ab"));
+}
+
+void TestStringReplacer::replaceNoMatch()
+{
+    // ARRANGE.
+    QMap<QString, QString> replacements;
+    replacements.insert("c", "d");
+    replacements.insert("ef", "g");
+
+    StringReplacer stringReplacer = StringReplacer(replacements);
+    QString string = "ab";
+
+    // ACT.
+    bool replaced = stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(replaced, false);
+    QCOMPARE(string, QString("ab"));
+}
+
+void TestStringReplacer::replaceSingleCharacters()
+{
+    // ARRANGE.
+    QMap<QString, QString> replacements;
+    replacements.insert("\n", "\\n");
+    replacements.insert("\t", "\\t");
+
+    StringReplacer stringReplacer = StringReplacer(replacements);
+    QString string = "a\nb\tc\n";
+
+    // ACT.
+    bool replaced = stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(replaced, true);
+    QCOMPARE(string, QString("a\\nb\\tc\\n"));
+}
+
+void TestStringReplacer::replaceSingleCharactersInOrder()
+{
+    // ARRANGE.
+    QMap<QString, QString> replacements;
+    replacements.insert("\"", "\\\"");
+    replacements.insert("\\", "\\\\");
+
+    StringReplacer stringReplacer = StringReplacer(replacements);
+    QString string = "a\"b";
+
+    // ACT.
+    stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(string, QString("a\\\\\"b"));
+}
+
+void TestStringReplacer::replaceIndependentKeys()
+{
+    // ARRANGE.
+    QMap<QString, QString> replacements;
+    replacements.insert("&amp;", "&");
+    replacements.insert("<br>", "\n");
+
+    StringReplacer stringReplacer = StringReplacer(replacements);
+    QString string = "a<br>b&amp;c<br>";
+
+    // ACT.
+    bool replaced = stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(replaced, true);
+    QCOMPARE(string, QString("a\nb&c\n"));
+}
+
+void TestStringReplacer::replaceOverlappingKeys()
+{
+    // ARRANGE.
+    QMap<QString, QString> replacements;
+    replacements.insert("bc", "X");
+    replacements.insert("cab", "Y");
+
+    StringReplacer stringReplacer = StringReplacer(replacements);
+    QString string = "cabc";
+
+    // ACT.
+    stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(string, QString("caX"));
+}
+
+void TestStringReplacer::replaceKeysJoinedByRemoval()
+{
+    // ARRANGE.
+    QMap<QString, QString> replacements;
+    replacements.insert("-", "");
+    replacements.insert("ab", "X");
+
+    StringReplacer stringReplacer = StringReplacer(replacements);
+    QString string = "a-b";
+
+    // ACT.
+    stringReplacer.replace(string);
+
+    // ASSERT.
+    QCOMPARE(string, QString("X"));
+}
@@ -0,0 +1,24 @@
+#ifndef TESTSTRINGREPLACER_H
+#define TESTSTRINGREPLACER_H
+
+#include <QtTest/QtTest>
+
+
+/**
+ * @brief Unit tests for applying string replacements.
+ */
+class TestStringReplacer : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void replaceNone();
+        void replaceNoMatch();
+        void replaceSingleCharacters();
+        void replaceSingleCharactersInOrder();
+        void replaceIndependentKeys();
+        void replaceOverlappingKeys();
+        void replaceKeysJoinedByRemoval();
+};
+
+#endif // TESTSTRINGREPLACER_H
@@ -0,0 +1,266 @@
+#include "testxlsxreader.h"
+
+#include <QtZlib/zlib.h>
+
+#include "../IO/xlsxreader.h"
+
+
+void TestXlsxReader::readSharedStrings()
+{
+    // ARRANGE.
+    QByteArray sharedStrings = "<si><t>id</t></si><si><t>name</t></si><si><t>Sword</t></si>";
+    QByteArray rows =
+            "<row r=\"1\"><c r=\"A1\" t=\"s\"><v>0</v></c><c r=\"B1\" t=\"s\"><v>1</v></c></row>"
+            "<row r=\"2\"><c r=\"A2\"><v>7</v></c><c r=\"B2\" t=\"s\"><v>2</v></c></row>";
+
+    QByteArray workbook = this->createWorkbook(rows, sharedStrings);
+
+    // ACT.
+    QList<QStringList> sheetRows = this->readRows(workbook);
+
+    // ASSERT.
+    QCOMPARE(sheetRows.size(), 2);
+    QCOMPARE(sheetRows[0], QStringList() << "id" << "name");
+    QCOMPARE(sheetRows[1], QStringList() << "7" << "Sword");
+}
+
+void TestXlsxReader::readRichAndInlineStrings()
+{
+    // ARRANGE.
+    QByteArray sharedStrings = "<si><r><t>Long </t></r><r><t>Bow</t></r><rPh><t>x</t></rPh></si>";
+    QByteArray rows =
+            "<row r=\"1\"><c r=\"A1\" t=\"s\"><v>0</v></c><c r=\"B1\" t=\"inlineStr\"><is><t>Axe</t></is></c></row>";
+
+    QByteArray workbook = this->createWorkbook(rows, sharedStrings);
+
+    // ACT.
+    QList<QStringList> sheetRows = this->readRows(workbook);
+
+    // ASSERT.
+    QCOMPARE(sheetRows.size(), 1);
+    QCOMPARE(sheetRows[0], QStringList() << "Long Bow" << "Axe");
+}
+
+void TestXlsxReader::fillMissingCells()
+{
+    // ARRANGE.
+    QByteArray rows =
+            "<row r=\"1\"><c r=\"B1\"><f>1+1</f><v>2</v></c><c r=\"D1\" t=\"b\"><v>1</v></c></row>"
+            "<row r=\"3\"><c><v>3</v></c><c/><c><v>5</v></c></row>";
+
+    QByteArray workbook = this->createWorkbook(rows, QByteArray());
+
+    // ACT.
+    QList<QStringList> sheetRows = this->readRows(workbook);
+
+    // ASSERT.
+    QCOMPARE(sheetRows.size(), 2);
+    QCOMPARE(sheetRows[0], QStringList() << "" << "2" << "" << "true");
+    QCOMPARE(sheetRows[1], QStringList() << "3" << "" << "5");
+}
+
+void TestXlsxReader::readDeflatedEntries()
+{
+    // ARRANGE.
+    QByteArray sharedStrings = "<si><t>id</t></si>";
+    QByteArray rows;
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        const QByteArray index = QByteArray::number(i);
+        rows.append("<row r=\"" + index + "\"><c r=\"A" + index + "\" t=\"s\"><v>0</v></c><c r=\"B" + index + "\"><v>" + index + "</v></c></row>");
+    }
+
+    QByteArray workbook = this->createWorkbook(rows, sharedStrings, true);
+
+    // ACT.
+    QList<QStringList> sheetRows = this->readRows(workbook);
+
+    // ASSERT.
+    QCOMPARE(sheetRows.size(), 1000);
+    QCOMPARE(sheetRows[0], QStringList() << "id" << "1");
+    QCOMPARE(sheetRows[999], QStringList() << "id" << "1000");
+}
+
+void TestXlsxReader::reportMissingSheet()
+{
+    // ARRANGE.
+    QByteArray workbook = this->createWorkbook(QByteArray(), QByteArray());
+    XlsxReader reader(workbook);
+
+    // ACT.
+    bool opened = reader.open("Missing");
+
+    // ASSERT.
+    QCOMPARE(opened, false);
+    QVERIFY(!reader.getErrorString().isEmpty());
+}
+
+void TestXlsxReader::reportColumnOutOfRange()
+{
+    // ARRANGE.
+    QByteArray rows =
+            "<row r=\"1\"><c r=\"XFD1\"><v>1</v></c></row>"
+            "<row r=\"2\"><c r=\"XFE2\"><v>2</v></c></row>";
+
+    QByteArray workbook = this->createWorkbook(rows, QByteArray());
+    XlsxReader reader(workbook);
+    reader.open("Items");
+
+    // ACT.
+    bool lastColumnRead = reader.readRow();
+    int lastColumnCount = reader.getRow().size();
+    bool columnBeyondLastRead = reader.readRow();
+
+    // ASSERT.
+    QCOMPARE(lastColumnRead, true);
+    QCOMPARE(lastColumnCount, 16384);
+    QCOMPARE(columnBeyondLastRead, false);
+    QVERIFY(reader.hasError());
+}
+
+void TestXlsxReader::appendUInt16(QByteArray& data, quint16 value) const
+{
+    data.append(static_cast<char>(value & 0xFF));
+    data.append(static_cast<char>((value >> 8) & 0xFF));
+}
+
+void TestXlsxReader::appendUInt32(QByteArray& data, quint32 value) const
+{
+    this->appendUInt16(data, static_cast<quint16>(value & 0xFFFF));
+    this->appendUInt16(data, static_cast<quint16>((value >> 16) & 0xFFFF));
+}
+
+QByteArray TestXlsxReader::createWorkbook(const QByteArray& rows, const QByteArray& sharedStrings, bool compress) const
+{
+    QList<QPair<QString, QByteArray>> entries;
+
+    entries << qMakePair(QString("xl/workbook.xml"), QByteArray(
+                             "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                             "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+                             "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+                             "<sheets><sheet name=\"Items\" sheetId=\"1\" r:id=\"rId1\"/></sheets></workbook>"));
+
+    entries << qMakePair(QString("xl/_rels/workbook.xml.rels"), QByteArray(
+                             "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                             "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                             "<Relationship Id=\"rId1\" "
+                             "Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" "
+                             "Target=\"worksheets/sheet1.xml\"/></Relationships>"));
+
+    entries << qMakePair(QString("xl/worksheets/sheet1.xml"),
+                         "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                         "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+                         "<sheetData>" + rows + "</sheetData></worksheet>");
+
+    if (!sharedStrings.isEmpty())
+    {
+        entries << qMakePair(QString("xl/sharedStrings.xml"),
+                             "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+                             "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+                             + sharedStrings + "</sst>");
+    }
+
+    // Write zip archive.
+    QByteArray archive;
+    QByteArray centralDirectory;
+
+    for (const QPair<QString, QByteArray>& entry : entries)
+    {
+        const QByteArray name = entry.first.toUtf8();
+        const QByteArray& content = entry.second;
+        const QByteArray data = compress ? this->deflateRaw(content) : content;
+        const quint16 method = compress ? 8 : 0;
+        const quint32 crc = crc32(0, reinterpret_cast<const Bytef*>(content.constData()), content.size());
+        const quint32 localHeaderOffset = archive.size();
+
+        // Local file header.
+        this->appendUInt32(archive, 0x04034b50);
+        this->appendUInt16(archive, 20);
+        this->appendUInt16(archive, 0);
+        this->appendUInt16(archive, method);
+        this->appendUInt32(archive, 0);
+        this->appendUInt32(archive, crc);
+        this->appendUInt32(archive, data.size());
+        this->appendUInt32(archive, content.size());
+        this->appendUInt16(archive, name.size());
+        this->appendUInt16(archive, 0);
+        archive.append(name);
+        archive.append(data);
+
+        // Central directory header.
+        this->appendUInt32(centralDirectory, 0x02014b50);
+        this->appendUInt16(centralDirectory, 20);
+        this->appendUInt16(centralDirectory, 20);
+        this->appendUInt16(centralDirectory, 0);
+        this->appendUInt16(centralDirectory, method);
+        this->appendUInt32(centralDirectory, 0);
+        this->appendUInt32(centralDirectory, crc);
+        this->appendUInt32(centralDirectory, data.size());
+        this->appendUInt32(centralDirectory, content.size());
+        this->appendUInt16(centralDirectory, name.size());
+        this->appendUInt16(centralDirectory, 0);
+        this->appendUInt16(centralDirectory, 0);
+        this->appendUInt16(centralDirectory, 0);
+        this->appendUInt16(centralDirectory, 0);
+        this->appendUInt32(centralDirectory, 0);
+        this->appendUInt32(centralDirectory, localHeaderOffset);
+        centralDirectory.append(name);
+    }
+
+    const quint32 centralDirectoryOffset = archive.size();
+    archive.append(centralDirectory);
+
+    // End of central directory record.
+    this->appendUInt32(archive, 0x06054b50);
+    this->appendUInt16(archive, 0);
+    this->appendUInt16(archive, 0);
+    this->appendUInt16(archive, entries.size());
+    this->appendUInt16(archive, entries.size());
+    this->appendUInt32(archive, centralDirectory.size());
+    this->appendUInt32(archive, centralDirectoryOffset);
+    this->appendUInt16(archive, 0);
+
+    return archive;
+}
+
+QByteArray TestXlsxReader::deflateRaw(const QByteArray& data) const
+{
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+    QByteArray compressed(static_cast<int>(deflateBound(&stream, data.size())), '\0');
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = compressed.size();
+
+    deflate(&stream, Z_FINISH);
+    compressed.resize(compressed.size() - stream.avail_out);
+    deflateEnd(&stream);
+
+    return compressed;
+}
+
+QList<QStringList> TestXlsxReader::readRows(const QByteArray& workbook) const
+{
+    QList<QStringList> rows;
+    XlsxReader reader(workbook);
+
+    if (!reader.open("Items"))
+    {
+        return rows;
+    }
+
+    while (reader.readRow())
+    {
+        rows << reader.getRow();
+    }
+
+    return rows;
+}
@@ -0,0 +1,30 @@
+#ifndef TESTXLSXREADER_H
+#define TESTXLSXREADER_H
+
+#include <QtTest/QtTest>
+
+
+/**
+ * @brief Unit tests for reading Excel workbooks sheet by sheet.
+ */
+class TestXlsxReader : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void readSharedStrings();
+        void readRichAndInlineStrings();
+        void fillMissingCells();
+        void readDeflatedEntries();
+        void reportMissingSheet();
+        void reportColumnOutOfRange();
+
+    private:
+        void appendUInt16(QByteArray& data, quint16 value) const;
+        void appendUInt32(QByteArray& data, quint32 value) const;
+        QByteArray createWorkbook(const QByteArray& rows, const QByteArray& sharedStrings, bool compress = false) const;
+        QByteArray deflateRaw(const QByteArray& data) const;
+        QList<QStringList> readRows(const QByteArray& workbook) const;
+};
+
+#endif // TESTXLSXREADER_H
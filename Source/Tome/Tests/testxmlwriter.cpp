@@ -0,0 +1,155 @@
+#include "testxmlwriter.h"
+
+#include <QBuffer>
+#include <QXmlStreamWriter>
+
+#include "../IO/xmlwriter.h"
+
+
+void TestXmlWriter::writeEmptyDocument()
+{
+    // ARRANGE.
+    QVector<XmlOperation> operations;
+    operations << XmlOperation { XmlOperation::StartElement, "Records", QString() }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() };
+
+    // ACT & ASSERT.
+    this->compareOutput(operations);
+}
+
+void TestXmlWriter::writeNestedElements()
+{
+    // ARRANGE.
+    QVector<XmlOperation> operations;
+    operations << XmlOperation { XmlOperation::StartElement, "Records", QString() }
+               << XmlOperation { XmlOperation::Attribute, "Version", "2" }
+               << XmlOperation { XmlOperation::StartElement, "Record", QString() }
+               << XmlOperation { XmlOperation::Attribute, "Id", "A" }
+               << XmlOperation { XmlOperation::StartElement, "Field", QString() }
+               << XmlOperation { XmlOperation::Attribute, "Id", "Health" }
+               << XmlOperation { XmlOperation::Attribute, "Value", "100" }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() }
+               << XmlOperation { XmlOperation::StartElement, "Field", QString() }
+               << XmlOperation { XmlOperation::StartElement, "ListItem", QString() }
+               << XmlOperation { XmlOperation::Attribute, "Value", "1" }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() }
+               << XmlOperation { XmlOperation::StartElement, "Record", QString() }
+               << XmlOperation { XmlOperation::Attribute, "Id", "B" }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() };
+
+    // ACT & ASSERT.
+    // Root element is left open, to be closed by writing the end of the document.
+    this->compareOutput(operations);
+}
+
+void TestXmlWriter::escapeSpecialCharacters()
+{
+    // ARRANGE.
+    QVector<XmlOperation> operations;
+    operations << XmlOperation { XmlOperation::StartElement, "Record", QString() }
+               << XmlOperation { XmlOperation::Attribute, "DisplayName", "<a href=\"b\">&amp; c</a>" }
+               << XmlOperation { XmlOperation::Attribute, "Description", "'single' & \"double\" > less <" }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() };
+
+    // ACT & ASSERT.
+    this->compareOutput(operations);
+}
+
+void TestXmlWriter::escapeControlCharacters()
+{
+    // ARRANGE.
+    QVector<XmlOperation> operations;
+    operations << XmlOperation { XmlOperation::StartElement, "Record", QString() }
+               << XmlOperation { XmlOperation::Attribute, "Value", "a\tb\nc\rd\r\n" }
+               << XmlOperation { XmlOperation::Attribute, "Empty", QString() }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() };
+
+    // ACT & ASSERT.
+    this->compareOutput(operations);
+}
+
+void TestXmlWriter::writeNonAsciiCharacters()
+{
+    // ARRANGE.
+    QVector<XmlOperation> operations;
+    operations << XmlOperation { XmlOperation::StartElement, QString::fromUtf8("Rüstung"), QString() }
+               << XmlOperation { XmlOperation::Attribute, "Value", QString::fromUtf8("Größe & Gewicht: 5 € \xF0\x9F\x97\xA1") }
+               << XmlOperation { XmlOperation::EndElement, QString(), QString() };
+
+    // ACT & ASSERT.
+    this->compareOutput(operations);
+}
+
+void TestXmlWriter::compareOutput(const QVector<XmlOperation>& operations) const
+{
+    const QByteArray expected = this->writeWithQXmlStreamWriter(operations);
+    const QByteArray actual = this->writeWithXmlWriter(operations);
+
+    QCOMPARE(actual, expected);
+}
+
+QByteArray TestXmlWriter::writeWithQXmlStreamWriter(const QVector<XmlOperation>& operations) const
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    QXmlStreamWriter writer(&buffer);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+
+    for (const XmlOperation& operation : operations)
+    {
+        switch (operation.type)
+        {
+            case XmlOperation::StartElement:
+                writer.writeStartElement(operation.name);
+                break;
+
+            case XmlOperation::Attribute:
+                writer.writeAttribute(operation.name, operation.value);
+                break;
+
+            case XmlOperation::EndElement:
+                writer.writeEndElement();
+                break;
+        }
+    }
+
+    writer.writeEndDocument();
+    return buffer.data();
+}
+
+QByteArray TestXmlWriter::writeWithXmlWriter(const QVector<XmlOperation>& operations) const
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    {
+        XmlWriter writer(&buffer);
+        writer.writeStartDocument();
+
+        for (const XmlOperation& operation : operations)
+        {
+            switch (operation.type)
+            {
+                case XmlOperation::StartElement:
+                    writer.writeStartElement(operation.name);
+                    break;
+
+                case XmlOperation::Attribute:
+                    writer.writeAttribute(operation.name.toUtf8(), operation.value);
+                    break;
+
+                case XmlOperation::EndElement:
+                    writer.writeEndElement();
+                    break;
+            }
+        }
+
+        writer.writeEndDocument();
+    }
+
+    return buffer.data();
+}
@@ -0,0 +1,44 @@
+#ifndef TESTXMLWRITER_H
+#define TESTXMLWRITER_H
+
+#include <QtTest/QtTest>
+
+
+/**
+ * @brief Unit tests for writing XML with the same output as QXmlStreamWriter.
+ */
+class TestXmlWriter : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void writeEmptyDocument();
+        void writeNestedElements();
+        void escapeSpecialCharacters();
+        void escapeControlCharacters();
+        void writeNonAsciiCharacters();
+
+    private:
+        /**
+         * @brief Single call to an XML writer.
+         */
+        struct XmlOperation
+        {
+            enum Type
+            {
+                StartElement,
+                Attribute,
+                EndElement
+            };
+
+            Type type;
+            QString name;
+            QString value;
+        };
+
+        void compareOutput(const QVector<XmlOperation>& operations) const;
+        QByteArray writeWithQXmlStreamWriter(const QVector<XmlOperation>& operations) const;
+        QByteArray writeWithXmlWriter(const QVector<XmlOperation>& operations) const;
+};
+
+#endif // TESTXMLWRITER_H
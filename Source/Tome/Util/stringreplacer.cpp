@@ -0,0 +1,287 @@
+#include "stringreplacer.h"
+
+#include <QStringList>
+#include <QStringRef>
+
+using namespace Tome;
+
+
+StringReplacer::StringReplacer()
+    : mode(ModeNone)
+{
+}
+
+StringReplacer::StringReplacer(const QMap<QString, QString>& replacements)
+    : mode(ModeNone),
+      replacements(replacements),
+      firstCharacters(0x10000)
+{
+    if (replacements.isEmpty())
+    {
+        return;
+    }
+
+    // Collect first characters of all keys.
+    bool singleCharacterKeys = true;
+
+    for (auto it = replacements.cbegin(); it != replacements.cend(); ++it)
+    {
+        if (it.key().isEmpty())
+        {
+            // Empty keys match everywhere, even in empty strings. Always replace entry by entry.
+            this->mode = ModeSequential;
+            this->firstCharacters = QBitArray();
+            return;
+        }
+
+        this->firstCharacters.setBit(it.key().at(0).unicode());
+
+        if (it.key().length() > 1)
+        {
+            singleCharacterKeys = false;
+        }
+    }
+
+    if (singleCharacterKeys)
+    {
+        // Single character keys can't span any other text, so each character can be replaced
+        // by the result of applying all replacements to that character alone.
+        for (auto it = replacements.cbegin(); it != replacements.cend(); ++it)
+        {
+            QString characterReplacement = it.key();
+            this->replaceSequentially(characterReplacement);
+            this->characterReplacements.insert(it.key().at(0), characterReplacement);
+        }
+
+        this->mode = ModeSingleCharacter;
+        return;
+    }
+
+    // Check whether any replacement could affect the matches of any later one.
+    const QStringList keys = replacements.keys();
+    const QStringList values = replacements.values();
+
+    for (int i = 0; i < keys.size(); ++i)
+    {
+        for (int j = i + 1; j < keys.size(); ++j)
+        {
+            if (this->keysOverlap(keys[i], keys[j]) || this->valueCanCreateKey(values[i], keys[j]))
+            {
+                this->mode = ModeSequential;
+                return;
+            }
+        }
+    }
+
+    // Replacements are independent of each other - replace all of them in a single scan.
+    for (auto it = replacements.cbegin(); it != replacements.cend(); ++it)
+    {
+        Replacement replacement;
+        replacement.key = it.key();
+        replacement.value = it.value();
+
+        this->replacementsByFirstCharacter[it.key().at(0)].append(replacement);
+    }
+
+    this->mode = ModeSinglePass;
+}
+
+bool StringReplacer::isEmpty() const
+{
+    return this->mode == ModeNone;
+}
+
+bool StringReplacer::replace(QString& s) const
+{
+    switch (this->mode)
+    {
+        case ModeSingleCharacter:
+            return this->replaceCharacters(s);
+
+        case ModeSinglePass:
+            return this->replaceSinglePass(s);
+
+        case ModeSequential:
+            if (!this->firstCharacters.isEmpty() && !this->containsFirstCharacter(s))
+            {
+                return false;
+            }
+
+            return this->replaceSequentially(s);
+
+        default:
+            return false;
+    }
+}
+
+bool StringReplacer::containsFirstCharacter(const QString& s) const
+{
+    const QChar* data = s.constData();
+    const int length = s.length();
+
+    for (int i = 0; i < length; ++i)
+    {
+        if (this->firstCharacters.testBit(data[i].unicode()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool StringReplacer::keysOverlap(const QString& lhs, const QString& rhs) const
+{
+    if (lhs.contains(rhs) || rhs.contains(lhs))
+    {
+        return true;
+    }
+
+    // Check whether any end of one key is the start of the other one.
+    const int maxLength = qMin(lhs.length(), rhs.length());
+
+    for (int length = 1; length < maxLength; ++length)
+    {
+        if (lhs.endsWith(rhs.leftRef(length)) || rhs.endsWith(lhs.leftRef(length)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool StringReplacer::replaceCharacters(QString& s) const
+{
+    const QChar* data = s.constData();
+    const int length = s.length();
+
+    // Copy runs of characters without replacements as a whole.
+    QString result;
+    bool replaced = false;
+    int start = 0;
+
+    for (int i = 0; i < length; ++i)
+    {
+        if (!this->firstCharacters.testBit(data[i].unicode()))
+        {
+            continue;
+        }
+
+        if (!replaced)
+        {
+            result.reserve(length + length / 4);
+            replaced = true;
+        }
+
+        result.append(data + start, i - start);
+        result.append(this->characterReplacements.value(data[i]));
+        start = i + 1;
+    }
+
+    if (!replaced)
+    {
+        return false;
+    }
+
+    result.append(data + start, length - start);
+    s = result;
+    return true;
+}
+
+bool StringReplacer::replaceSequentially(QString& s) const
+{
+    bool replaced = false;
+
+    for (auto it = this->replacements.cbegin(); it != this->replacements.cend(); ++it)
+    {
+        if (s.contains(it.key()))
+        {
+            s.replace(it.key(), it.value());
+            replaced = true;
+        }
+    }
+
+    return replaced;
+}
+
+bool StringReplacer::replaceSinglePass(QString& s) const
+{
+    const QChar* data = s.constData();
+    const int length = s.length();
+
+    // Copy runs of characters without replacements as a whole.
+    QString result;
+    bool replaced = false;
+    int start = 0;
+    int i = 0;
+
+    while (i < length)
+    {
+        if (!this->firstCharacters.testBit(data[i].unicode()))
+        {
+            ++i;
+            continue;
+        }
+
+        // Keys don't overlap, so at most one of them can match at any position.
+        const Replacement* match = nullptr;
+        const QVector<Replacement>& candidates = this->replacementsByFirstCharacter.constFind(data[i]).value();
+
+        for (const Replacement& candidate : candidates)
+        {
+            if (candidate.key.length() <= length - i &&
+                    QStringRef(&s, i, candidate.key.length()) == candidate.key)
+            {
+                match = &candidate;
+                break;
+            }
+        }
+
+        if (match == nullptr)
+        {
+            ++i;
+            continue;
+        }
+
+        if (!replaced)
+        {
+            result.reserve(length + length / 4);
+            replaced = true;
+        }
+
+        result.append(data + start, i - start);
+        result.append(match->value);
+        i += match->key.length();
+        start = i;
+    }
+
+    if (!replaced)
+    {
+        return false;
+    }
+
+    result.append(data + start, length - start);
+    s = result;
+    return true;
+}
+
+bool StringReplacer::valueCanCreateKey(const QString& value, const QString& key) const
+{
+    // Removing text joins the text around it, which might form the key.
+    if (value.isEmpty())
+    {
+        return true;
+    }
+
+    // Any occurrence of the key created by inserting the value has to contain a character of the value.
+    for (const QChar c : key)
+    {
+        if (value.contains(c))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
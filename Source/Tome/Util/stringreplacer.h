@@ -0,0 +1,77 @@
+#ifndef STRINGREPLACER_H
+#define STRINGREPLACER_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+namespace Tome
+{
+    /**
+     * @brief Applies a whole map of string replacements to strings at once.
+     *
+     * Produces exactly the same results as calling QString::replace for each entry of the map, in map order.
+     * The replacements are analyzed once on construction: If all keys are single characters, or no key can
+     * interfere with any other, strings are replaced in a single scan. Otherwise, strings that don't contain
+     * any key are detected in a single scan, and all others are replaced entry by entry.
+     */
+    class StringReplacer
+    {
+        public:
+            /**
+             * @brief Constructs a string replacer that doesn't replace anything.
+             */
+            StringReplacer();
+
+            /**
+             * @brief Constructs a string replacer for the passed map of string replacements.
+             * @param replacements Strings to replace, mapped to their replacements.
+             */
+            explicit StringReplacer(const QMap<QString, QString>& replacements);
+
+            /**
+             * @brief Checks whether this string replacer doesn't replace anything.
+             * @return true, if there are no replacements, and false otherwise.
+             */
+            bool isEmpty() const;
+
+            /**
+             * @brief Applies all replacements to the passed string.
+             * @param s String to apply all replacements to.
+             * @return true, if any key has been found in the string, and false otherwise.
+             */
+            bool replace(QString& s) const;
+
+        private:
+            enum Mode
+            {
+                ModeNone,
+                ModeSingleCharacter,
+                ModeSinglePass,
+                ModeSequential
+            };
+
+            struct Replacement
+            {
+                QString key;
+                QString value;
+            };
+
+            Mode mode;
+            QMap<QString, QString> replacements;
+            QBitArray firstCharacters;
+            QHash<QChar, QString> characterReplacements;
+            QHash<QChar, QVector<Replacement>> replacementsByFirstCharacter;
+
+            bool containsFirstCharacter(const QString& s) const;
+            bool keysOverlap(const QString& lhs, const QString& rhs) const;
+            bool replaceCharacters(QString& s) const;
+            bool replaceSequentially(QString& s) const;
+            bool replaceSinglePass(QString& s) const;
+            bool valueCanCreateKey(const QString& value, const QString& key) const;
+    };
+}
+
+#endif // STRINGREPLACER_H
@@ -1,16 +1,37 @@
 #include <QtTest/QtTest>
 
+#include "Tests/testbinaryrecordexport.h"
+#include "Tests/testcppheaderwriter.h"
+#include "Tests/testcsvreader.h"
+#include "Tests/testjsonrecordsetserializer.h"
 #include "Tests/testlistutils.h"
+#include "Tests/teststringreplacer.h"
 #include "Tests/teststringutils.h"
+#include "Tests/testxlsxreader.h"
+#include "Tests/testxmlwriter.h"
 
 
 int main(int argc, char** argv)
 {
     QApplication app(argc, argv);
 
+    TestBinaryRecordExport testBinaryRecordExport;
+    TestCppHeaderWriter testCppHeaderWriter;
+    TestCsvReader testCsvReader;
+    TestJsonRecordSetSerializer testJsonRecordSetSerializer;
     TestListUtils testListUtils;
+    TestStringReplacer testStringReplacer;
     TestStringUtils testStringUtils;
+    TestXlsxReader testXlsxReader;
+    TestXmlWriter testXmlWriter;
 
-    return QTest::qExec(&testListUtils, argc, argv) &
-           QTest::qExec(&testStringUtils, argc, argv);
+    return QTest::qExec(&testBinaryRecordExport, argc, argv) |
+           QTest::qExec(&testCppHeaderWriter, argc, argv) |
+           QTest::qExec(&testCsvReader, argc, argv) |
+           QTest::qExec(&testJsonRecordSetSerializer, argc, argv) |
+           QTest::qExec(&testListUtils, argc, argv) |
+           QTest::qExec(&testStringReplacer, argc, argv) |
+           QTest::qExec(&testStringUtils, argc, argv) |
+           QTest::qExec(&testXlsxReader, argc, argv) |
+           QTest::qExec(&testXmlWriter, argc, argv);
 }
@@ -0,0 +1,662 @@
+#ifndef TOMEBINARYREADER_H
+#define TOMEBINARYREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Header-only reader for records exported by Tome as binary file.
+ *
+ * Doesn't depend on Qt or Tome, and doesn't allocate any memory: Point the reader to the contents of
+ * a binary export (e.g. a memory-mapped file), and read strings and values right from that memory.
+ * The memory has to stay valid as long as the reader is used.
+ */
+namespace Tome
+{
+    namespace Binary
+    {
+        /**
+         * @brief Encoding of the values of a single column.
+         */
+        enum class ValueType : uint8_t
+        {
+            None,
+            Boolean,
+            Integer,
+            Real,
+            String,
+            Color,
+            Vector2I,
+            Vector2R,
+            Vector3I,
+            Vector3R,
+            List,
+            Map
+        };
+
+        /**
+         * @brief UTF-8 string stored in the file. Always followed by a terminating zero byte.
+         */
+        struct String
+        {
+            /**
+             * @brief First byte of the string.
+             */
+            const char* data;
+
+            /**
+             * @brief Length of the string, in bytes, without the terminating zero byte.
+             */
+            uint32_t size;
+
+            /**
+             * @brief Checks whether this string consists of the specified bytes.
+             * @param s Bytes to compare this string with.
+             * @param length Number of bytes to compare this string with.
+             * @return true, if this string consists of exactly the specified bytes, and false otherwise.
+             */
+            bool equals(const char* s, size_t length) const
+            {
+                return this->size == length && memcmp(this->data, s, length) == 0;
+            }
+        };
+
+        /**
+         * @brief Column of values of a single field.
+         */
+        struct Column
+        {
+            /**
+             * @brief Id of the field whose values are stored in this column.
+             */
+            String fieldId;
+
+            /**
+             * @brief Tome type of the field, as shown in the editor.
+             */
+            String fieldType;
+
+            /**
+             * @brief Component of the field, or an empty string if the field doesn't belong to any component.
+             */
+            String component;
+
+            /**
+             * @brief Encoding of the values of this column.
+             */
+            ValueType valueType;
+
+            /**
+             * @brief Encoding of list items or map values, if values of this column are lists or maps.
+             */
+            ValueType itemType;
+        };
+
+        /**
+         * @brief Reads records from a binary export.
+         */
+        class Reader
+        {
+            public:
+                /**
+                 * @brief Version of the binary file format supported by this reader.
+                 */
+                static const uint32_t Version = 1;
+
+                /**
+                 * @brief Row of records that don't have a parent.
+                 */
+                static const uint32_t NoParent = 0xFFFFFFFF;
+
+                /**
+                 * @brief Uses the passed memory as binary export to read from, validating all offsets.
+                 * @param data Contents of the binary export.
+                 * @param size Size of the binary export, in bytes.
+                 * @return true, if the memory contains a valid binary export of the supported version, and false otherwise.
+                 */
+                bool open(const void* data, size_t size)
+                {
+                    this->data = static_cast<const uint8_t*>(data);
+                    this->size = size;
+
+                    if (this->data == nullptr || size < HeaderSize ||
+                            this->readUInt32(0) != Magic || this->readUInt32(4) != Version)
+                    {
+                        return this->fail();
+                    }
+
+                    this->recordCount = this->readUInt32(8);
+                    this->columnCount = this->readUInt32(12);
+                    this->stringCount = this->readUInt32(16);
+                    this->itemCount = this->readUInt32(20);
+                    this->stringOffsetsOffset = this->readUInt32(24);
+                    this->stringDataOffset = this->readUInt32(28);
+                    this->columnsOffset = this->readUInt32(32);
+                    this->recordsOffset = this->readUInt32(36);
+                    this->recordIndexOffset = this->readUInt32(40);
+                    this->itemsOffset = this->readUInt32(44);
+
+                    // Validate tables.
+                    if (this->stringCount == 0 ||
+                            !this->contains(this->stringOffsetsOffset, (uint64_t(this->stringCount) + 1) * 4) ||
+                            !this->contains(this->columnsOffset, uint64_t(this->columnCount) * ColumnSize) ||
+                            !this->contains(this->recordsOffset, uint64_t(this->recordCount) * RecordSize) ||
+                            !this->contains(this->recordIndexOffset, uint64_t(this->recordCount) * 4) ||
+                            !this->contains(this->itemsOffset, uint64_t(this->itemCount) * ItemSize))
+                    {
+                        return this->fail();
+                    }
+
+                    // Validate strings.
+                    const uint32_t stringDataSize = this->readUInt32(this->stringOffsetsOffset + size_t(this->stringCount) * 4);
+
+                    if (!this->contains(this->stringDataOffset, stringDataSize))
+                    {
+                        return this->fail();
+                    }
+
+                    for (uint32_t i = 0; i < this->stringCount; ++i)
+                    {
+                        const uint32_t begin = this->readUInt32(this->stringOffsetsOffset + size_t(i) * 4);
+                        const uint32_t end = this->readUInt32(this->stringOffsetsOffset + (size_t(i) + 1) * 4);
+
+                        if (begin >= end || end > stringDataSize || this->readUInt8(this->stringDataOffset + size_t(end) - 1) != 0)
+                        {
+                            return this->fail();
+                        }
+                    }
+
+                    // Validate records. Rows are read right from the file when searching or resolving parents.
+                    for (uint32_t i = 0; i < this->recordCount; ++i)
+                    {
+                        const size_t record = this->recordsOffset + size_t(i) * RecordSize;
+                        const uint32_t parentRow = this->readUInt32(record + 8);
+
+                        if (this->readUInt32(this->recordIndexOffset + size_t(i) * 4) >= this->recordCount ||
+                                !this->isString(this->readUInt32(record)) ||
+                                !this->isString(this->readUInt32(record + 4)) ||
+                                (parentRow >= this->recordCount && parentRow != NoParent))
+                        {
+                            return this->fail();
+                        }
+                    }
+
+                    // Validate columns.
+                    const uint64_t bitmapSize = ((uint64_t(this->recordCount) + 7) / 8 + 7) / 8 * 8;
+
+                    for (uint32_t i = 0; i < this->columnCount; ++i)
+                    {
+                        const size_t column = this->columnsOffset + size_t(i) * ColumnSize;
+                        const uint8_t valueType = this->readUInt8(column + 12);
+                        const uint8_t itemType = this->readUInt8(column + 13);
+
+                        if (valueType > uint8_t(ValueType::Map) || itemType > uint8_t(ValueType::Map) ||
+                                !this->isString(this->readUInt32(column)) ||
+                                !this->isString(this->readUInt32(column + 4)) ||
+                                !this->isString(this->readUInt32(column + 8)) ||
+                                !this->contains(this->readUInt32(column + 16),
+                                                bitmapSize + uint64_t(getCellSize(ValueType(valueType))) * this->recordCount))
+                        {
+                            return this->fail();
+                        }
+                    }
+
+                    return true;
+                }
+
+                /**
+                 * @brief Gets the number of columns, i.e. field definitions, of the export.
+                 * @return Number of columns of the export.
+                 */
+                uint32_t getColumnCount() const
+                {
+                    return this->columnCount;
+                }
+
+                /**
+                 * @brief Gets the number of rows, i.e. records, of the export.
+                 * @return Number of rows of the export.
+                 */
+                uint32_t getRecordCount() const
+                {
+                    return this->recordCount;
+                }
+
+                /**
+                 * @brief Gets the column with the specified index.
+                 * @param index Index of the column to get.
+                 * @return Column with the specified index.
+                 */
+                Column getColumn(uint32_t index) const
+                {
+                    const size_t column = this->columnsOffset + size_t(index) * ColumnSize;
+
+                    Column result;
+                    result.fieldId = this->getString(this->readUInt32(column));
+                    result.fieldType = this->getString(this->readUInt32(column + 4));
+                    result.component = this->getString(this->readUInt32(column + 8));
+                    result.valueType = ValueType(this->readUInt8(column + 12));
+                    result.itemType = ValueType(this->readUInt8(column + 13));
+                    return result;
+                }
+
+                /**
+                 * @brief Finds the column of the field with the specified id.
+                 * @param fieldId Id of the field to find the column of, as UTF-8.
+                 * @param length Length of the field id, in bytes.
+                 * @param index Index of the column, if found.
+                 * @return true, if the column has been found, and false otherwise.
+                 */
+                bool findColumn(const char* fieldId, size_t length, uint32_t& index) const
+                {
+                    for (uint32_t i = 0; i < this->columnCount; ++i)
+                    {
+                        if (this->getString(this->readUInt32(this->columnsOffset + size_t(i) * ColumnSize)).equals(fieldId, length))
+                        {
+                            index = i;
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                /**
+                 * @brief Finds the row of the record with the specified id, using binary search.
+                 * @param recordId Id of the record to find, as UTF-8.
+                 * @param length Length of the record id, in bytes.
+                 * @param row Row of the record, if found.
+                 * @return true, if the record has been found, and false otherwise.
+                 */
+                bool findRecord(const char* recordId, size_t length, uint32_t& row) const
+                {
+                    uint32_t first = 0;
+                    uint32_t last = this->recordCount;
+
+                    while (first < last)
+                    {
+                        const uint32_t middle = first + (last - first) / 2;
+                        const uint32_t middleRow = this->readUInt32(this->recordIndexOffset + size_t(middle) * 4);
+                        const String middleId = this->getRecordId(middleRow);
+
+                        // Compare UTF-8 bytes, shorter strings first.
+                        const size_t commonLength = middleId.size < length ? middleId.size : length;
+                        int comparison = memcmp(middleId.data, recordId, commonLength);
+
+                        if (comparison == 0)
+                        {
+                            comparison = middleId.size < length ? -1 : (middleId.size > length ? 1 : 0);
+                        }
+
+                        if (comparison == 0)
+                        {
+                            row = middleRow;
+                            return true;
+                        }
+
+                        if (comparison < 0)
+                        {
+                            first = middle + 1;
+                        }
+                        else
+                        {
+                            last = middle;
+                        }
+                    }
+
+                    return false;
+                }
+
+                /**
+                 * @brief Gets the display name of the record in the specified row.
+                 * @param row Row of the record to get the display name of.
+                 * @return Display name of the record.
+                 */
+                String getRecordDisplayName(uint32_t row) const
+                {
+                    return this->getString(this->readUInt32(this->recordsOffset + size_t(row) * RecordSize + 4));
+                }
+
+                /**
+                 * @brief Gets the id of the record in the specified row.
+                 * @param row Row of the record to get the id of.
+                 * @return Id of the record.
+                 */
+                String getRecordId(uint32_t row) const
+                {
+                    return this->getString(this->readUInt32(this->recordsOffset + size_t(row) * RecordSize));
+                }
+
+                /**
+                 * @brief Gets the row of the parent of the record in the specified row.
+                 * @param row Row of the record to get the parent of.
+                 * @return Row of the parent of the record, or NoParent if the record doesn't have a parent.
+                 */
+                uint32_t getRecordParent(uint32_t row) const
+                {
+                    return this->readUInt32(this->recordsOffset + size_t(row) * RecordSize + 8);
+                }
+
+                /**
+                 * @brief Gets the string with the specified index.
+                 * @param index Index of the string to get.
+                 * @return String with the specified index, or an empty string if the index is invalid.
+                 */
+                String getString(uint32_t index) const
+                {
+                    if (!this->isString(index))
+                    {
+                        index = 0;
+                    }
+
+                    const uint32_t begin = this->readUInt32(this->stringOffsetsOffset + size_t(index) * 4);
+                    const uint32_t end = this->readUInt32(this->stringOffsetsOffset + (size_t(index) + 1) * 4);
+
+                    String result;
+                    result.data = reinterpret_cast<const char*>(this->data + this->stringDataOffset + begin);
+                    result.size = end - begin - 1;
+                    return result;
+                }
+
+                /**
+                 * @brief Checks whether the record in the specified row has a value for the field of the specified column.
+                 * @param column Index of the column to check.
+                 * @param row Row of the record to check.
+                 * @return true, if the record has a value for the field, and false otherwise.
+                 */
+                bool hasValue(uint32_t column, uint32_t row) const
+                {
+                    const size_t columnData = this->getColumnData(column);
+                    return (this->readUInt8(columnData + row / 8) & (1 << (row % 8))) != 0;
+                }
+
+                /**
+                 * @brief Gets the value of a Boolean column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @return Value of the field of the record.
+                 */
+                bool getBoolean(uint32_t column, uint32_t row) const
+                {
+                    return this->readUInt8(this->getCell(column, row)) != 0;
+                }
+
+                /**
+                 * @brief Gets the value of a Color column, as 0xAARRGGBB.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @return Value of the field of the record.
+                 */
+                uint32_t getColor(uint32_t column, uint32_t row) const
+                {
+                    return this->readUInt32(this->getCell(column, row));
+                }
+
+                /**
+                 * @brief Gets the value of an Integer column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @return Value of the field of the record.
+                 */
+                int32_t getInteger(uint32_t column, uint32_t row) const
+                {
+                    return int32_t(this->readUInt32(this->getCell(column, row)));
+                }
+
+                /**
+                 * @brief Gets the value of a Real column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @return Value of the field of the record.
+                 */
+                double getReal(uint32_t column, uint32_t row) const
+                {
+                    return this->readReal(this->getCell(column, row));
+                }
+
+                /**
+                 * @brief Gets the value of a String column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @return Value of the field of the record.
+                 */
+                String getString(uint32_t column, uint32_t row) const
+                {
+                    return this->getString(this->readUInt32(this->getCell(column, row)));
+                }
+
+                /**
+                 * @brief Gets the components of the value of a Vector2I or Vector3I column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @param index Index of the component to get (0 for X, 1 for Y, 2 for Z).
+                 * @return Component of the value of the field of the record.
+                 */
+                int32_t getVectorInteger(uint32_t column, uint32_t row, uint32_t index) const
+                {
+                    return int32_t(this->readUInt32(this->getCell(column, row) + size_t(index) * 4));
+                }
+
+                /**
+                 * @brief Gets the components of the value of a Vector2R or Vector3R column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @param index Index of the component to get (0 for X, 1 for Y, 2 for Z).
+                 * @return Component of the value of the field of the record.
+                 */
+                double getVectorReal(uint32_t column, uint32_t row, uint32_t index) const
+                {
+                    return this->readReal(this->getCell(column, row) + size_t(index) * 8);
+                }
+
+                /**
+                 * @brief Gets the number of items of the value of a List or Map column.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @return Number of list or map items of the field of the record.
+                 */
+                uint32_t getItemCount(uint32_t column, uint32_t row) const
+                {
+                    return this->readUInt32(this->getCell(column, row) + 4);
+                }
+
+                /**
+                 * @brief Gets the index of a list or map item of the value of a List or Map column,
+                 * for use with the item getters.
+                 * @param column Index of the column to get the value of.
+                 * @param row Row of the record to get the value of.
+                 * @param index Index of the list or map item, from 0 to the item count.
+                 * @return Global index of the item, or 0xFFFFFFFF if the item doesn't exist.
+                 */
+                uint32_t getItem(uint32_t column, uint32_t row, uint32_t index) const
+                {
+                    const size_t cell = this->getCell(column, row);
+                    const uint32_t firstItem = this->readUInt32(cell);
+                    const uint32_t itemCount = this->readUInt32(cell + 4);
+
+                    if (index >= itemCount || uint64_t(firstItem) + index >= this->itemCount)
+                    {
+                        return 0xFFFFFFFF;
+                    }
+
+                    return firstItem + index;
+                }
+
+                /**
+                 * @brief Gets the key of a map item.
+                 * @param item Global index of the item.
+                 * @return Key of the map item, or an empty string for list items.
+                 */
+                String getItemKey(uint32_t item) const
+                {
+                    return this->getString(this->readUInt32(this->itemsOffset + size_t(item) * ItemSize));
+                }
+
+                /**
+                 * @brief Gets the value of a Boolean list or map item.
+                 * @param item Global index of the item.
+                 * @return Value of the item.
+                 */
+                bool getItemBoolean(uint32_t item) const
+                {
+                    return this->readUInt8(this->itemsOffset + size_t(item) * ItemSize + 8) != 0;
+                }
+
+                /**
+                 * @brief Gets the value of an Integer or Color list or map item.
+                 * @param item Global index of the item.
+                 * @return Value of the item.
+                 */
+                int32_t getItemInteger(uint32_t item) const
+                {
+                    return int32_t(this->readUInt32(this->itemsOffset + size_t(item) * ItemSize + 8));
+                }
+
+                /**
+                 * @brief Gets the value of a Real list or map item.
+                 * @param item Global index of the item.
+                 * @return Value of the item.
+                 */
+                double getItemReal(uint32_t item) const
+                {
+                    return this->readReal(this->itemsOffset + size_t(item) * ItemSize + 8);
+                }
+
+                /**
+                 * @brief Gets the value of a String list or map item.
+                 * @param item Global index of the item.
+                 * @return Value of the item.
+                 */
+                String getItemString(uint32_t item) const
+                {
+                    return this->getString(this->readUInt32(this->itemsOffset + size_t(item) * ItemSize + 8));
+                }
+
+                /**
+                 * @brief Gets the number of bytes each value of the specified type occupies in its column.
+                 * @param valueType Type to get the value size of.
+                 * @return Number of bytes each value of the specified type occupies in its column.
+                 */
+                static uint32_t getCellSize(ValueType valueType)
+                {
+                    switch (valueType)
+                    {
+                        case ValueType::Boolean:
+                            return 1;
+
+                        case ValueType::Integer:
+                        case ValueType::String:
+                        case ValueType::Color:
+                            return 4;
+
+                        case ValueType::Real:
+                        case ValueType::Vector2I:
+                        case ValueType::List:
+                        case ValueType::Map:
+                            return 8;
+
+                        case ValueType::Vector3I:
+                            return 12;
+
+                        case ValueType::Vector2R:
+                            return 16;
+
+                        case ValueType::Vector3R:
+                            return 24;
+
+                        default:
+                            return 0;
+                    }
+                }
+
+            private:
+                static const uint32_t Magic = 0x424D4F54;
+                static const uint32_t HeaderSize = 64;
+                static const uint32_t ColumnSize = 24;
+                static const uint32_t RecordSize = 16;
+                static const uint32_t ItemSize = 16;
+
+                const uint8_t* data = nullptr;
+                size_t size = 0;
+
+                uint32_t recordCount = 0;
+                uint32_t columnCount = 0;
+                uint32_t stringCount = 0;
+                uint32_t itemCount = 0;
+                uint32_t stringOffsetsOffset = 0;
+                uint32_t stringDataOffset = 0;
+                uint32_t columnsOffset = 0;
+                uint32_t recordsOffset = 0;
+                uint32_t recordIndexOffset = 0;
+                uint32_t itemsOffset = 0;
+
+                bool contains(uint64_t offset, uint64_t length) const
+                {
+                    return offset + length <= this->size;
+                }
+
+                bool fail()
+                {
+                    this->data = nullptr;
+                    this->size = 0;
+                    this->recordCount = 0;
+                    this->columnCount = 0;
+                    return false;
+                }
+
+                size_t getCell(uint32_t column, uint32_t row) const
+                {
+                    const size_t columnData = this->getColumnData(column);
+                    const size_t bitmapSize = ((size_t(this->recordCount) + 7) / 8 + 7) / 8 * 8;
+                    const ValueType valueType = ValueType(this->readUInt8(this->columnsOffset + size_t(column) * ColumnSize + 12));
+
+                    return columnData + bitmapSize + size_t(row) * getCellSize(valueType);
+                }
+
+                size_t getColumnData(uint32_t column) const
+                {
+                    return this->readUInt32(this->columnsOffset + size_t(column) * ColumnSize + 16);
+                }
+
+                bool isString(uint32_t index) const
+                {
+                    return index < this->stringCount;
+                }
+
+                double readReal(size_t offset) const
+                {
+                    const uint64_t bits = uint64_t(this->readUInt32(offset)) | (uint64_t(this->readUInt32(offset + 4)) << 32);
+
+                    double value;
+                    memcpy(&value, &bits, sizeof(value));
+                    return value;
+                }
+
+                uint8_t readUInt8(size_t offset) const
+                {
+                    // Never read past the end, even if passed invalid rows or columns.
+                    if (offset >= this->size)
+                    {
+                        return 0;
+                    }
+
+                    return this->data[offset];
+                }
+
+                uint32_t readUInt32(size_t offset) const
+                {
+                    // Never read past the end, even if passed invalid rows or columns.
+                    if (offset > this->size || this->size - offset < 4)
+                    {
+                        return 0;
+                    }
+
+                    const uint8_t* p = this->data + offset;
+                    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+                }
+        };
+    }
+}
+
+#endif // TOMEBINARYREADER_H